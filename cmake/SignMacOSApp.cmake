@@ -14,6 +14,7 @@ foreach(LIBTOSIGN ${LIBSTOSIGN})
   execute_process(COMMAND codesign --force --sign - "${LIBTOSIGN}")
 endforeach()
 execute_process(COMMAND codesign --force --sign - "${APP_DIR}/GrandOrgue.app/Contents/MacOS/GrandOrguePerfTest")
+execute_process(COMMAND codesign --force --sign - "${APP_DIR}/GrandOrgue.app/Contents/MacOS/GrandOrgueRender")
 execute_process(COMMAND codesign --force --sign - "${APP_DIR}/GrandOrgue.app/Contents/MacOS/GrandOrgueTool")
 execute_process(COMMAND codesign --force --sign - "${APP_DIR}/GrandOrgue.app")
 message("Checking code signature...")
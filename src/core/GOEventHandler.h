@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,6 +8,9 @@
 #ifndef GOEVENTHANDLER_H
 #define GOEVENTHANDLER_H
 
+#include <cstdint>
+#include <vector>
+
 class GOMidiEvent;
 
 class GOEventHandler {
@@ -16,6 +19,16 @@ public:
 
   virtual void ProcessMidi(const GOMidiEvent &event) = 0;
   virtual void HandleKey(int key) = 0;
+
+  /**
+   * Appends the routes of the midi events the handler may react on. The
+   * events with other routes are not passed to ProcessMidi
+   * @param routes the vector to append the routes to
+   * @return false if the handler may react on any event
+   */
+  virtual bool GetMidiRoutes(std::vector<uint32_t> &routes) const {
+    return false;
+  }
 };
 
 #endif
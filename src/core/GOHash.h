@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -9,6 +9,7 @@
 #define GOHASH_H
 
 #include <cstdint>
+#include <cstring>
 #include <wx/string.h>
 
 #include "contrib/sha1.h"
@@ -17,6 +18,14 @@ typedef struct _GOHashType {
   uint8_t hash[20];
 } GOHashType;
 
+inline bool operator==(const GOHashType &h1, const GOHashType &h2) {
+  return memcmp(h1.hash, h2.hash, sizeof(h1.hash)) == 0;
+}
+
+inline bool operator<(const GOHashType &h1, const GOHashType &h2) {
+  return memcmp(h1.hash, h2.hash, sizeof(h1.hash)) < 0;
+}
+
 class GOHash {
 private:
   SHA_CTX m_ctx;
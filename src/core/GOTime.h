@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,8 +8,22 @@
 #ifndef GOTIME_H
 #define GOTIME_H
 
+#include <chrono>
+#include <cstdint>
+
 #include <wx/longlong.h>
 
 typedef wxLongLong GOTime;
 
+/**
+ * Returns the current time of the monotonic clock in nanoseconds. Unlike
+ * GOTime it is not affected by the wall clock adjustments, so it may be used
+ * for positioning events in the audio stream
+ */
+inline int64_t go_steady_time_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
 #endif
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -11,7 +11,70 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+
+#include "threading/GOThread.h"
+
 #include "GOAlloc.h"
+#include "GOInt.h"
+#include "ptrvector.h"
+
+/* Files shorter than this number of samples per thread are not worth to be
+ * decoded concurrently */
+static constexpr unsigned PARALLEL_MIN_SAMPLES = 1 << 18;
+
+/* Returns the number of samples in the first WavPack block or 0 */
+static unsigned first_block_samples(const GOBuffer<uint8_t> &data) {
+  // the offset of block_samples in the WavPack block header
+  const unsigned offset = 20;
+
+  return data.GetSize() >= offset + sizeof(GOUInt32LE)
+    ? (unsigned)*(const GOUInt32LE *)(data.get() + offset)
+    : 0;
+}
+
+/* Takes up to n threads from the lent ones. Returns the number of threads
+ * taken */
+static unsigned take_threads(std::atomic_int &freeThreads, unsigned n) {
+  int nFree = freeThreads.load();
+  int nTaken;
+
+  do {
+    nTaken = std::clamp(nFree, 0, (int)n);
+  } while (nTaken > 0
+           && !freeThreads.compare_exchange_weak(nFree, nFree - nTaken));
+  return nTaken;
+}
+
+/* Decodes a range of samples in a separate thread with its own WavPack
+ * context */
+class GOWavPackRangeWorker : public GOThread {
+private:
+  GOWavPack m_pack;
+  int32_t *p_dest;
+  unsigned m_from;
+  unsigned m_count;
+  bool m_IsOk;
+
+  void Entry() override {
+    m_IsOk = m_pack.UnpackRange(p_dest, m_from, m_count);
+  }
+
+public:
+  GOWavPackRangeWorker(
+    const GOBuffer<uint8_t> &file,
+    int32_t *pDest,
+    unsigned from,
+    unsigned count)
+    : m_pack(file),
+      p_dest(pDest),
+      m_from(from),
+      m_count(count),
+      m_IsOk(false) {}
+  ~GOWavPackRangeWorker() { Stop(); }
+
+  bool IsOk() const { return m_IsOk; }
+};
 
 GOWavPack::GOWavPack(const GOBuffer<uint8_t> &file)
   : m_data(file),
@@ -51,9 +114,48 @@ bool GOWavPack::Unpack() {
   unsigned channels = WavpackGetNumChannels(m_context);
   unsigned samples = WavpackGetNumSamples(m_context);
   m_Samples.resize(channels * samples * 4);
-  unsigned res
-    = WavpackUnpackSamples(m_context, (int32_t *)m_Samples.get(), samples);
-  if (res != samples)
+
+  int32_t *pSamples = (int32_t *)m_Samples.get();
+  unsigned nExtraThreads = samples >= 2 * PARALLEL_MIN_SAMPLES
+    ? take_threads(m_FreeThreads, samples / PARALLEL_MIN_SAMPLES - 1)
+    : 0;
+  unsigned nRanges = 1 + nExtraThreads;
+  unsigned rangeLength = (samples + nRanges - 1) / nRanges;
+
+  if (nRanges > 1) {
+    /* Round the ranges up to the whole blocks so each block is decoded once.
+     * Seeking to any other position is also correct but slower */
+    unsigned blockSamples = first_block_samples(m_data);
+
+    if (blockSamples)
+      rangeLength
+        = (rangeLength + blockSamples - 1) / blockSamples * blockSamples;
+  }
+
+  // The first range is decoded in this thread with the already opened context
+  unsigned firstLength = std::min(rangeLength, samples);
+  bool isOk;
+
+  {
+    ptr_vector<GOWavPackRangeWorker> workers;
+
+    for (unsigned from = firstLength; from < samples; from += rangeLength)
+      workers.push_back(new GOWavPackRangeWorker(
+        m_data,
+        pSamples + from * channels,
+        from,
+        std::min(rangeLength, samples - from)));
+    for (GOWavPackRangeWorker *pWorker : workers)
+      pWorker->Start();
+    isOk
+      = WavpackUnpackSamples(m_context, pSamples, firstLength) == firstLength;
+    for (GOWavPackRangeWorker *pWorker : workers) {
+      pWorker->Wait();
+      isOk = isOk && pWorker->IsOk();
+    }
+  }
+  LendThreads(nExtraThreads);
+  if (!isOk)
     return false;
 
   m_OrigDataLen = channels * samples * WavpackGetBytesPerSample(m_context);
@@ -71,6 +173,12 @@ bool GOWavPack::Unpack() {
   return true;
 }
 
+bool GOWavPack::UnpackRange(int32_t *pDest, unsigned from, unsigned count) {
+  m_context = WavpackOpenFileInputEx(&m_Reader, this, NULL, NULL, 0, 0);
+  return m_context && WavpackSeekSample(m_context, from)
+    && WavpackUnpackSamples(m_context, pDest, count) == count;
+}
+
 uint32_t GOWavPack::GetLength(void *id) {
   return ((GOWavPack *)id)->GetLength();
 }
@@ -138,6 +246,8 @@ int GOWavPack::SetPosRel(int32_t delta, int mode) {
   }
 }
 
+std::atomic_int GOWavPack::m_FreeThreads = 0;
+
 WavpackStreamReader GOWavPack::m_Reader = {
   .read_bytes = ReadBytes,
   .get_pos = GetPos,
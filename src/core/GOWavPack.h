@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,6 +8,8 @@
 #ifndef GOWAVPACK_H
 #define GOWAVPACK_H
 
+#include <atomic>
+
 #include <wavpack/wavpack.h>
 
 #include "GOBuffer.h"
@@ -22,6 +24,9 @@ private:
   WavpackContext *m_context;
 
   static WavpackStreamReader m_Reader;
+  /* The number of threads lent for decoding the large files concurrently and
+   * not used yet */
+  static std::atomic_int m_FreeThreads;
 
   static uint32_t GetLength(void *id);
   static int32_t ReadBytes(void *id, void *data, int32_t bcount);
@@ -44,8 +49,32 @@ public:
   ~GOWavPack();
 
   static bool IsWavPack(const GOBuffer<uint8_t> &data);
+
+  /**
+   * Lends threads for decoding large files concurrently or takes them back.
+   * The loader lends the slots of its threads that have nothing to load any
+   * more, so the total number of the decoding threads does not exceed the
+   * load concurrency
+   * @param n the number of threads to lend. Negative to take them back
+   */
+  static void LendThreads(int n) { m_FreeThreads += n; }
+
+  /**
+   * Decodes the whole file. If some threads have been lent, large files are
+   * split into several ranges of WavPack blocks that are decoded concurrently
+   */
   bool Unpack();
 
+  /**
+   * Decodes a range of samples into the dest buffer. The object must not have
+   * been opened before
+   * @param pDest the buffer for the range
+   * @param from the first sample (frame) of the range
+   * @param count the number of samples (frames) in the range
+   * @return whether the range has been decoded successfully
+   */
+  bool UnpackRange(int32_t *pDest, unsigned from, unsigned count);
+
   GOBuffer<uint8_t> GetSamples();
   GOBuffer<uint8_t> GetWrapper();
   unsigned GetOrigDataLen();
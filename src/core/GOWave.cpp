@@ -7,6 +7,9 @@
 
 #include "GOWave.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include <wx/file.h>
 #include <wx/intl.h>
 #include <wx/log.h>
@@ -19,6 +22,7 @@
 
 void GOWave::SetInvalid() {
   m_SampleData.free();
+  m_Length = 0;
   m_Channels = 0;
   m_BytesPerSample = 0;
   m_SampleRate = 0;
@@ -114,22 +118,6 @@ void GOWave::LoadSamplerChunk(const uint8_t *ptr, unsigned long length) {
   m_PitchFract = sampler->dwMIDIPitchFraction / (double)UINT_MAX * 100.0;
 }
 
-void GOWave::Open(GOOpenedFile *file) {
-  const wxString fileName = file->GetName();
-
-  if (!file->Open())
-    throw wxString::Format(_("Failed to open file '%s'"), fileName);
-
-  // Allocate memory for wave and read it.
-  GOBuffer<uint8_t> content(file->GetSize());
-
-  if (!file->Read(content))
-    throw wxString::Format(_("Failed to read file '%s'"), fileName);
-
-  file->Close();
-  Open(content, fileName);
-}
-
 static void check_for_bounds(
   const wxString &fileName,
   GO_WAVECHUNKHEADER *pHeader,
@@ -154,6 +142,233 @@ static void check_for_bounds(
   }
 }
 
+static void read_exactly(
+  GOOpenedFile *file, const wxString &fileName, void *buffer, size_t len) {
+  if (file->Read(buffer, len) != len)
+    throw wxString::Format(_("Failed to read file '%s'"), fileName);
+}
+
+static void skip_bytes(
+  GOOpenedFile *file, const wxString &fileName, unsigned long len) {
+  uint8_t buffer[4096];
+
+  while (len) {
+    size_t chunk = std::min<unsigned long>(len, sizeof(buffer));
+
+    read_exactly(file, fileName, buffer, chunk);
+    len -= chunk;
+  }
+}
+
+/* Reads the chunks from a file sequentially. The small chunks being parsed
+ * are read into a temporary buffer */
+class GOWaveFileReader {
+private:
+  GOOpenedFile *p_file;
+  const wxString &r_FileName;
+  GOBuffer<uint8_t> m_chunk;
+
+public:
+  GOWaveFileReader(GOOpenedFile *file, const wxString &fileName)
+    : p_file(file), r_FileName(fileName) {}
+
+  void Read(void *dest, unsigned long len) {
+    read_exactly(p_file, r_FileName, dest, len);
+  }
+
+  const uint8_t *GetChunk(unsigned long len) {
+    m_chunk.free();
+    m_chunk.resize(len);
+    Read(m_chunk.get(), len);
+    return m_chunk.get();
+  }
+
+  void Skip(unsigned long len) { skip_bytes(p_file, r_FileName, len); }
+};
+
+/* Reads the chunks from the file content in memory. The chunks being parsed
+ * are not copied */
+class GOWaveMemoryReader {
+private:
+  const uint8_t *p_data;
+
+public:
+  GOWaveMemoryReader(const uint8_t *pData) : p_data(pData) {}
+
+  void Read(void *dest, unsigned long len) {
+    memcpy(dest, p_data, len);
+    p_data += len;
+  }
+
+  const uint8_t *GetChunk(unsigned long len) {
+    const uint8_t *pChunk = p_data;
+
+    p_data += len;
+    return pChunk;
+  }
+
+  void Skip(unsigned long len) { p_data += len; }
+};
+
+template <class Reader>
+void GOWave::LoadChunks(
+  Reader &reader,
+  const wxString &fileName,
+  unsigned long offset,
+  unsigned long length) {
+  bool hasFormat = false;
+
+  /* Read the chunks one by one. Only the sample data and the small chunks
+   * that are parsed are held in memory */
+  while (offset + 8 <= length) {
+    /* Check for word alignment as per RIFF spec */
+    assert((offset & 1) == 0);
+
+    GO_WAVECHUNKHEADER header;
+    unsigned long chunkOffset = offset;
+
+    reader.Read(&header, sizeof(header));
+    offset += sizeof(header);
+
+    unsigned long size = header.dwSize;
+
+    if (header.fccChunk == WAVE_TYPE_DATA) {
+      if (!hasFormat)
+        throw wxString::Format(
+          _("Malformed wave file '%s'. Format chunk must precede data "
+            "chunk."),
+          fileName);
+      if (m_isPacked)
+        // the samples have been decoded from the WavPack blocks. The wrapper
+        // contains the data chunk header only
+        size = 0;
+      else {
+        check_for_bounds(fileName, &header, offset, length, chunkOffset);
+        m_SampleData.free();
+        m_SampleData.resize(size);
+        reader.Read(m_SampleData.get(), size);
+      }
+    } else if (
+      header.fccChunk == WAVE_TYPE_FMT || header.fccChunk == WAVE_TYPE_CUE
+      || header.fccChunk == WAVE_TYPE_SAMPLE) {
+      check_for_bounds(fileName, &header, offset, length, chunkOffset);
+
+      const uint8_t *pChunk = reader.GetChunk(size);
+
+      if (header.fccChunk == WAVE_TYPE_FMT) {
+        hasFormat = true;
+        LoadFormatChunk(pChunk, size);
+      } else if (header.fccChunk == WAVE_TYPE_CUE)
+        LoadCueChunk(pChunk, size);
+      else
+        LoadSamplerChunk(pChunk, size);
+    } else if (offset + size <= length)
+      reader.Skip(size);
+    else
+      // the chunk exceeds the file. It is reported below
+      break;
+    offset += size;
+    /* Respect word alignment unless lack of final padding (non
+     * spec-compliant) */
+    if (offset < length && (size & 1)) {
+      reader.Skip(1);
+      offset++;
+    }
+  }
+
+  if (offset != length)
+    throw wxString::Format(_("Invalid WAV file: %s"), fileName);
+}
+
+void GOWave::Open(GOOpenedFile *file) {
+  const wxString fileName = file->GetName();
+
+  /* Close any currently open wave data */
+  Close();
+
+  if (!file->Open())
+    throw wxString::Format(_("Failed to open file '%s'"), fileName);
+
+  const size_t fileSize = file->GetSize();
+  GO_WAVECHUNKHEADER riffHeader;
+  GO_WAVETYPEFIELD riffIdent;
+
+  if (fileSize < sizeof(riffHeader) + sizeof(riffIdent))
+    throw wxString::Format(_("Not a RIFF file: %s"), fileName);
+  read_exactly(file, fileName, &riffHeader, sizeof(riffHeader));
+  read_exactly(file, fileName, &riffIdent, sizeof(riffIdent));
+
+  if (!memcmp(&riffHeader, "wvpk", 4)) {
+    // WavPack data are decoded from the whole file content
+    GOBuffer<uint8_t> content(fileSize);
+
+    memcpy(content.get(), &riffHeader, sizeof(riffHeader));
+    memcpy(content.get() + sizeof(riffHeader), &riffIdent, sizeof(riffIdent));
+    read_exactly(
+      file,
+      fileName,
+      content.get() + sizeof(riffHeader) + sizeof(riffIdent),
+      fileSize - sizeof(riffHeader) - sizeof(riffIdent));
+    file->Close();
+    Open(content, fileName);
+    return;
+  }
+
+  try {
+    /* Pribac compatibility */
+    if (riffHeader.fccChunk != WAVE_TYPE_RIFF)
+      throw wxString::Format(_("Invalid RIFF file: %s"), fileName);
+    /* Make sure this is a RIFF/WAVE file */
+    if (riffIdent != WAVE_TYPE_WAVE)
+      throw wxString::Format(_("Invalid RIFF/WAVE file: %s"), fileName);
+
+    unsigned long offset = sizeof(riffHeader) + sizeof(riffIdent);
+    unsigned long length = fileSize;
+
+    /* Truncate the usable size of the file if the size on disk is larger
+     * than the size of the RIFF chunk */
+    if (length > (unsigned long)riffHeader.dwSize + 8)
+      length = (unsigned long)riffHeader.dwSize + 8;
+
+    GOWaveFileReader reader(file, fileName);
+
+    LoadChunks(reader, fileName, offset, length);
+    FinishLoading(fileName);
+  } catch (...) {
+    file->Close();
+    /* Free any memory that was allocated by chunk loading procedures */
+    Close();
+    throw;
+  }
+  file->Close();
+}
+
+void GOWave::FinishLoading(const wxString &fileName) {
+  if (!m_SampleData.get() || !m_SampleData.GetSize())
+    throw wxString::Format(_("No samples found: %s"), fileName);
+
+  if (m_isPacked)
+    m_Length = m_SampleData.GetSize() / (4 * m_Channels);
+  else {
+    /* return number of samples in the stream */
+    assert((m_SampleData.GetSize() % (m_BytesPerSample * m_Channels)) == 0);
+    m_Length = m_SampleData.GetSize() / (m_BytesPerSample * m_Channels);
+  }
+
+  // learning lesson: never ever trust the range values of outside sources to
+  // be correct!
+  for (unsigned int i = 0; i < m_Loops.size(); i++) {
+    if (
+      (m_Loops[i].m_StartPosition >= m_Loops[i].m_EndPosition)
+      || (m_Loops[i].m_StartPosition >= GetLength())
+      || (m_Loops[i].m_EndPosition >= GetLength())
+      || (m_Loops[i].m_EndPosition == 0)) {
+      wxLogError(_("Invalid loop in the file: %s\n"), fileName);
+      m_Loops.erase(m_Loops.begin() + i);
+    }
+  }
+}
+
 void GOWave::Open(const GOBuffer<uint8_t> &content, const wxString fileName) {
   /* Close any currently open wave data */
   Close();
@@ -212,74 +427,10 @@ void GOWave::Open(const GOBuffer<uint8_t> &content, const wxString fileName) {
     if ((unsigned long)length > riffChunkSize + 8 + start)
       length = riffChunkSize + 8 + start;
 
-    bool hasFormat = false;
-    /* Find required chunks... */
-    for (; offset + 8 <= length;) {
-      /* Check for word alignment as per RIFF spec */
-      assert((offset & 1) == 0);
-
-      /* Read chunk header */
-      GO_WAVECHUNKHEADER *header = (GO_WAVECHUNKHEADER *)(ptr + offset);
-      unsigned long size = header->dwSize;
-      unsigned long chunkOffset = offset;
-
-      // skip the header
-      offset += sizeof(GO_WAVECHUNKHEADER);
-
-      if (header->fccChunk == WAVE_TYPE_DATA) {
-        if (!hasFormat)
-          throw wxString::Format(
-            _("Malformed wave file '%s'. Format chunk must precede data "
-              "chunk."),
-            fileName);
-
-        if (m_isPacked)
-          size = 0;
-        else {
-          m_SampleData.free();
-          check_for_bounds(fileName, header, offset, length, chunkOffset);
-          m_SampleData.Append(ptr + offset, size);
-        }
-      }
-      if (header->fccChunk == WAVE_TYPE_FMT) {
-        hasFormat = true;
-        check_for_bounds(fileName, header, offset, length, chunkOffset);
-        LoadFormatChunk(ptr + offset, size);
-      }
-      if (header->fccChunk == WAVE_TYPE_CUE) { /* This used to only work if
-                                                !load m_pipe_percussive[i] */
-        check_for_bounds(fileName, header, offset, length, chunkOffset);
-        LoadCueChunk(ptr + offset, size);
-      }
-      if (header->fccChunk == WAVE_TYPE_SAMPLE) { /* This used to only work if
-                                                   !load m_pipe_percussive[i] */
-        check_for_bounds(fileName, header, offset, length, chunkOffset);
-        LoadSamplerChunk(ptr + offset, size);
-      }
-      /* Move to next chunk respecting word alignment
-         Unless lack of final padding (non spec-compliant) */
-      offset += size;
-      if (offset < length)
-        offset += size & 1;
-    }
+    GOWaveMemoryReader reader(ptr + offset);
 
-    if (offset != length)
-      throw wxString::Format(_("Invalid WAV file: %s"), fileName);
-    if (!m_SampleData.get() || !m_SampleData.GetSize())
-      throw wxString::Format(_("No samples found: %s"), fileName);
-
-    // learning lesson: never ever trust the range values of outside sources to
-    // be correct!
-    for (unsigned int i = 0; i < m_Loops.size(); i++) {
-      if (
-        (m_Loops[i].m_StartPosition >= m_Loops[i].m_EndPosition)
-        || (m_Loops[i].m_StartPosition >= GetLength())
-        || (m_Loops[i].m_EndPosition >= GetLength())
-        || (m_Loops[i].m_EndPosition == 0)) {
-        wxLogError(_("Invalid loop in the file: %s\n"), fileName);
-        m_Loops.erase(m_Loops.begin() + i);
-      }
-    }
+    LoadChunks(reader, fileName, offset, length);
+    FinishLoading(fileName);
   } catch (...) {
     /* Free any memory that was allocated by chunk loading procedures */
     Close();
@@ -327,13 +478,7 @@ const GOWaveLoop &GOWave::GetLongestLoop() const {
   return m_Loops[lidx];
 }
 
-unsigned GOWave::GetLength() const {
-  if (m_isPacked)
-    return m_SampleData.GetSize() / (4 * m_Channels);
-  /* return number of samples in the stream */
-  assert((m_SampleData.GetSize() % (m_BytesPerSample * m_Channels)) == 0);
-  return m_SampleData.GetSize() / (m_BytesPerSample * m_Channels);
-}
+unsigned GOWave::GetLength() const { return m_Length; }
 
 template <class T> void GOWave::writeNext(uint8_t *&output, const T &value) {
   *(T *)output = value;
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -21,6 +21,8 @@ class GOOpenedFile;
 class GOWave {
 private:
   GOBuffer<uint8_t> m_SampleData;
+  // the number of blocks. It remains valid after ReleaseSampleData()
+  unsigned m_Length;
   unsigned m_BytesPerSample;
   unsigned m_SampleRate;
   unsigned m_CuePoint;
@@ -35,6 +37,22 @@ private:
   void LoadFormatChunk(const uint8_t *ptr, unsigned long length);
   void LoadCueChunk(const uint8_t *ptr, unsigned long length);
   void LoadSamplerChunk(const uint8_t *ptr, unsigned long length);
+  /**
+   * Loads the chunks of a RIFF/WAVE file following the RIFF header
+   * @param reader the source of the chunks. It provides Read(dest, len),
+   *   GetChunk(len) returning a pointer to the next len bytes and Skip(len)
+   * @param fileName the file name for error messages
+   * @param offset the offset of the first chunk
+   * @param length the usable length of the file
+   */
+  template <class Reader>
+  void LoadChunks(
+    Reader &reader,
+    const wxString &fileName,
+    unsigned long offset,
+    unsigned long length);
+  // Validates the loaded samples and loops
+  void FinishLoading(const wxString &fileName);
   template <class T> static void writeNext(uint8_t *&output, const T &value);
   template <class T> static T readNext(const uint8_t *&input);
 
@@ -63,11 +81,22 @@ public:
   GOWave();
   ~GOWave();
 
+  /**
+   * Loads the wave from an opened file. A plain wave file is parsed chunk by
+   * chunk while reading, so only the sample data is held in memory. A WavPack
+   * file is read entirely and then decoded
+   */
   void Open(GOOpenedFile *file);
   void Open(const GOBuffer<uint8_t> &content, const wxString fileName);
   bool Save(GOBuffer<uint8_t> &buf);
   void Close();
 
+  /**
+   * Frees the sample data when they are not needed more, for example after
+   * ReadSamples(). All other information about the wave remains available
+   */
+  void ReleaseSampleData() { m_SampleData.free(); }
+
   /* GetChannels()
    * Returns the number of channels in the wave stream.
    */
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -92,6 +92,17 @@ void GOConfigReaderDB::ClearCMB() {
   m_CMBUsed.clear();
 }
 
+void GOConfigReaderDB::MarkUsed(
+  GOUsedFlagMap &usedMap, const wxString &index) {
+  // Only the entries registered in ReadData are reported as unused, so a
+  // missing entry need not be inserted. It keeps the map structure unchanged
+  // and allows concurrent reading
+  GOUsedFlagMap::iterator i = usedMap.find(index);
+
+  if (i != usedMap.end())
+    i->second.store(true);
+}
+
 void GOConfigReaderDB::AddEntry(
   GOStringHashMap &hash, wxString key, wxString value) {
   GOStringHashMap::iterator i = hash.find(key);
@@ -108,7 +119,7 @@ bool GOConfigReaderDB::GetString(
   wxString &value) {
   wxString index = group + wxT("/") + key;
   if (type == CMBSetting) {
-    m_CMBUsed[index] = true;
+    MarkUsed(m_CMBUsed, index);
     GOStringHashMap::iterator i = m_CMB.find(index);
     if (i != m_CMB.end()) {
       value = i->second;
@@ -116,7 +127,7 @@ bool GOConfigReaderDB::GetString(
     }
   }
   if (type == ODFSetting) {
-    m_ODFUsed[index] = true;
+    MarkUsed(m_ODFUsed, index);
     GOStringHashMap::iterator i = m_ODF.find(index);
     if (i != m_ODF.end()) {
       value = i->second;
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,6 +8,9 @@
 #ifndef GOCONFIGREADERDB_H
 #define GOCONFIGREADERDB_H
 
+#include <atomic>
+#include <unordered_map>
+
 #include <wx/hashmap.h>
 #include <wx/string.h>
 
@@ -15,19 +18,27 @@
 
 class GOConfigFileReader;
 
+/**
+ * The database of ODF and CMB entries.
+ * After all ReadData() calls GetString() may be called concurrently from
+ * several threads: the entry maps are not modified any more and the "used"
+ * flags are atomic and are never inserted by GetString()
+ */
 class GOConfigReaderDB {
 private:
   WX_DECLARE_STRING_HASH_MAP(wxString, GOStringHashMap);
-  WX_DECLARE_STRING_HASH_MAP(bool, GOBoolHashMap);
+  using GOUsedFlagMap = std::
+    unordered_map<wxString, std::atomic_bool, wxStringHash, wxStringEqual>;
 
   bool m_CaseSensitive;
   GOStringHashMap m_ODF;
   GOStringHashMap m_ODF_LC;
   GOStringHashMap m_CMB;
-  GOBoolHashMap m_ODFUsed;
-  GOBoolHashMap m_CMBUsed;
+  GOUsedFlagMap m_ODFUsed;
+  GOUsedFlagMap m_CMBUsed;
 
   void AddEntry(GOStringHashMap &hash, wxString key, wxString value);
+  static void MarkUsed(GOUsedFlagMap &usedMap, const wxString &index);
 
 public:
   GOConfigReaderDB(bool case_sensitive = true);
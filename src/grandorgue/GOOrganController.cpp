@@ -8,7 +8,10 @@
 #include "GOOrganController.h"
 
 #include <algorithm>
+#include <deque>
+#include <map>
 #include <math.h>
+#include <unordered_set>
 
 #include <wx/filename.h>
 #include <wx/log.h>
@@ -48,6 +51,7 @@
 #include "loader/GOLoadThread.h"
 #include "loader/GOLoaderFilename.h"
 #include "loader/cache/GOCache.h"
+#include "loader/cache/GOCacheIndex.h"
 #include "loader/cache/GOCacheWriter.h"
 #include "midi/GOMidiPlayer.h"
 #include "midi/GOMidiRecorder.h"
@@ -63,6 +67,7 @@
 #include "model/GOTremulant.h"
 #include "sound/GOSoundOrganEngine.h"
 #include "sound/playing/GOSoundReleaseAlignTable.h"
+#include "sound/playing/GOSoundSamplerBatch.h"
 #include "temperaments/GOTemperament.h"
 #include "yaml/GOYamlModel.h"
 
@@ -182,10 +187,9 @@ void GOOrganController::ResetOrganModified() {
   SetOrganModified(false);
 }
 
-GOHashType GOOrganController::GenerateCacheHash() {
+GOHashType GOOrganController::GenerateCacheFormatHash() {
   GOHash hash;
 
-  UpdateHash(hash);
   hash.Update(sizeof(GOSoundAudioSection));
   hash.Update(sizeof(GOSoundingPipe));
   hash.Update(sizeof(GOSoundReleaseAlignTable));
@@ -260,6 +264,8 @@ void GOOrganController::ReadOrganFile(GOConfigReader &cfg) {
 
   m_DivisionalSetter = new GODivisionalSetter(this, m_setter->GetState());
   m_elementcreators.push_back(m_DivisionalSetter);
+  m_CombinationStore.AddStorable(m_setter);
+  m_CombinationStore.AddStorable(m_DivisionalSetter);
   m_AudioRecorder = new GOAudioRecorder(this);
   m_MidiRecorder = new GOMidiRecorder(this);
   m_MidiPlayer = new GOMidiPlayer(this);
@@ -487,23 +493,24 @@ wxString GOOrganController::Load(
 
     if (!isGuiOnly) {
       try {
-        bool cache_ok = false;
-
         dummy.resize(1024 * 1024 * 50);
         ResolveReferences();
 
-        /* Figure out list of pipes to load */
-        GOCacheObjectDistributor objectDistributor(GetCacheObjects());
-
-        dlg->Reset(objectDistributor.GetNObjects());
+        const std::vector<GOCacheObject *> &allObjects = GetCacheObjects();
+        // the objects that have not been loaded from the cache yet
+        std::vector<GOCacheObject *> objectsToLoad(allObjects);
 
-        GOCacheObject *obj = nullptr;
+        dlg->Reset(allObjects.size());
 
         /* Load pipes */
         if (wxFileExists(m_CacheFilename)) {
           wxFile cache_file(m_CacheFilename);
+          GOCacheIndex index;
+          // the index is read from the end of the file before the data
+          const bool isIndexOk
+            = cache_file.IsOpened() && index.Read(cache_file);
           GOCache reader(cache_file, m_pool);
-          cache_ok = cache_file.IsOpened();
+          bool cache_ok = cache_file.IsOpened();
 
           if (cache_ok) {
             GOHashType hash1, hash2;
@@ -511,36 +518,24 @@ wxString GOOrganController::Load(
               cache_ok = false;
               wxLogWarning(_("Cache file had bad magic bypassing cache."));
             }
-            hash1 = GenerateCacheHash();
+            hash1 = GenerateCacheFormatHash();
             if (
-              !reader.Read(&hash2, sizeof(hash2))
-              || memcmp(&hash1, &hash2, sizeof(hash1))) {
+              cache_ok
+              && (!reader.Read(&hash2, sizeof(hash2)) || !(hash1 == hash2))) {
               cache_ok = false;
               reader.FreeCacheFile();
               wxLogWarning(_("Cache file had diffent hash bypassing cache."));
             }
           }
-
-          GOCacheObject *obj = nullptr;
-
-          if (cache_ok) {
-            while ((obj = objectDistributor.FetchNext())) {
-              if (!obj->LoadFromCacheWithoutExc(m_pool, reader)) {
-                wxLogWarning(_("Cache load failure: %s"), obj->GetLoadError());
-                break;
-              }
-              if (!dlg->Update(objectDistributor.GetPos(), obj->GetLoadTitle()))
-                throw GOLoadAborted(); // Skip the rest of the loading code
-            }
-            if (!obj)
-              m_Cacheable = true;
-            else
-              // obj points to an object with a load error. We will try to load
-              // it from the file later
-              cache_ok = false;
+          if (cache_ok && !isIndexOk) {
+            cache_ok = false;
+            reader.FreeCacheFile();
+            wxLogWarning(_("Cache file had a bad index bypassing cache."));
           }
+          if (cache_ok)
+            LoadCacheEntries(dlg, reader, index, objectsToLoad);
 
-          if (!cache_ok && !m_config.ManageCache())
+          if (!objectsToLoad.empty() && !m_config.ManageCache())
             wxLogWarning(
               _("The cache for this organ is outdated. Please update "
                 "or delete it."));
@@ -548,9 +543,15 @@ wxString GOOrganController::Load(
           reader.Close();
         }
 
-        if (!cache_ok) {
+        if (objectsToLoad.empty())
+          m_Cacheable = true;
+        else {
+          const unsigned nLoadedFromCache
+            = allObjects.size() - objectsToLoad.size();
+          GOCacheObjectDistributor objectDistributor(objectsToLoad);
           GOLoadWorker thisWorker(m_FileStore, m_pool, objectDistributor);
           ptr_vector<GOLoadThread> threads;
+          GOCacheObject *obj = nullptr;
 
           // Create and run additional worker threads
           for (unsigned i = 0; i < m_config.LoadConcurrency(); i++)
@@ -559,13 +560,11 @@ wxString GOOrganController::Load(
           for (unsigned i = 0; i < threads.size(); i++)
             threads[i]->Run();
 
-          // try to load the object that we could not load from cache
-          if (obj)
-            thisWorker.LoadObjectNoExc(obj);
-
           while (thisWorker.LoadNextObject(obj))
             // show the progress and process possible Cancel
-            if (!dlg->Update(objectDistributor.GetPos(), obj->GetLoadTitle()))
+            if (!dlg->Update(
+                  nLoadedFromCache + objectDistributor.GetPos(),
+                  obj->GetLoadTitle()))
               throw GOLoadAborted(); // skip the rest of loading code
           // rethrow exception if any occured in thisWorker.LoadNextObject
           bool wereExceptions = thisWorker.WereExceptions();
@@ -573,7 +572,7 @@ wxString GOOrganController::Load(
           for (unsigned i = 0; i < threads.size(); i++)
             wereExceptions |= threads[i]->CheckExceptions();
           if (wereExceptions) {
-            for (auto obj : GetCacheObjects()) {
+            for (auto obj : objectsToLoad) {
               if (!obj->IsReady())
                 wxLogError(obj->GetLoadError());
             }
@@ -633,6 +632,8 @@ wxString GOOrganController::ExportCombination(const wxString &fileName) {
 
   const wxString errMsg = yamlOut.writeTo(fileName);
 
+  if (errMsg.IsEmpty())
+    m_CombinationStore.Store(fileName);
   m_setter->OnCombinationsSaved(fileName);
   return errMsg;
 }
@@ -644,7 +645,10 @@ void GOOrganController::LoadCombination(const wxString &file) {
   try {
     const wxString fileExt = fileName.GetExt();
 
-    if (fileExt == WX_YAML) {
+    if (fileExt == WX_YAML && m_CombinationStore.Restore(file))
+      // the file has already been loaded and has not been changed since
+      m_setter->OnCombinationsLoaded(fileName.GetPath(), file);
+    else if (fileExt == WX_YAML) {
       GOYamlModel::In inYaml(GetOrganName(), file, WX_GRANDORGUE_COMBINATIONS);
 
       if (is_to_import_to_this_organ(
@@ -654,6 +658,7 @@ void GOOrganController::LoadCombination(const wxString &file) {
             inYaml.GetFileOrganName())) {
         inYaml >> *m_setter;
         inYaml >> *m_DivisionalSetter;
+        m_CombinationStore.Store(file);
         m_setter->OnCombinationsLoaded(fileName.GetPath(), file);
       }
     } else {
@@ -698,15 +703,75 @@ void GOOrganController::LoadCombination(const wxString &file) {
   }
 }
 
+void GOOrganController::LoadCacheEntries(
+  GOProgressDialog *dlg,
+  GOCache &reader,
+  const GOCacheIndex &index,
+  std::vector<GOCacheObject *> &objects) {
+  const std::vector<GOCacheIndex::Entry> &entries = index.GetEntries();
+  // objects waiting for a cache entry with the same hash
+  std::map<GOHashType, std::deque<GOCacheObject *>> objectsByHash;
+  std::vector<GOCacheObject *> entryObjects(entries.size(), nullptr);
+  std::unordered_set<GOCacheObject *> loadedObjects;
+  unsigned nMatched = 0;
+
+  for (GOCacheObject *obj : objects)
+    objectsByHash[obj->GetCacheHash()].push_back(obj);
+  for (unsigned i = 0; i < entries.size(); i++) {
+    auto it = objectsByHash.find(entries[i].m_hash);
+
+    if (it != objectsByHash.end() && !it->second.empty()) {
+      entryObjects[i] = it->second.front();
+      it->second.pop_front();
+      nMatched++;
+    }
+  }
+  if (nMatched < objects.size() && m_config.ManageCache())
+    // The cache will be rewritten, so the loaded objects must not refer to
+    // the mapped cache file
+    reader.FreeCacheFile();
+
+  for (unsigned i = 0; i < entries.size(); i++) {
+    const uint64_t startPos = reader.GetPos();
+    GOCacheObject *obj = entryObjects[i];
+
+    if (obj) {
+      if (obj->LoadFromCacheWithoutExc(m_pool, reader))
+        loadedObjects.insert(obj);
+      else
+        // the object will be loaded from the sample files
+        wxLogWarning(_("Cache load failure: %s"), obj->GetLoadError());
+      if (!dlg->Update(loadedObjects.size(), obj->GetLoadTitle()))
+        throw GOLoadAborted(); // Skip the rest of the loading code
+    }
+
+    const uint64_t nRead = reader.GetPos() - startPos;
+
+    if (nRead > entries[i].m_size || !reader.Skip(entries[i].m_size - nRead)) {
+      wxLogWarning(_("Cache file is corrupted, bypassing the rest of it."));
+      break;
+    }
+  }
+  objects.erase(
+    std::remove_if(
+      objects.begin(),
+      objects.end(),
+      [&loadedObjects](GOCacheObject *obj) {
+        return loadedObjects.count(obj) > 0;
+      }),
+    objects.end());
+}
+
 bool GOOrganController::UpdateCache(GOProgressDialog *dlg, bool compress) {
   bool isOk = false;
 
   DeleteCache();
 
   /* Figure out the list of pipes to save */
-  GOCacheObjectDistributor objectDistributor(GetCacheObjects());
+  const std::vector<GOCacheObject *> &allObjects = GetCacheObjects();
+  GOCacheIndex index;
 
-  dlg->Setup(objectDistributor.GetNObjects(), _("Creating sample cache"));
+  dlg->Setup(allObjects.size(), _("Creating sample cache"));
 
   wxFileOutputStream file(m_CacheFilename);
 
@@ -716,27 +781,29 @@ bool GOOrganController::UpdateCache(GOProgressDialog *dlg, bool compress) {
     /* Save pipes to cache */
     isOk = writer.WriteHeader();
 
-    GOHashType hash = GenerateCacheHash();
+    GOHashType hash = GenerateCacheFormatHash();
     if (!writer.Write(&hash, sizeof(hash)))
       isOk = false;
 
-    while (isOk) {
-      GOCacheObject *obj = objectDistributor.FetchNext();
+    for (unsigned i = 0; isOk && i < allObjects.size(); i++) {
+      GOCacheObject *obj = allObjects[i];
+      const uint64_t startPos = writer.GetPos();
 
-      if (!obj)
-        break;
       if (!obj->SaveCache(writer)) {
         isOk = false;
         wxLogError(
           _("Save of %s to the cache failed"), obj->GetLoadTitle().c_str());
       }
-      if (!dlg->Update(objectDistributor.GetPos(), obj->GetLoadTitle())) {
+      index.AddEntry(obj->GetCacheHash(), writer.GetPos() - startPos);
+      if (!dlg->Update(i + 1, obj->GetLoadTitle())) {
         writer.Close();
         DeleteCache();
         isOk = false;
       }
     }
-    writer.Close();
+    // the sizes are known now, so the index follows the data
+    isOk = writer.Finish() && isOk && index.Write(file);
+    file.Close();
     if (!isOk)
       DeleteCache();
   } else
@@ -900,7 +967,7 @@ void GOOrganController::PreparePlayback(
 
   GOEventDistributor::StartPlayback();
   GOEventDistributor::PrepareRecording();
-  m_MidiPlayer->Setup(midi);
+  m_MidiPlayer->Setup(midi, engine);
 
   // Light the OnState button
   if (p_OnStateButton) {
@@ -936,6 +1003,9 @@ void GOOrganController::Update() {
 }
 
 void GOOrganController::ProcessMidi(const GOMidiEvent &event) {
+  GOSoundOrganEngine::EventTimeScope eventTime(event.GetTimeNs());
+  GOSoundSamplerBatch::Scope samplerBatch;
+
   if (event.GetMidiType() == GOMidiEvent::MIDI_RESET) {
     Reset();
     return;
@@ -14,6 +14,7 @@
 
 #include "ptrvector.h"
 
+#include "combinations/GOCombinationStore.h"
 #include "config/GOConfig.h"
 #include "control/GOEventDistributor.h"
 #include "control/GOLabelControl.h"
@@ -35,6 +36,8 @@ class GOArchive;
 class GOAudioRecorder;
 class GOButtonControl;
 class GOCache;
+class GOCacheIndex;
+class GOCacheObject;
 class GODialogSizeSet;
 class GODivisionalSetter;
 class GOElementCreator;
@@ -69,6 +72,8 @@ private:
   bool m_Cacheable;
   GOSetter *m_setter;
   GODivisionalSetter *m_DivisionalSetter;
+  // snapshots of the yaml combination files loaded or saved in this session
+  GOCombinationStore m_CombinationStore;
   GOAudioRecorder *m_AudioRecorder;
   GOMidiPlayer *m_MidiPlayer;
   GOMidiRecorder *m_MidiRecorder;
@@ -114,7 +119,22 @@ private:
   void OnIsModifiedChanged(bool modified);
 
   void ReadOrganFile(GOConfigReader &cfg);
-  GOHashType GenerateCacheHash();
+  /**
+   * Loads the objects with matching hashes from the cache entries. The
+   * entries that do not match any object are skipped.
+   * @param dlg the progress dialog
+   * @param reader the cache positioned after the format hash
+   * @param index the index read from the cache
+   * @param objects the objects to load. The objects loaded successfully are
+   *   removed from it
+   */
+  void LoadCacheEntries(
+    GOProgressDialog *dlg,
+    GOCache &reader,
+    const GOCacheIndex &index,
+    std::vector<GOCacheObject *> &objects);
+  // the hash of the cache file format and of the global settings
+  GOHashType GenerateCacheFormatHash();
   wxString GenerateSettingFileName();
   wxString GenerateCacheFileName();
   void SetTemperament(const GOTemperament &temperament);
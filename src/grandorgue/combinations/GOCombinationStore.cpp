@@ -0,0 +1,126 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOCombinationStore.h"
+
+#include <wx/datetime.h>
+#include <wx/filename.h>
+
+uint8_t GOCombinationStore::Reader::GetU8() {
+  const uint8_t *p = GetBytes(1);
+
+  return p ? *p : 0;
+}
+
+uint32_t GOCombinationStore::Reader::GetU32() {
+  const uint8_t *p = GetBytes(4);
+
+  return p ? p[0] | (p[1] << 8) | (p[2] << 16) | (uint32_t(p[3]) << 24) : 0;
+}
+
+const uint8_t *GOCombinationStore::Reader::GetBytes(unsigned length) {
+  const uint8_t *res = nullptr;
+
+  if (m_IsOk && unsigned(p_end - p_pos) >= length) {
+    res = p_pos;
+    p_pos += length;
+  } else
+    m_IsOk = false;
+  return res;
+}
+
+void GOCombinationStore::putU32(std::vector<uint8_t> &buf, uint32_t value) {
+  for (unsigned i = 0; i < 4; i++, value >>= 8)
+    buf.push_back(value & 0xFF);
+}
+
+bool GOCombinationStore::getFileState(
+  const wxString &fileName, int64_t &modificationTime, uint64_t &fileSize) {
+  const wxFileName fn(fileName);
+
+  if (!fn.FileExists())
+    return false;
+
+  const wxDateTime modTime = fn.GetModificationTime();
+  const wxULongLong size = fn.GetSize();
+
+  if (!modTime.IsValid() || size == wxInvalidSize)
+    return false;
+  modificationTime = modTime.GetValue().GetValue();
+  fileSize = size.GetValue();
+  return true;
+}
+
+void GOCombinationStore::Touch(Snapshot &snapshot, const wxString &fileName) {
+  if (snapshot.m_UsePos != m_UseOrder.end())
+    m_UseOrder.erase(snapshot.m_UsePos);
+  m_UseOrder.push_front(fileName);
+  snapshot.m_UsePos = m_UseOrder.begin();
+}
+
+bool GOCombinationStore::Restore(const wxString &fileName) {
+  auto found = m_snapshots.find(fileName);
+
+  if (found == m_snapshots.end())
+    return false;
+
+  Snapshot &snapshot = found->second;
+  int64_t modificationTime;
+  uint64_t fileSize;
+  bool isRestored = getFileState(fileName, modificationTime, fileSize)
+    && modificationTime == snapshot.m_ModificationTime
+    && fileSize == snapshot.m_FileSize;
+
+  if (isRestored) {
+    Reader reader(snapshot.m_data);
+
+    for (Storable *pStorable : m_storables)
+      if (!pStorable->FromBinary(reader)) {
+        isRestored = false;
+        break;
+      }
+    isRestored = isRestored && reader.IsOk() && reader.IsAtEnd();
+  }
+  if (isRestored)
+    Touch(snapshot, fileName);
+  else {
+    // the snapshot is outdated or broken
+    m_UseOrder.erase(snapshot.m_UsePos);
+    m_snapshots.erase(found);
+  }
+  return isRestored;
+}
+
+void GOCombinationStore::Store(const wxString &fileName) {
+  int64_t modificationTime;
+  uint64_t fileSize;
+
+  if (!getFileState(fileName, modificationTime, fileSize))
+    return;
+
+  auto inserted = m_snapshots.try_emplace(fileName);
+  Snapshot &snapshot = inserted.first->second;
+
+  if (inserted.second)
+    snapshot.m_UsePos = m_UseOrder.end();
+  snapshot.m_ModificationTime = modificationTime;
+  snapshot.m_FileSize = fileSize;
+  snapshot.m_data.clear();
+  for (const Storable *pStorable : m_storables)
+    pStorable->ToBinary(snapshot.m_data);
+  Touch(snapshot, fileName);
+
+  if (m_UseOrder.size() > MAX_SNAPSHOTS) {
+    m_snapshots.erase(m_UseOrder.back());
+    m_UseOrder.pop_back();
+  }
+}
+
+void GOCombinationStore::Clear() {
+  m_snapshots.clear();
+  m_UseOrder.clear();
+}
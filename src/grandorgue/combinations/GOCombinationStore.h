@@ -0,0 +1,126 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOCOMBINATIONSTORE_H
+#define GOCOMBINATIONSTORE_H
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include <wx/hashset.h>
+#include <wx/string.h>
+
+/**
+ * Keeps binary snapshots of the combination files loaded or saved during the
+ * session. When a yaml combination file that has an up to date snapshot is
+ * loaded again, the combinations are restored from the snapshot without
+ * parsing the yaml and matching the element names, so switching between the
+ * combination files is almost instant.
+ *
+ * The yaml files remain the only persistent format: the snapshots are kept in
+ * memory only and are discarded when the file is modified outside.
+ */
+class GOCombinationStore {
+public:
+  /**
+   * Sequentially reads the values from a snapshot. A read past the end of
+   * the snapshot returns zeros and makes the reader not ok
+   */
+  class Reader {
+  private:
+    const uint8_t *p_pos;
+    const uint8_t *p_end;
+    bool m_IsOk;
+
+  public:
+    Reader(const std::vector<uint8_t> &data)
+      : p_pos(data.data()), p_end(data.data() + data.size()), m_IsOk(true) {}
+
+    bool IsOk() const { return m_IsOk; }
+    bool IsAtEnd() const { return p_pos == p_end; }
+
+    uint8_t GetU8();
+    uint32_t GetU32();
+    /**
+     * Returns a pointer to the next length bytes of the snapshot and skips
+     * them. Returns nullptr if the snapshot is shorter
+     */
+    const uint8_t *GetBytes(unsigned length);
+  };
+
+  static void putU8(std::vector<uint8_t> &buf, uint8_t value) {
+    buf.push_back(value);
+  }
+  static void putU32(std::vector<uint8_t> &buf, uint32_t value);
+
+  /**
+   * An object that keeps combinations that are saved to the combination files
+   */
+  class Storable {
+  public:
+    virtual ~Storable() = default;
+
+    // Appends the combinations to the snapshot
+    virtual void ToBinary(std::vector<uint8_t> &buf) const = 0;
+    /**
+     * Restores the combinations from the snapshot
+     * @return false if the snapshot does not match the object. The object may
+     *   be partially restored then
+     */
+    virtual bool FromBinary(Reader &reader) = 0;
+  };
+
+private:
+  // no more snapshots are kept. The least recently used ones are discarded
+  static constexpr unsigned MAX_SNAPSHOTS = 256;
+
+  struct Snapshot {
+    // the file state the snapshot was taken for
+    int64_t m_ModificationTime;
+    uint64_t m_FileSize;
+    std::vector<uint8_t> m_data;
+    // the position in m_UseOrder
+    std::list<wxString>::iterator m_UsePos;
+  };
+
+  std::vector<Storable *> m_storables;
+  std::unordered_map<wxString, Snapshot, wxStringHash, wxStringEqual>
+    m_snapshots;
+  // the file names from the most recently used to the least recently used
+  std::list<wxString> m_UseOrder;
+
+  static bool getFileState(
+    const wxString &fileName, int64_t &modificationTime, uint64_t &fileSize);
+
+  void Touch(Snapshot &snapshot, const wxString &fileName);
+
+public:
+  // The storables must be added in the same order for each store
+  void AddStorable(Storable *pStorable) { m_storables.push_back(pStorable); }
+
+  /**
+   * Restores all the storables from the snapshot of the file
+   * @param fileName the combination file
+   * @return true if the combinations have been restored. false if there is no
+   *   up to date snapshot. Then the combinations have to be loaded from the
+   *   file and Store() to be called
+   */
+  bool Restore(const wxString &fileName);
+
+  /**
+   * Takes a snapshot of all the storables after they have been loaded from
+   * or saved to the file
+   * @param fileName the combination file
+   */
+  void Store(const wxString &fileName);
+
+  void Clear();
+};
+
+#endif /* GOCOMBINATIONSTORE_H */
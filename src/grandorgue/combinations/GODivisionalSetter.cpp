@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -345,6 +345,61 @@ void GODivisionalSetter::FromYaml(const YAML::Node &yamlNode) {
   }
 }
 
+void GODivisionalSetter::ToBinary(std::vector<uint8_t> &buf) const {
+  GOCombinationStore::putU32(buf, m_NManuals);
+  for (unsigned manualN = 0; manualN < m_NManuals; manualN++) {
+    GOManual *const pManual
+      = m_OrganController->GetManual(m_FirstManualIndex + manualN);
+    const unsigned nDivisionals = pManual->GetDivisionalCount();
+    const DivisionalMap &divMap = m_DivisionalMaps[manualN];
+
+    // simple divisionals
+    GOCombinationStore::putU32(buf, nDivisionals);
+    for (unsigned i = 0; i < nDivisionals; i++)
+      pManual->GetDivisional(i)->GetCombination().ToBinary(buf);
+
+    // banked divisionals
+    GOCombinationStore::putU32(buf, divMap.size());
+    for (auto &divEntry : divMap) {
+      GOCombinationStore::putU32(buf, divEntry.first);
+      divEntry.second->ToBinary(buf);
+    }
+  }
+}
+
+bool GODivisionalSetter::FromBinary(GOCombinationStore::Reader &reader) {
+  bool isOk = reader.GetU32() == m_NManuals;
+
+  for (unsigned manualN = 0; isOk && manualN < m_NManuals; manualN++) {
+    unsigned odfManualIndex = m_FirstManualIndex + manualN;
+    GOManual *const pManual = m_OrganController->GetManual(odfManualIndex);
+    const unsigned nDivisionals = pManual->GetDivisionalCount();
+    DivisionalMap &divMap = m_DivisionalMaps[manualN];
+
+    // simple divisionals
+    isOk = reader.GetU32() == nDivisionals;
+    for (unsigned i = 0; isOk && i < nDivisionals; i++)
+      isOk = pManual->GetDivisional(i)->GetCombination().FromBinary(reader);
+
+    // banked divisionals
+    const unsigned nBanked = isOk ? reader.GetU32() : 0;
+
+    for (auto &divEntry : divMap)
+      delete divEntry.second;
+    divMap.clear();
+    for (unsigned j = 0; isOk && j < nBanked; j++) {
+      unsigned i = reader.GetU32();
+      GODivisionalCombination *pCmb = new GODivisionalCombination(
+        *m_OrganController, odfManualIndex, false);
+
+      pCmb->Init(GetDivisionalButtonName(odfManualIndex, i), i);
+      isOk = pCmb->FromBinary(reader);
+      divMap[i] = pCmb;
+    }
+  }
+  return isOk && reader.IsOk();
+}
+
 template <typename F>
 void GODivisionalSetter::SwitchBank(unsigned manualN, const F &setNewBank) {
   if (manualN < m_NManuals) {
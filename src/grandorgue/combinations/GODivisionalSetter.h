@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -16,6 +16,7 @@
 
 #include "ptrvector.h"
 
+#include "combinations/GOCombinationStore.h"
 #include "control/GOCombinationButtonSet.h"
 #include "control/GOElementCreator.h"
 #include "yaml/GOSaveableToYaml.h"
@@ -30,7 +31,8 @@ struct GOSetterState;
 class GODivisionalSetter : public GOElementCreator,
                            private GOCombinationButtonSet,
                            GOSaveableObject,
-                           public GOSaveableToYaml {
+                           public GOSaveableToYaml,
+                           public GOCombinationStore::Storable {
 private:
   // Maps combination numbers to defined combinations
   // The first bank (A) has numbers from 0 to 9, the second one - from 10 to 19
@@ -121,6 +123,17 @@ public:
    */
   void FromYaml(const YAML::Node &yamlNode) override;
 
+  /**
+   * Puts the same combinations as ToYaml() to a binary snapshot
+   */
+  void ToBinary(std::vector<uint8_t> &buf) const override;
+
+  /**
+   * Restores the combinations from a binary snapshot
+   * @return false if the snapshot does not match the manuals
+   */
+  bool FromBinary(GOCombinationStore::Reader &reader) override;
+
   // it is not used but it is required to be as it is declared in
   // GOElementCreator
   GOEnclosure *GetEnclosure(const wxString &name, bool is_panel) override {
@@ -10,6 +10,7 @@
 #include <iomanip>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <wx/app.h>
 #include <wx/dir.h>
@@ -27,6 +28,7 @@
 #include "midi/objects/GOMidiObjectContext.h"
 #include "model/GODivisionalCoupler.h"
 #include "model/GOManual.h"
+#include "model/pipe-config/GOPipeConfigNode.h"
 #include "yaml/go-wx-yaml.h"
 
 #include "GOEvent.h"
@@ -1112,6 +1114,50 @@ void GOSetter::FromYaml(const YAML::Node &yamlNode) {
       >> *m_framegeneral[i];
 }
 
+static void cmbs_to_binary(
+  const ptr_vector<GOGeneralCombination> &cmbs, std::vector<uint8_t> &buf) {
+  GOCombinationStore::putU32(buf, cmbs.size());
+  for (unsigned l = cmbs.size(), i = 0; i < l; i++)
+    cmbs[i]->ToBinary(buf);
+}
+
+static bool cmbs_from_binary(
+  ptr_vector<GOGeneralCombination> &cmbs, GOCombinationStore::Reader &reader) {
+  bool isOk = reader.GetU32() == cmbs.size();
+
+  for (unsigned l = cmbs.size(), i = 0; isOk && i < l; i++)
+    isOk = cmbs[i]->FromBinary(reader);
+  return isOk;
+}
+
+void GOSetter::ToBinary(std::vector<uint8_t> &buf) const {
+  const unsigned nGenerals = m_OrganController->GetGeneralCount();
+
+  GOCombinationStore::putU32(buf, nGenerals);
+  for (unsigned i = 0; i < nGenerals; i++)
+    m_OrganController->GetGeneral(i)->GetCombination().ToBinary(buf);
+  cmbs_to_binary(m_general, buf);
+  for (unsigned i = 0; i < N_CRESCENDOS; i++)
+    GOCombinationStore::putU8(buf, m_CrescendoOverrideMode[i]);
+  cmbs_to_binary(m_crescendo, buf);
+  cmbs_to_binary(m_framegeneral, buf);
+}
+
+bool GOSetter::FromBinary(GOCombinationStore::Reader &reader) {
+  const unsigned nGenerals = m_OrganController->GetGeneralCount();
+  bool isOk = reader.GetU32() == nGenerals;
+
+  for (unsigned i = 0; isOk && i < nGenerals; i++)
+    isOk = m_OrganController->GetGeneral(i)->GetCombination().FromBinary(
+      reader);
+  isOk = isOk && cmbs_from_binary(m_general, reader);
+  for (unsigned i = 0; isOk && i < N_CRESCENDOS; i++)
+    m_CrescendoOverrideMode[i] = reader.GetU8();
+  isOk = isOk && cmbs_from_binary(m_crescendo, reader);
+  isOk = isOk && cmbs_from_binary(m_framegeneral, reader);
+  return isOk && reader.IsOk();
+}
+
 bool GOSetter::CopyFrameGenerals(
   unsigned fromIdx, unsigned toIdx, bool changedBefore) {
   const GOGeneralCombination *pNewCmb = m_framegeneral[fromIdx];
@@ -1143,6 +1189,14 @@ void GOSetter::DisplayPos() {
   m_PosDisplay.SetContent(wxString::Format(wxT("%03d"), m_pos));
 }
 
+// shifts both tunings, so the pipes are retuned once
+static void modify_pitch(GOPipeConfigNode &node, float diff) {
+  GOPipeConfigNode::DeferredUpdates deferredUpdates;
+
+  node.ModifyManualTuning(diff);
+  node.ModifyAutoTuningCorrection(diff);
+}
+
 void GOSetter::ButtonStateChanged(int id, bool newState) {
   switch (id) {
 
@@ -1376,28 +1430,22 @@ void GOSetter::ButtonStateChanged(int id, bool newState) {
     break;
   }
   case ID_SETTER_PITCH_M1:
-    m_OrganController->GetRootPipeConfigNode().ModifyManualTuning(-1);
-    m_OrganController->GetRootPipeConfigNode().ModifyAutoTuningCorrection(-1);
+    modify_pitch(m_OrganController->GetRootPipeConfigNode(), -1);
     break;
   case ID_SETTER_PITCH_M10:
-    m_OrganController->GetRootPipeConfigNode().ModifyManualTuning(-10);
-    m_OrganController->GetRootPipeConfigNode().ModifyAutoTuningCorrection(-10);
+    modify_pitch(m_OrganController->GetRootPipeConfigNode(), -10);
     break;
   case ID_SETTER_PITCH_M100:
-    m_OrganController->GetRootPipeConfigNode().ModifyManualTuning(-100);
-    m_OrganController->GetRootPipeConfigNode().ModifyAutoTuningCorrection(-100);
+    modify_pitch(m_OrganController->GetRootPipeConfigNode(), -100);
     break;
   case ID_SETTER_PITCH_P1:
-    m_OrganController->GetRootPipeConfigNode().ModifyManualTuning(1);
-    m_OrganController->GetRootPipeConfigNode().ModifyAutoTuningCorrection(1);
+    modify_pitch(m_OrganController->GetRootPipeConfigNode(), 1);
     break;
   case ID_SETTER_PITCH_P10:
-    m_OrganController->GetRootPipeConfigNode().ModifyManualTuning(10);
-    m_OrganController->GetRootPipeConfigNode().ModifyAutoTuningCorrection(10);
+    modify_pitch(m_OrganController->GetRootPipeConfigNode(), 10);
     break;
   case ID_SETTER_PITCH_P100:
-    m_OrganController->GetRootPipeConfigNode().ModifyManualTuning(100);
-    m_OrganController->GetRootPipeConfigNode().ModifyAutoTuningCorrection(100);
+    modify_pitch(m_OrganController->GetRootPipeConfigNode(), 100);
     break;
   case ID_SETTER_SAVE_SETTINGS:
     m_OrganController->Save();
@@ -1602,21 +1650,33 @@ void GOSetter::Crescendo(int newpos, bool force) {
 
   bool crescendoAddMode = !m_CrescendoOverrideMode[m_crescendobank];
   bool changed = false;
+  const unsigned baseIdx = m_crescendobank * CRESCENDO_STEPS;
 
-  while (pos > m_crescendopos) {
-    const unsigned oldIdx = m_crescendopos + m_crescendobank * CRESCENDO_STEPS;
-    const unsigned newIdx = oldIdx + 1;
+  if (m_state.m_IsActive) {
+    while (pos > m_crescendopos) {
+      const unsigned oldIdx = m_crescendopos + baseIdx;
+      const unsigned newIdx = oldIdx + 1;
 
-    ++m_crescendopos;
-    changed = changed || m_crescendo[newIdx]->Push(m_state);
-  }
+      ++m_crescendopos;
+      changed = changed || m_crescendo[newIdx]->Push(m_state);
+    }
 
-  while (pos < m_crescendopos) {
-    --m_crescendopos;
+    while (pos < m_crescendopos) {
+      --m_crescendopos;
 
-    const unsigned newIdx = m_crescendopos + m_crescendobank * CRESCENDO_STEPS;
+      const unsigned newIdx = m_crescendopos + baseIdx;
 
-    changed = changed || m_crescendo[newIdx]->Push(m_state);
+      changed = changed || m_crescendo[newIdx]->Push(m_state);
+    }
+  } else {
+    // a fast movement passes several steps. Apply them at once
+    std::vector<GOCombination *> steps;
+
+    while (pos > m_crescendopos)
+      steps.push_back(m_crescendo[++m_crescendopos + baseIdx]);
+    while (pos < m_crescendopos)
+      steps.push_back(m_crescendo[--m_crescendopos + baseIdx]);
+    changed = GOCombination::PushSequence(steps);
   }
   // switch combination buttons off in the crescendo override mode
   if (changed && !crescendoAddMode)
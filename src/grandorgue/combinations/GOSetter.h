@@ -14,6 +14,7 @@
 
 #include "ptrvector.h"
 
+#include "combinations/GOCombinationStore.h"
 #include "control/GOCombinationButtonSet.h"
 #include "control/GOCombinationController.h"
 #include "control/GOControlChangedHandler.h"
@@ -38,7 +39,8 @@ class GOSetter : private GOOrganLifecycleListener,
                  private GOControlChangedHandler,
                  public GOElementCreator,
                  public GOSaveableObject,
-                 public GOSaveableToYaml {
+                 public GOSaveableToYaml,
+                 public GOCombinationStore::Storable {
 public:
   enum {
     ID_SETTER_PREV = 0,
@@ -296,6 +298,9 @@ public:
    */
   void ToYaml(YAML::Node &yamlNode) const override;
   void FromYaml(const YAML::Node &yamlNode) override;
+  // Puts the same combinations as ToYaml() to a binary snapshot
+  void ToBinary(std::vector<uint8_t> &buf) const override;
+  bool FromBinary(GOCombinationStore::Reader &reader) override;
   void Load(GOConfigReader &cfg) override;
   void Save(GOConfigWriter &cfg) override;
   GOEnclosure *GetEnclosure(const wxString &name, bool is_panel) override;
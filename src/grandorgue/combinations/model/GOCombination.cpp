@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,6 +8,7 @@
 #include "GOCombination.h"
 
 #include <algorithm>
+#include <bit>
 
 #include <wx/intl.h>
 #include <wx/log.h>
@@ -21,6 +22,7 @@
 #include "model/GOStop.h"
 #include "model/GOSwitch.h"
 #include "model/GOTremulant.h"
+#include "sound/playing/GOSoundSamplerBatch.h"
 #include "yaml/go-wx-yaml.h"
 
 #include "GOCombinationDefinition.h"
@@ -34,6 +36,7 @@ GOCombination::GOCombination(
     m_Template(cmbDef),
     m_IsFull(false),
     m_HasScope(false),
+    m_IsPushMaskValid(false),
     r_ElementDefinitions(cmbDef.GetElements()),
     m_Protected(false) {}
 
@@ -45,11 +48,13 @@ void GOCombination::Clear() {
     m_ElementStates[i] = BOOL3_DEFAULT;
   m_IsFull = false;
   m_HasScope = false;
+  m_IsPushMaskValid = false;
 }
 
 void GOCombination::Copy(const GOCombination *combination) {
   assert(&m_Template == &combination->m_Template);
   m_ElementStates = combination->m_ElementStates;
+  m_IsPushMaskValid = false;
   EnsureElementStatesAllocated();
 }
 
@@ -72,6 +77,7 @@ void GOCombination::SetLoadedState(
   if (pos >= 0) {
     GOBool3 &state = m_ElementStates[pos];
 
+    m_IsPushMaskValid = false;
     // when loading scope/scoped cmb from yaml, the same element may be read
     // twice: for the scope and for the regular cmb
     if (state == BOOL3_DEFAULT || (m_HasScope && state == BOOL3_FALSE))
@@ -216,6 +222,8 @@ void GOCombination::SetStatesFromYaml(
 void GOCombination::EnsureElementStatesAllocated() {
   unsigned defSize = r_ElementDefinitions.size();
 
+  if (m_ElementStates.size() != defSize)
+    m_IsPushMaskValid = false;
   if (m_ElementStates.size() > defSize)
     m_ElementStates.resize(defSize);
   else if (m_ElementStates.size() < defSize) {
@@ -366,12 +374,47 @@ void GOCombination::FromYaml(const YAML::Node &yamlNode) {
   }
 }
 
+// flags of a combination in a binary snapshot
+static constexpr uint8_t BINARY_FULL = 1;
+static constexpr uint8_t BINARY_SCOPE = 2;
+
+void GOCombination::ToBinary(std::vector<uint8_t> &buf) const {
+  GOCombinationStore::putU8(
+    buf, (m_IsFull ? BINARY_FULL : 0) | (m_HasScope ? BINARY_SCOPE : 0));
+  if (IsEmpty())
+    // an empty combination is restored with Clear()
+    GOCombinationStore::putU32(buf, 0);
+  else {
+    GOCombinationStore::putU32(buf, m_ElementStates.size());
+    for (GOBool3 state : m_ElementStates)
+      GOCombinationStore::putU8(buf, uint8_t(state));
+  }
+}
+
+bool GOCombination::FromBinary(GOCombinationStore::Reader &reader) {
+  const uint8_t flags = reader.GetU8();
+  const unsigned nElements = reader.GetU32();
+  const uint8_t *states = reader.GetBytes(nElements);
+  const bool isOk
+    = reader.IsOk() && (!nElements || nElements == r_ElementDefinitions.size());
+
+  if (isOk && !m_Protected) {
+    Clear();
+    m_IsFull = flags & BINARY_FULL;
+    m_HasScope = flags & BINARY_SCOPE;
+    for (unsigned i = 0; i < nElements; i++)
+      m_ElementStates[i] = GOBool3(int8_t(states[i]));
+  }
+  return isOk;
+}
+
 bool GOCombination::FillWithCurrent(
   GOSetterState::SetterType setterType, bool isToStoreInvisibleObjects) {
   bool used = false;
 
   EnsureElementStatesAllocated();
   m_IsFull = isToStoreInvisibleObjects;
+  m_IsPushMaskValid = false;
   switch (setterType) {
   case GOSetterState::SETTER_REGULAR:
     m_HasScope = false;
@@ -416,6 +459,50 @@ bool GOCombination::FillWithCurrent(
   return used;
 }
 
+void GOCombination::BuildPushMask() {
+  const unsigned nWords = (m_ElementStates.size() + 63) / 64;
+
+  m_PushMask.assign(nWords, 0);
+  m_PushOnBits.assign(nWords, 0);
+  for (unsigned i = 0; i < m_ElementStates.size(); i++)
+    if (m_ElementStates[i] != BOOL3_DEFAULT) {
+      const uint64_t bit = uint64_t(1) << (i % 64);
+
+      m_PushMask[i / 64] |= bit;
+      if (m_ElementStates[i] == BOOL3_TRUE)
+        m_PushOnBits[i / 64] |= bit;
+    }
+  m_IsPushMaskValid = true;
+}
+
+void GOCombination::EnsurePushMaskValid() {
+  EnsureElementStatesAllocated();
+  if (!m_IsPushMaskValid)
+    BuildPushMask();
+}
+
+bool GOCombination::ApplyPushMask(
+  const std::vector<uint64_t> &pushMask,
+  const std::vector<uint64_t> &pushOnBits) const {
+  // start all pipes of the new registration in the same period
+  GOSoundSamplerBatch::Scope samplerBatch;
+  // evaluate the switch functions once after all elements are set
+  GOOrganModel::DeferredDrawstopUpdates deferredUpdates(r_OrganModel);
+  bool used = false;
+
+  // visit only the elements to set
+  for (unsigned w = 0; w < pushMask.size(); w++)
+    for (uint64_t bits = pushMask[w]; bits; bits &= bits - 1) {
+      const unsigned bitIndex = std::countr_zero(bits);
+      const bool elementState = (pushOnBits[w] >> bitIndex) & 1;
+
+      r_ElementDefinitions[w * 64 + bitIndex].control->SetCombinationState(
+        elementState, m_CombinationStateName);
+      used = used || elementState;
+    }
+  return used;
+}
+
 bool GOCombination::Push(const GOSetterState &setterState) {
   bool used = false;
 
@@ -425,18 +512,35 @@ bool GOCombination::Push(const GOSetterState &setterState) {
         setterState.m_SetterType, setterState.m_IsStoreInvisible);
     }
   } else {
-    EnsureElementStatesAllocated();
-    for (unsigned i = 0; i < r_ElementDefinitions.size(); i++) {
-      if (m_ElementStates[i] != BOOL3_DEFAULT) {
-        bool elementState = to_bool(m_ElementStates[i]);
+    EnsurePushMaskValid();
+    used = ApplyPushMask(m_PushMask, m_PushOnBits);
+  }
 
-        r_ElementDefinitions[i].control->SetCombinationState(
-          elementState, m_CombinationStateName);
-        used = used || elementState;
-      }
+  return used;
+}
+
+bool GOCombination::PushSequence(const std::vector<GOCombination *> &cmbs) {
+  std::vector<uint64_t> pushMask;
+  std::vector<uint64_t> pushOnBits;
+  bool used = false;
+
+  if (cmbs.empty())
+    return false;
+  for (GOCombination *pCmb : cmbs) {
+    pCmb->EnsurePushMaskValid();
+    pushMask.resize(pCmb->m_PushMask.size(), 0);
+    pushOnBits.resize(pCmb->m_PushOnBits.size(), 0);
+    for (unsigned w = 0; w < pCmb->m_PushMask.size(); w++) {
+      const uint64_t mask = pCmb->m_PushMask[w];
+      const uint64_t onBits = pCmb->m_PushOnBits[w];
+
+      // a later combination overrides the states set by the earlier ones
+      pushMask[w] |= mask;
+      pushOnBits[w] = (pushOnBits[w] & ~mask) | onBits;
+      used = used || onBits;
     }
   }
-
+  cmbs.back()->ApplyPushMask(pushMask, pushOnBits);
   return used;
 }
 
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,9 +8,11 @@
 #ifndef GOCOMBINATION_H
 #define GOCOMBINATION_H
 
+#include <cstdint>
 #include <unordered_set>
 #include <vector>
 
+#include "combinations/GOCombinationStore.h"
 #include "config/GOConfigReader.h"
 #include "yaml/GOSaveableToYaml.h"
 
@@ -38,6 +40,16 @@ private:
    */
   std::vector<GOBool3> m_ElementStates;
 
+  /**
+   * The element states packed for Push(): m_PushMask has a bit for each
+   * element that is not BOOL3_DEFAULT, m_PushOnBits has a bit for each
+   * BOOL3_TRUE element. They are rebuilt by the first Push() after
+   * m_ElementStates has been changed
+   */
+  std::vector<uint64_t> m_PushMask;
+  std::vector<uint64_t> m_PushOnBits;
+  bool m_IsPushMaskValid;
+
   /**
    * Whether the combination has been captured when `Full` was engaged or not
    * If the combination is Full then all elements can have states 0 and 1, else
@@ -52,6 +64,17 @@ private:
 
   void PutElementsToYaml(YAML::Node &yamlMap, GOBool3 stateFrom) const;
 
+  void BuildPushMask();
+  // ensures that m_PushMask and m_PushOnBits are up to date
+  void EnsurePushMaskValid();
+  /**
+   * Sets the elements with the bits in pushMask to the states in pushOnBits
+   * @return if any element is enabled
+   */
+  bool ApplyPushMask(
+    const std::vector<uint64_t> &pushMask,
+    const std::vector<uint64_t> &pushOnBits) const;
+
 protected:
   const std::vector<GOCombinationDefinition::Element> &r_ElementDefinitions;
   bool m_Protected;
@@ -177,7 +200,26 @@ public:
 
   void FromYaml(const YAML::Node &yamlNode) override;
 
+  // Appends the combination to a binary snapshot of a combination file
+  void ToBinary(std::vector<uint8_t> &buf) const;
+  /**
+   * Restores the combination from a binary snapshot. A protected combination
+   * is not changed
+   * @return false if the snapshot does not match the combination definition
+   */
+  bool FromBinary(GOCombinationStore::Reader &reader);
+
   bool Push(const GOSetterState &setterState);
+
+  /**
+   * Pushes the combinations with the same result as pushing them one after
+   * another when the setter is not active, but sets each element only once:
+   * to the state of the last combination that sets it. All the combinations
+   * must have the same definition and the same combination state name
+   * @param cmbs the combinations in the order of pushing
+   * @return if any of the combinations enables an element
+   */
+  static bool PushSequence(const std::vector<GOCombination *> &cmbs);
 };
 
 #endif
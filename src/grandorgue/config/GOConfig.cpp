@@ -315,6 +315,7 @@ GOConfig::GOConfig(
     ManagePolyphony(this, GENERAL, wxT("ManagePolyphony"), true),
     ScaleRelease(this, GENERAL, wxT("ScaleRelease"), true),
     RandomizeSpeaking(this, GENERAL, wxT("RandomizeSpeaking"), true),
+    EventLatency(this, GENERAL, wxT("EventLatency"), 0, 4, 0),
     NewBasMelBehaviour(this, GENERAL, wxT("NewBasMelBehaviour"), false),
     ReverbEnabled(this, wxT("Reverb"), wxT("ReverbEnabled"), false),
     ReverbDirect(this, wxT("Reverb"), wxT("ReverbDirect"), true),
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -24,6 +24,7 @@ void GOMidiDeviceConfig::AssignMidiDeviceConfig(const GOMidiDeviceConfig &src) {
   m_IsEnabled = src.m_IsEnabled;
   m_ChannelShift = src.m_ChannelShift;
   p_OutputDevice = NULL;
+  m_IsRateLimited = src.m_IsRateLimited;
 }
 
 void GOMidiDeviceConfig::Assign(const GOMidiDeviceConfig &src) {
@@ -34,6 +35,7 @@ void GOMidiDeviceConfig::Assign(const GOMidiDeviceConfig &src) {
 static const wxString WX_ENABLED = wxT("Enabled");
 static const wxString WX_SHIFT = wxT("Shift");
 static const wxString WX_OUTPUT_DEVICE = wxT("OutputDevice");
+static const wxString WX_RATE_LIMITED = wxT("RateLimited");
 
 void GOMidiDeviceConfig::LoadDeviceConfig(
   GOConfigReader &cfg,
@@ -47,9 +49,12 @@ void GOMidiDeviceConfig::LoadDeviceConfig(
       = cfg.ReadInteger(CMBSetting, group, prefix + WX_SHIFT, 0, 15);
     m_OutputDeviceName
       = cfg.ReadString(CMBSetting, group, prefix + WX_OUTPUT_DEVICE, false);
+    m_IsRateLimited = false;
   } else {
     m_ChannelShift = 0;
     m_OutputDeviceName = wxEmptyString;
+    m_IsRateLimited = cfg.ReadBoolean(
+      CMBSetting, group, prefix + WX_RATE_LIMITED, false, false);
   }
 }
 
@@ -65,5 +70,6 @@ void GOMidiDeviceConfig::SaveDeviceConfig(
     if (p_OutputDevice)
       cfg.WriteString(
         group, prefix + WX_OUTPUT_DEVICE, p_OutputDevice->GetLogicalName());
-  }
+  } else
+    cfg.WriteBoolean(group, prefix + WX_RATE_LIMITED, m_IsRateLimited);
 }
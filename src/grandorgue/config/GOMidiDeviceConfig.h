@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -26,6 +26,8 @@ public:
   int m_ChannelShift = 0;
   wxString m_OutputDeviceName;
   GOMidiDeviceConfig *p_OutputDevice = NULL;
+  // Midi-out only. Limit the sending rate to the speed of a DIN midi cable
+  bool m_IsRateLimited = false;
 
   GOMidiDeviceConfig() {}
 
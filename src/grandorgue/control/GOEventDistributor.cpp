@@ -16,8 +16,19 @@
 #include "GOSaveableObject.h"
 
 void GOEventDistributor::SendMidi(const GOMidiEvent &event) {
-  for (auto handler : p_model->GetMidiEventHandlers())
-    handler->ProcessMidi(event);
+  const auto &handlers = p_model->GetMidiEventHandlers();
+
+  if (GOMidiRoutingIndex::isBroadcast(event.GetMidiType())) {
+    for (auto handler : handlers)
+      handler->ProcessMidi(event);
+    // the receivers might have changed their internal matches
+    m_MidiRoutes.Invalidate();
+  } else {
+    m_MidiRoutes.Update(handlers, p_model->GetMidiEventHandlersVersion());
+    m_MidiRoutes.ForEachHandler(event, [&handlers, &event](unsigned i) {
+      handlers[i]->ProcessMidi(event);
+    });
+  }
 }
 
 void GOEventDistributor::HandleKey(int key) {
@@ -40,12 +51,9 @@ void GOEventDistributor::ResolveReferences() {
     obj->InitWithoutExc();
 }
 
-void GOEventDistributor::UpdateHash(GOHash &hash) {
-  for (auto obj : p_model->GetCacheObjects())
-    obj->UpdateHash(hash);
-}
-
 void GOEventDistributor::PreparePlayback() {
+  // the receivers reset their internal matches
+  m_MidiRoutes.Invalidate();
   for (auto handler : p_model->GetLifecycleListeners())
     handler->PreparePlayback();
 }
@@ -10,15 +10,17 @@
 
 #include <vector>
 
+#include "midi/GOMidiRoutingIndex.h"
+
 class GOConfigReader;
 class GOConfigWriter;
 class GOEventHandlerList;
-class GOHash;
 class GOMidiEvent;
 
 class GOEventDistributor {
 private:
   GOEventHandlerList *p_model;
+  GOMidiRoutingIndex m_MidiRoutes;
 
 protected:
   void SendMidi(const GOMidiEvent &event);
@@ -27,7 +29,6 @@ protected:
   void Save(GOConfigWriter &cfg);
 
   void ResolveReferences();
-  void UpdateHash(GOHash &hash);
 
   void PreparePlayback();
   void StartPlayback();
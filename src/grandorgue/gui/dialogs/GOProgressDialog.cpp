@@ -2,7 +2,7 @@
  * GrandOrgue - a free pipe organ simulator
  *
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  *
  * This program is free software; you can redistribute it and/or
  * modify it under the terms of the GNU General Public License as
@@ -22,13 +22,19 @@
 #include "GOProgressDialog.h"
 #include "gui/wxcontrols/go_gui_utils.h"
 
+#include <wx/log.h>
 #include <wx/progdlg.h>
 #include <wx/stopwatch.h>
 
 #define DLG_MAX_VALUE 0x10000
 
-GOProgressDialog::GOProgressDialog()
-  : m_dlg(NULL), m_last(0), m_const(0), m_value(0), m_max(0) {}
+GOProgressDialog::GOProgressDialog(bool isHeadless)
+  : m_IsHeadless(isHeadless),
+    m_dlg(NULL),
+    m_last(0),
+    m_const(0),
+    m_value(0),
+    m_max(0) {}
 
 GOProgressDialog::~GOProgressDialog() {
   if (m_dlg)
@@ -39,6 +45,10 @@ void GOProgressDialog::Setup(
   long max, const wxString &title, const wxString &msg) {
   if (m_dlg)
     m_dlg->Destroy();
+  if (m_IsHeadless) {
+    wxLogMessage(wxT("%s: %s"), title, msg);
+    return;
+  }
   m_dlg = new wxProgressDialog(
     title,
     msg,
@@ -2,7 +2,7 @@
  * GrandOrgue - a free pipe organ simulator
  *
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  *
  * This program is free software; you can redistribute it and/or
  * modify it under the terms of the GNU General Public License as
@@ -28,6 +28,8 @@ class wxProgressDialog;
 
 class GOProgressDialog {
 private:
+  // whether to log the progress messages instead of showing a dialog
+  bool m_IsHeadless;
   wxProgressDialog *m_dlg;
   long m_last;
   long m_const;
@@ -35,7 +37,11 @@ private:
   long m_max;
 
 public:
-  GOProgressDialog();
+  /**
+   * @param isHeadless whether there is no gui. Then only the messages passed
+   *   to Setup are logged
+   */
+  GOProgressDialog(bool isHeadless = false);
   ~GOProgressDialog();
 
   void Setup(
@@ -884,9 +884,11 @@ void GOMidiEventRecvTab::DetectEvent() {
                                      MIDI_M_SYSEX_RODGERS_STOP_CHANGE);
                    i++) {
                 if (
-                  GORodgersGetBit(i, off.GetKey(), off.GetData())
+                  GORodgersGetBit(
+                    i, off.GetKey(), off.GetData(), off.GetDataSize())
                     == MIDI_BIT_STATE::MIDI_BIT_CLEAR
-                  && GORodgersGetBit(i, on.GetKey(), on.GetData())
+                  && GORodgersGetBit(
+                       i, on.GetKey(), on.GetData(), on.GetDataSize())
                     == MIDI_BIT_STATE::MIDI_BIT_SET) {
                   key = on.GetChannel();
                   low = i;
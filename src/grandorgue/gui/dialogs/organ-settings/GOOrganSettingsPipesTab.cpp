@@ -967,6 +967,8 @@ void GOOrganSettingsPipesTab::DistributeAudio() {
   wxArrayTreeItemIds entries;
   m_Tree->GetSelections(entries);
   unsigned pos = 0;
+  GOPipeConfigNode::DeferredUpdates deferredUpdates;
+
   for (unsigned i = 0; i < entries.size(); i++)
     UpdateAudioGroup(group_list, pos, entries[i]);
   p_LastTreeItemData = NULL;
@@ -1023,6 +1025,9 @@ void GOOrganSettingsPipesTab::ResetToDefault() {
       }
     }
 
+    // each pipe is updated once after all the nodes are reset
+    GOPipeConfigNode::DeferredUpdates deferredUpdates;
+
     for (TreeItemData *e : oiSet) {
       e->r_config.SetAmplitude(e->r_config.GetDefaultAmplitude());
       e->r_config.SetGain(e->r_config.GetDefaultGain());
@@ -1119,6 +1124,8 @@ void GOOrganSettingsPipesTab::ApplyChanges() {
     return;
   }
 
+  GOPipeConfigNode::DeferredUpdates deferredUpdates;
+
   for (unsigned i = 0; i < entries.size(); i++) {
     TreeItemData *e = (TreeItemData *)m_Tree->GetItemData(entries[i]);
     if (!e)
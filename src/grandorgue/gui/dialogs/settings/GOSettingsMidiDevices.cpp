@@ -25,6 +25,8 @@ EVT_LISTBOX_DCLICK(ID_INDEVICES, SettingsMidiDevices::OnInOutDeviceClick)
 EVT_BUTTON(ID_INCHANNELSHIFT, SettingsMidiDevices::OnInChannelShiftClick)
 EVT_BUTTON(ID_INOUTDEVICE, SettingsMidiDevices::OnInOutDeviceClick)
 EVT_LISTBOX(ID_OUTDEVICES, SettingsMidiDevices::OnOutDevicesClick)
+EVT_LISTBOX_DCLICK(ID_OUTDEVICES, SettingsMidiDevices::OnOutRateLimitClick)
+EVT_BUTTON(ID_OUTRATELIMIT, SettingsMidiDevices::OnOutRateLimitClick)
 END_EVENT_TABLE()
 
 SettingsMidiDevices::SettingsMidiDevices(
@@ -97,12 +99,15 @@ SettingsMidiDevices::SettingsMidiDevices(
     this, ID_RECORDERDEVICE, wxDefaultPosition, wxSize(100, wxDefaultCoord));
   bottomGb->Add(
     m_RecorderDevice, wxGBPosition(1, 0), wxGBSpan(1, 2), wxEXPAND | wxALL);
+
+  wxBoxSizer *const outButtons = new wxBoxSizer(wxHORIZONTAL);
+
+  m_OutRateLimit = new wxButton(this, ID_OUTRATELIMIT, _("&Rate limit..."));
+  m_OutRateLimit->Disable();
+  outButtons->Add(m_OutRateLimit, 0, wxRIGHT, 5);
+  outButtons->Add(m_OutDevices.GetMatchingButton());
   bottomGb->Add(
-    m_OutDevices.GetMatchingButton(),
-    wxGBPosition(0, 1),
-    wxDefaultSpan,
-    wxALIGN_RIGHT | wxDOWN,
-    5);
+    outButtons, wxGBPosition(0, 1), wxDefaultSpan, wxALIGN_RIGHT | wxDOWN, 5);
   item3->Add(bottomGb, 0, wxEXPAND | wxDOWN | wxRIGHT | wxLEFT, 5);
 
   topSizer->Add(item3, 1, wxEXPAND | wxALL, 5);
@@ -126,6 +131,7 @@ void SettingsMidiDevices::RenewDevices(
   const GOPortsConfig &portsConfig, const bool isToAutoAddInput) {
   m_InProperties->Disable();
   m_InOutDevice->Disable();
+  m_OutRateLimit->Disable();
   m_Midi.UpdateDevices(portsConfig);
   m_OutDevices.RefreshDevices(portsConfig, false);
   m_InDevices.RefreshDevices(portsConfig, isToAutoAddInput, &m_OutDevices);
@@ -203,9 +209,30 @@ void SettingsMidiDevices::OnInChannelShiftClick(wxCommandEvent &event) {
 }
 
 void SettingsMidiDevices::OnOutDevicesClick(wxCommandEvent &event) {
+  m_OutRateLimit->Enable();
   m_OutDevices.OnSelected(event);
 }
 
+void SettingsMidiDevices::OnOutRateLimitClick(wxCommandEvent &event) {
+  GOMidiDeviceConfig &devConf = m_OutDevices.GetSelectedDeviceConf();
+  wxArrayString choices;
+
+  choices.Add(_("Unlimited"));
+  choices.Add(_("Limited to the speed of a DIN MIDI cable"));
+
+  int result = wxGetSingleChoiceIndex(
+    _("A device connected with a DIN MIDI cable may lose the messages sent\n"
+      "faster than the cable can transfer them, ex. when many stops are\n"
+      "changed at once. USB and virtual devices do not need the limit."),
+    devConf.GetPhysicalName(),
+    choices,
+    devConf.m_IsRateLimited ? 1 : 0,
+    this);
+
+  if (result >= 0)
+    devConf.m_IsRateLimited = result == 1;
+}
+
 bool SettingsMidiDevices::TransferDataFromWindow() {
   m_config.IsToAutoAddMidi(m_AutoAddInput->IsChecked());
   m_config.IsToCheckMidiOnStart(m_CheckOnStartup->IsChecked());
@@ -31,6 +31,7 @@ class SettingsMidiDevices : public wxPanel, GOSettingsPorts {
     ID_INCHANNELSHIFT,
     ID_INOUTDEVICE,
     ID_OUTDEVICES,
+    ID_OUTRATELIMIT,
     ID_RECORDERDEVICE,
   };
 
@@ -45,6 +46,7 @@ private:
   wxCheckBox *m_CheckOnStartup;
   wxButton *m_InProperties;
   wxButton *m_InOutDevice;
+  wxButton *m_OutRateLimit;
   wxChoice *m_RecorderDevice;
 
   void RenewDevices(
@@ -58,6 +60,7 @@ private:
   void OnInOutDeviceClick(wxCommandEvent &event);
   void OnInChannelShiftClick(wxCommandEvent &event);
   void OnOutDevicesClick(wxCommandEvent &event);
+  void OnOutRateLimitClick(wxCommandEvent &event);
 
 public:
   SettingsMidiDevices(GOConfig &settings, GOMidiSystem &midi, wxWindow *parent);
@@ -199,6 +199,21 @@ GOSettingsOptions::GOSettingsOptions(GOConfig &settings, wxWindow *parent)
     0,
     wxALL);
 
+  choices.clear();
+  choices.push_back(_("Off"));
+  choices.push_back(_("1 period"));
+  for (unsigned i = 2; i <= 4; i++)
+    choices.push_back(wxString::Format(_("%u periods"), i));
+  grid->Add(
+    new wxStaticText(this, wxID_ANY, _("MIDI event latency:")),
+    0,
+    wxALIGN_CENTER_VERTICAL | wxALIGN_RIGHT);
+  grid->Add(
+    m_EventLatency = new wxChoice(
+      this, ID_EVENT_LATENCY, wxDefaultPosition, wxDefaultSize, choices),
+    0,
+    wxALL);
+
   choices.clear();
   choices.push_back(_("8 Bit PCM"));
   choices.push_back(_("16 Bit PCM"));
@@ -242,6 +257,7 @@ GOSettingsOptions::GOSettingsOptions(GOConfig &settings, wxWindow *parent)
   m_Concurrency->Select(m_config.Concurrency() - 1);
   m_ReleaseConcurrency->Select(m_config.ReleaseConcurrency() - 1);
   m_LoadConcurrency->Select(m_config.LoadConcurrency());
+  m_EventLatency->Select(m_config.EventLatency());
   m_WaveFormat->Select(m_config.WaveFormatBytesPerSample() - 1);
   m_RecordDownmix->SetValue(m_config.RecordDownmix());
 
@@ -416,6 +432,7 @@ bool GOSettingsOptions::TransferDataFromWindow() {
   m_config.Concurrency(m_Concurrency->GetSelection() + 1);
   m_config.ReleaseConcurrency(m_ReleaseConcurrency->GetSelection() + 1);
   m_config.LoadConcurrency(m_LoadConcurrency->GetSelection());
+  m_config.EventLatency(m_EventLatency->GetSelection());
   m_config.WaveFormatBytesPerSample(m_WaveFormat->GetSelection() + 1);
   m_config.BitsPerSample(m_BitsPerSample->GetSelection() * 4 + 8);
   m_config.LoopLoad(m_LoopLoad->GetSelection());
@@ -42,6 +42,7 @@ class GOSettingsOptions : public wxPanel {
     ID_VOLUME,
     ID_LANGUAGE,
     ID_NEW_BAS_MEL,
+    ID_EVENT_LATENCY,
   };
 
 private:
@@ -49,6 +50,7 @@ private:
   wxChoice *m_Concurrency;
   wxChoice *m_ReleaseConcurrency;
   wxChoice *m_LoadConcurrency;
+  wxChoice *m_EventLatency;
   wxChoice *m_WaveFormat;
   wxCheckBox *m_LosslessCompression;
   wxCheckBox *m_Limit;
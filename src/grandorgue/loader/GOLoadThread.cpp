@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -9,6 +9,14 @@
 
 #include "model/GOCacheObject.h"
 
+#include "GOWavPack.h"
+
+GOLoadThread::~GOLoadThread() {
+  Stop();
+  if (m_IsLent)
+    GOWavPack::LendThreads(-1);
+}
+
 bool GOLoadThread::CheckExceptions() {
   Wait();
   return WereExceptions();
@@ -19,4 +27,8 @@ void GOLoadThread::Entry() {
 
   while (!ShouldStop() && LoadNextObject(obj)) {
   }
+  // There is nothing to load more. Let the threads that are still loading
+  // decode their large files faster
+  GOWavPack::LendThreads(1);
+  m_IsLent = true;
 }
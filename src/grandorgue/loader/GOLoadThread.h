@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -14,6 +14,9 @@
 
 class GOLoadThread : private GOLoadWorker, private GOThread {
 private:
+  // whether the thread has lent itself for decoding other files
+  bool m_IsLent;
+
   /* the main loading loop. It takes objects from the m_CacheObjects
    * concurrently with other threads loads them
    */
@@ -24,8 +27,8 @@ public:
     const GOFileStore &fileStore,
     GOMemoryPool &pool,
     GOCacheObjectDistributor &distributor)
-    : GOLoadWorker(fileStore, pool, distributor) {}
-  ~GOLoadThread() { Stop(); }
+    : GOLoadWorker(fileStore, pool, distributor), m_IsLent(false) {}
+  ~GOLoadThread();
 
   void Run() { Start(); }
 
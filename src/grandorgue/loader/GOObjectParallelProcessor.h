@@ -0,0 +1,100 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOOBJECTPARALLELPROCESSOR_H
+#define GOOBJECTPARALLELPROCESSOR_H
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <vector>
+
+#include "threading/GOThread.h"
+
+#include "ptrvector.h"
+
+/**
+ * Calls a function for each object of a vector concurrently in the calling
+ * thread and in several additional worker threads. Each object is processed
+ * exactly once.
+ * If the function throws an exception for some objects then after all objects
+ * are processed the exception of the first failed object (in the vector order)
+ * is rethrown in the calling thread, so the result does not depend on the
+ * thread scheduling.
+ */
+
+template <class T> class GOObjectParallelProcessor {
+public:
+  using Function = std::function<void(T *)>;
+
+private:
+  class Worker : public GOThread {
+  private:
+    GOObjectParallelProcessor &r_processor;
+
+    void Entry() override { r_processor.ProcessObjects(this); }
+
+  public:
+    Worker(GOObjectParallelProcessor &processor) : r_processor(processor) {}
+    ~Worker() { Stop(); }
+  };
+
+  const std::vector<T *> &r_objects;
+  const Function m_function;
+  std::vector<std::exception_ptr> m_exceptions;
+  std::atomic_uint m_pos;
+
+  /**
+   * Processes the objects that have not been taken by other threads yet
+   * @param pThread the worker thread or nullptr for the calling thread
+   */
+  void ProcessObjects(GOThread *pThread) {
+    const unsigned nObjects = r_objects.size();
+    unsigned pos;
+
+    while ((!pThread || !pThread->ShouldStop())
+           && (pos = m_pos.fetch_add(1)) < nObjects) {
+      try {
+        m_function(r_objects[pos]);
+      } catch (...) {
+        m_exceptions[pos] = std::current_exception();
+      }
+    }
+  }
+
+public:
+  GOObjectParallelProcessor(
+    const std::vector<T *> &objects, const Function &function)
+    : r_objects(objects),
+      m_function(function),
+      m_exceptions(objects.size()),
+      m_pos(0) {}
+
+  /**
+   * Processes all objects and waits for completion
+   * @param nAdditionalThreads the number of worker threads to start in
+   *   addition to the calling one. 0 means processing in the calling thread
+   *   only
+   */
+  void Run(unsigned nAdditionalThreads) {
+    {
+      ptr_vector<Worker> workers;
+
+      for (unsigned i = 0; i < nAdditionalThreads && i < r_objects.size(); i++)
+        workers.push_back(new Worker(*this));
+      for (Worker *pWorker : workers)
+        pWorker->Start();
+      ProcessObjects(nullptr);
+      // ~ptr_vector waits for all workers
+    }
+    for (const auto &e : m_exceptions)
+      if (e)
+        std::rethrow_exception(e);
+  }
+};
+
+#endif /* GOOBJECTPARALLELPROCESSOR_H */
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -20,7 +20,8 @@ GOCache::GOCache(wxFile &cache_file, GOMemoryPool &pool)
     m_zstream(0),
     m_pool(pool),
     m_Mapable(false),
-    m_OK(false) {
+    m_OK(false),
+    m_pos(0) {
   int magic;
 
   m_stream = m_fstream = new wxFileInputStream(cache_file);
@@ -65,11 +66,33 @@ void GOCache::Close() {
 
 bool GOCache::Read(void *data, unsigned length) {
   m_stream->Read(data, length);
+  m_pos += m_stream->LastRead();
   if (m_stream->LastRead() != length)
     return false;
   return true;
 }
 
+bool GOCache::Skip(unsigned long long length) {
+  if (!m_zstream) {
+    if (m_stream->SeekI(length, wxFromCurrent) == wxInvalidOffset)
+      return false;
+    m_pos += length;
+    return true;
+  }
+
+  // a compressed stream is not seekable
+  char buffer[0x10000];
+
+  while (length) {
+    unsigned chunk = length < sizeof(buffer) ? length : sizeof(buffer);
+
+    if (!Read(buffer, chunk))
+      return false;
+    length -= chunk;
+  }
+  return true;
+}
+
 void GOCache::FreeCacheFile() {
   m_Mapable = false;
   m_pool.FreeCacheFile();
@@ -80,6 +103,7 @@ void *GOCache::ReadBlock(unsigned length) {
     void *data = m_pool.GetCacheData(m_stream->TellI(), length);
     if (data) {
       m_stream->SeekI(length, wxFromCurrent);
+      m_pos += length;
       return data;
     }
   }
@@ -88,6 +112,7 @@ void *GOCache::ReadBlock(unsigned length) {
     throw GOOutOfMemory();
 
   m_stream->Read(data, length);
+  m_pos += m_stream->LastRead();
   if (m_stream->LastRead() != length) {
     m_pool.Free(data);
     return NULL;
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -19,6 +19,8 @@ class GOCache {
   GOMemoryPool &m_pool;
   bool m_Mapable;
   bool m_OK;
+  // the number of bytes read or skipped so far
+  unsigned long long m_pos;
 
 public:
   GOCache(wxFile &cache_file, GOMemoryPool &pool);
@@ -30,6 +32,10 @@ public:
   bool Read(void *data, unsigned length);
   /* Allocate and read a block written by WriteBlock */
   void *ReadBlock(unsigned length);
+  /* Skip length bytes without reading them into memory if possible */
+  bool Skip(unsigned long long length);
+  /* The number of bytes read or skipped so far */
+  unsigned long long GetPos() const { return m_pos; }
 
   void Close();
 };
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOCacheIndex.h"
+
+#include <wx/file.h>
+#include <wx/stream.h>
+
+// identifies the trailer of a valid index
+static constexpr uint32_t INDEX_MAGIC = 0x58444E49; // "INDX"
+
+// the size of one entry in the file
+static constexpr unsigned ENTRY_SIZE
+  = sizeof(GOHashType::hash) + sizeof(uint64_t);
+
+/**
+ * The trailer at the very end of the cache file. dataSize is the sum of the
+ * entry sizes, so an index that does not describe the data is rejected
+ */
+struct IndexTrailer {
+  uint64_t dataSize;
+  uint32_t nEntries;
+  uint32_t magic;
+};
+
+bool GOCacheIndex::Read(wxFile &file) {
+  const wxFileOffset fileLength = file.Length();
+  IndexTrailer trailer;
+  bool isOk = fileLength >= wxFileOffset(sizeof(trailer))
+    && file.Seek(fileLength - sizeof(trailer)) != wxInvalidOffset
+    && file.Read(&trailer, sizeof(trailer)) == sizeof(trailer)
+    && trailer.magic == INDEX_MAGIC;
+  const uint64_t indexSize = uint64_t(trailer.nEntries) * ENTRY_SIZE;
+
+  m_entries.clear();
+  isOk = isOk && indexSize <= uint64_t(fileLength) - sizeof(trailer)
+    && file.Seek(fileLength - sizeof(trailer) - indexSize) != wxInvalidOffset;
+
+  uint64_t dataSize = 0;
+
+  for (uint32_t i = 0; isOk && i < trailer.nEntries; i++) {
+    Entry entry;
+
+    isOk = file.Read(&entry.m_hash, sizeof(entry.m_hash))
+        == sizeof(entry.m_hash)
+      && file.Read(&entry.m_size, sizeof(entry.m_size))
+        == sizeof(entry.m_size);
+    if (isOk) {
+      dataSize += entry.m_size;
+      m_entries.push_back(entry);
+    }
+  }
+  isOk = isOk && dataSize == trailer.dataSize;
+  if (!isOk)
+    m_entries.clear();
+  file.Seek(0);
+  return isOk;
+}
+
+bool GOCacheIndex::Write(wxOutputStream &stream) const {
+  IndexTrailer trailer = {0, (uint32_t)m_entries.size(), INDEX_MAGIC};
+
+  for (const Entry &entry : m_entries) {
+    stream.Write(&entry.m_hash, sizeof(entry.m_hash));
+    stream.Write(&entry.m_size, sizeof(entry.m_size));
+    trailer.dataSize += entry.m_size;
+  }
+  stream.Write(&trailer, sizeof(trailer));
+  return stream.IsOk();
+}
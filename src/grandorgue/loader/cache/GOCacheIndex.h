@@ -0,0 +1,63 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOCACHEINDEX_H
+#define GOCACHEINDEX_H
+
+#include <cstdint>
+#include <vector>
+
+#include "GOHash.h"
+
+class wxFile;
+class wxOutputStream;
+
+/**
+ * The index of the cache file. It lists the entries in the order of their
+ * data. Each entry contains the cache hash of the object saved there and the
+ * size of the saved data, so an entry that does not match any object may be
+ * skipped without parsing it.
+ *
+ * The index is written uncompressed after the (possibly compressed) data, so
+ * the sizes are known when it is written and each object is serialized only
+ * once. It is followed by a fixed size trailer that allows to find the index
+ * from the end of the file.
+ */
+
+class GOCacheIndex {
+public:
+  struct Entry {
+    GOHashType m_hash;
+    uint64_t m_size;
+  };
+
+private:
+  std::vector<Entry> m_entries;
+
+public:
+  const std::vector<Entry> &GetEntries() const { return m_entries; }
+
+  void Clear() { m_entries.clear(); }
+  void AddEntry(const GOHashType &hash, uint64_t size) {
+    m_entries.push_back({hash, size});
+  }
+
+  /**
+   * Reads the index from the end of the cache file and seeks the file back to
+   * its start.
+   * @return false if the file has no valid index, for example if it is
+   *   truncated or the index does not match the data size
+   */
+  bool Read(wxFile &file);
+  /**
+   * Appends the index to the file after the data has been written
+   * @param stream the uncompressed stream of the cache file
+   */
+  bool Write(wxOutputStream &stream) const;
+};
+
+#endif /* GOCACHEINDEX_H */
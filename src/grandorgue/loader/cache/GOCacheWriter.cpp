@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -12,7 +12,7 @@
 #include "go_defs.h"
 
 GOCacheWriter::GOCacheWriter(wxOutputStream &stream, bool compressed)
-  : m_zstream(0), m_stream(&stream) {
+  : m_zstream(0), m_stream(&stream), m_pos(0) {
   if (compressed) {
     m_zstream = new wxZlibOutputStream(stream);
     m_stream = m_zstream;
@@ -30,6 +30,7 @@ bool GOCacheWriter::WriteHeader() {
 
 bool GOCacheWriter::Write(const void *data, unsigned length) {
   m_stream->Write(data, length);
+  m_pos += m_stream->LastWrite();
   if (m_stream->LastWrite() != length)
     return false;
   return true;
@@ -37,11 +38,24 @@ bool GOCacheWriter::Write(const void *data, unsigned length) {
 
 bool GOCacheWriter::WriteBlock(const void *data, unsigned length) {
   m_stream->Write(data, length);
+  m_pos += m_stream->LastWrite();
   if (m_stream->LastWrite() != length)
     return false;
   return true;
 }
 
+bool GOCacheWriter::Finish() {
+  bool isOk = true;
+
+  if (m_zstream) {
+    isOk = m_zstream->Close();
+    delete m_zstream;
+    m_zstream = 0;
+  }
+  m_stream = 0;
+  return isOk;
+}
+
 void GOCacheWriter::Close() {
   if (m_stream)
     m_stream->Close();
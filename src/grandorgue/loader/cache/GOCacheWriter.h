@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,11 +8,15 @@
 #ifndef GOCACHEWRITER_H_
 #define GOCACHEWRITER_H_
 
+#include <cstdint>
+
 class wxOutputStream;
 
 class GOCacheWriter {
   wxOutputStream *m_zstream;
   wxOutputStream *m_stream;
+  // the number of bytes written so far before compression
+  uint64_t m_pos;
 
 public:
   GOCacheWriter(wxOutputStream &stream, bool compressed);
@@ -22,7 +26,11 @@ public:
   bool Write(const void *data, unsigned length);
   /* Write an bigger malloced block */
   bool WriteBlock(const void *data, unsigned length);
+  /* The number of bytes written so far before compression */
+  uint64_t GetPos() const { return m_pos; }
 
+  /* Finish the compressed data keeping the underlying stream open */
+  bool Finish();
   void Close();
 };
 
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -39,10 +39,12 @@ bool GOMidiOutputMerger::Process(GOMidiEvent &e) {
       m_HWState.push_back(s);
     }
     GOMidiOutputMergerHWState &s = m_HWState[item];
+    const wxString str = e.GetString();
+
     for (unsigned i = e.GetValue(), j = 0;
-         i < s.content.length() && j < e.GetString().length();
+         i < s.content.length() && j < str.length();
          i++, j++)
-      s.content[i] = e.GetString()[j];
+      s.content[i] = str[j];
     e.SetString(s.content);
   }
   if (e.GetMidiType() == GOMidiEvent::MIDI_SYSEX_RODGERS_STOP_CHANGE) {
@@ -50,10 +52,8 @@ bool GOMidiOutputMerger::Process(GOMidiEvent &e) {
       m_RodgersState.resize(e.GetChannel() + 1);
     std::vector<uint8_t> &data = m_RodgersState[e.GetChannel()];
     unsigned offset = GORodgersSetBit(e.GetKey(), e.GetValue(), data);
-    std::vector<uint8_t> out(1);
-    out[0] = data[offset];
     e.SetKey(offset);
-    e.SetData(out);
+    e.SetData(&data[offset], 1);
   }
   return true;
 }
@@ -7,6 +7,8 @@
 
 #include "GOMidiPlayer.h"
 
+#include <algorithm>
+
 #include <wx/intl.h>
 
 #include "config/GOConfig.h"
@@ -14,6 +16,7 @@
 #include "midi/events/GOMidiEvent.h"
 #include "midi/files/GOMidiFileReader.h"
 #include "midi/objects/GOMidiObjectContext.h"
+#include "sound/GOSoundOrganEngine.h"
 
 #include "GOEvent.h"
 #include "GOMidiMap.h"
@@ -61,9 +64,12 @@ GOMidiPlayer::GOMidiPlayer(GOOrganController *organController)
   : r_MidiMap(organController->GetSettings().GetMidiMap()),
     r_timer(*organController->GetTimer()),
     p_midi(nullptr),
+    p_engine(nullptr),
     m_content(),
     m_PlayingTime(*organController, &MIDI_CONTEXT),
-    m_Start(0),
+    m_StartTime(0),
+    m_PauseTime(0),
+    m_LastEventTime(0),
     m_PlayingSeconds(0),
     m_Speed(1),
     m_IsPlaying(false),
@@ -136,11 +142,12 @@ bool GOMidiPlayer::IsLoaded() { return m_content.IsLoaded(); }
 void GOMidiPlayer::Play() {
   StopPlaying();
   m_content.Reset();
-  m_Start = wxGetLocalTimeMillis();
   m_PlayingSeconds = 0;
-  m_IsPlaying = IsLoaded();
+  m_IsPlaying = IsLoaded() && p_engine && p_engine->GetSampleRate();
   m_Pause = false;
   if (m_IsPlaying) {
+    m_StartTime = p_engine->GetTime();
+    m_LastEventTime = m_StartTime;
     m_buttons[ID_MIDI_PLAYER_PLAY]->Display(true);
     UpdateDisplay();
     HandleTimer();
@@ -152,14 +159,17 @@ void GOMidiPlayer::Pause() {
   if (!m_IsPlaying)
     return;
   if (m_Pause) {
+    const uint64_t pausedTime = p_engine->GetTime() - m_PauseTime;
+
     m_Pause = false;
     m_buttons[ID_MIDI_PLAYER_PAUSE]->Display(m_Pause);
-    m_Start = wxGetLocalTimeMillis() - m_Start;
+    m_StartTime += pausedTime;
+    m_LastEventTime += pausedTime;
     HandleTimer();
   } else {
     m_Pause = true;
     m_buttons[ID_MIDI_PLAYER_PAUSE]->Display(m_Pause);
-    m_Start = wxGetLocalTimeMillis() - m_Start;
+    m_PauseTime = p_engine->GetTime();
     r_timer.DeleteTimer(this);
   }
 }
@@ -206,33 +216,54 @@ void GOMidiPlayer::UpdateDisplay() {
       m_PlayingSeconds % 60));
 }
 
+uint64_t GOMidiPlayer::ToEngineTime(GOTime time) const {
+  return m_StartTime
+    + uint64_t(time.ToDouble() * m_Speed * p_engine->GetSampleRate() / 1000);
+}
+
 void GOMidiPlayer::HandleTimer() {
-  if (!m_IsPlaying)
+  if (!m_IsPlaying || m_Pause || !p_engine)
     return;
-  GOTime now = wxGetLocalTimeMillis();
-  if (m_Start + m_Speed * (m_PlayingSeconds + 1) * 1000 <= now) {
+
+  const unsigned sampleRate = p_engine->GetSampleRate();
+  const uint64_t now = p_engine->GetTime();
+  // the events up to here may be positioned exactly by the engine
+  const uint64_t horizon = now + p_engine->GetEventLatency();
+  const uint64_t nextSecond = ToEngineTime((m_PlayingSeconds + 1) * 1000);
+
+  if (nextSecond <= now) {
     m_PlayingSeconds++;
     UpdateDisplay();
   }
-  do {
+
+  uint64_t next = std::min(m_LastEventTime, nextSecond);
+
+  while (!m_content.IsAtEnd()) {
     GOMidiEvent e = m_content.GetCurrentEvent();
-    if (e.GetTime() * m_Speed + m_Start <= now) {
-      if (!m_content.Next()) {
-        StopPlaying();
-        return;
-      }
-      e.SetDevice(m_DeviceID);
-      e.SetTime(wxGetLocalTimeMillis());
-      e.SetAllowedToReload(false);
-      PlayMidiEvent(e);
-    } else {
-      GOTime next = e.GetTime() * m_Speed + m_Start;
-      if (next > m_Start + m_Speed * (m_PlayingSeconds + 1) * 1000)
-        next = m_Start + m_Speed * (m_PlayingSeconds + 1) * 1000;
-      r_timer.SetTimer(next, this);
-      return;
+    const uint64_t eventTime = ToEngineTime(e.GetTime());
+
+    if (eventTime > horizon) {
+      next = std::min(eventTime - (horizon - now), nextSecond);
+      break;
     }
-  } while (true);
+
+    e.SetDevice(m_DeviceID);
+    e.SetTime(wxGetLocalTimeMillis());
+    e.SetTimeNs(p_engine->GetEventTimeNs(std::max(eventTime, now)));
+    e.SetAllowedToReload(false);
+    PlayMidiEvent(e);
+    m_LastEventTime = std::max(m_LastEventTime, eventTime);
+    m_content.Next();
+  }
+  if (m_content.IsAtEnd() && m_LastEventTime <= now) {
+    StopPlaying();
+    return;
+  }
+  // the engine clock is not visible to the timer, so convert the remaining
+  // samples to ms. A late timer does not cause a drift: the next call
+  // positions the events by the engine clock again
+  r_timer.SetRelativeTimer(
+    next > now ? GOTime((next - now) * 1000 / sampleRate) : GOTime(1), this);
 }
 
 GOEnclosure *GOMidiPlayer::GetEnclosure(const wxString &name, bool is_panel) {
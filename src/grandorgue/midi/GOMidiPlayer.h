@@ -25,6 +25,7 @@ class GOMidiMap;
 class GOMidiEvent;
 class GOMidiFileReader;
 class GOOrganController;
+class GOSoundOrganEngine;
 class GOTimer;
 
 class GOMidiPlayer : public GOElementCreator, private GOTimerCallback {
@@ -32,9 +33,15 @@ private:
   GOMidiMap &r_MidiMap;
   GOTimer &r_timer;
   GOMidiSystem *p_midi;
+  GOSoundOrganEngine *p_engine;
   GOMidiPlayerContent m_content;
   GOLabelControl m_PlayingTime;
-  GOTime m_Start;
+  // the engine time in samples the file starts at
+  uint64_t m_StartTime;
+  // the engine time the playing has been paused at
+  uint64_t m_PauseTime;
+  // the engine time of the last event sent
+  uint64_t m_LastEventTime;
   unsigned m_PlayingSeconds;
   float m_Speed;
   bool m_IsPlaying;
@@ -54,6 +61,17 @@ private:
    * @param event the event to process
    */
   void PlayMidiEvent(const GOMidiEvent &e);
+  /**
+   * Converts the time of an event in the file to the engine time
+   * @param time the time of the event in ms from the start of the file
+   * @return the engine time in samples
+   */
+  uint64_t ToEngineTime(GOTime time) const;
+  /**
+   * Sends all events that are due until the engine positions events at.
+   * The events are timestamped with their exact engine time, so they start
+   * sample-accurately independent of the timer granularity
+   */
   void HandleTimer() override;
 
 public:
@@ -63,8 +81,12 @@ public:
   /**
    * Set up for playing any midi
    * @param pMidi - a pointer to the midi engine
+   * @param pEngine - a pointer to the sound engine. Its clock drives playing
    */
-  void Setup(GOMidiSystem *pMidi) { p_midi = pMidi; }
+  void Setup(GOMidiSystem *pMidi, GOSoundOrganEngine *pEngine) {
+    p_midi = pMidi;
+    p_engine = pEngine;
+  }
 
   void LoadFile(const wxString &filename, unsigned manuals, bool pedal);
   bool IsLoaded();
@@ -7,6 +7,8 @@
 
 #include "GOMidiPlayerContent.h"
 
+#include <algorithm>
+
 #include "midi/events/GOMidiEvent.h"
 #include "midi/files/GOMidiFileReader.h"
 
@@ -28,21 +30,17 @@ bool GOMidiPlayerContent::IsLoaded() { return m_Events.size() > 0; }
 
 void GOMidiPlayerContent::ReadFileContent(
   GOMidiFileReader &reader, std::vector<GOMidiEvent> &events) {
-  unsigned pos = 0;
   GOMidiEvent e;
-  while (reader.ReadEvent(e)) {
-    while (pos > 0 && events[pos - 1].GetTime() > e.GetTime()) {
-      pos--;
-    }
-    while (pos < events.size() && events[pos].GetTime() < e.GetTime()) {
-      pos++;
-    }
-    if (pos <= events.size())
-      events.insert(events.begin() + pos, e);
-    else
-      events.push_back(e);
-    pos++;
-  }
+
+  while (reader.ReadEvent(e))
+    events.push_back(e);
+  // the tracks are read one after another, so merge them by time
+  std::stable_sort(
+    events.begin(),
+    events.end(),
+    [](const GOMidiEvent &a, const GOMidiEvent &b) {
+      return a.GetTime() < b.GetTime();
+    });
 }
 
 void GOMidiPlayerContent::SetupManual(
@@ -85,6 +83,7 @@ bool GOMidiPlayerContent::Load(
     if (pedal)
       SetupManual(map, manuals + 1, wxString::Format(wxT("M%d"), 0));
   }
+  m_Events.reserve(m_Events.size() + events.size());
   for (unsigned i = 0; i < events.size(); i++)
     if (merger.Process(events[i]))
       m_Events.push_back(events[i]);
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -16,11 +16,20 @@ class GOMidiEvent;
 class GOMidiMap;
 class GOMidiFileReader;
 
+/**
+ * The content of a midi file decoded completely at load. The events of all
+ * tracks are merged into a single array sorted by time, so the playback only
+ * walks the array
+ */
 class GOMidiPlayerContent {
 private:
   std::vector<GOMidiEvent> m_Events;
   unsigned m_Pos;
 
+  /**
+   * Decodes all events of the file and sorts them by time. The events with
+   * the same time keep the order of the file
+   */
   void ReadFileContent(
     GOMidiFileReader &reader, std::vector<GOMidiEvent> &events);
   void SetupManual(GOMidiMap &map, unsigned channel, wxString ID);
@@ -35,6 +44,7 @@ public:
   bool Load(
     GOMidiFileReader &reader, GOMidiMap &map, unsigned manuals, bool pedal);
 
+  bool IsAtEnd() const { return m_Pos >= m_Events.size(); }
   const GOMidiEvent &GetCurrentEvent();
   bool Next();
 };
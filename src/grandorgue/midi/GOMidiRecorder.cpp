@@ -7,6 +7,9 @@
 
 #include "GOMidiRecorder.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 #include <wx/filename.h>
 #include <wx/intl.h>
 #include <wx/log.h>
@@ -15,8 +18,8 @@
 #include "config/GOConfig.h"
 #include "control/GOCallbackButtonControl.h"
 #include "midi/events/GOMidiEvent.h"
-#include "midi/files/GOMidiFile.h"
 #include "midi/objects/GOMidiObjectContext.h"
+#include "threading/GOMutexLocker.h"
 
 #include "GOEvent.h"
 #include "GOMidiSystem.h"
@@ -64,12 +67,12 @@ GOMidiRecorder::GOMidiRecorder(GOOrganController *organController)
     m_Mappings(),
     m_Preconfig(),
     m_OutputDevice(0),
-    m_file(),
     m_Filename(),
     m_DoRename(false),
-    m_BufferPos(0),
-    m_FileLength(0),
-    m_Last(0) {
+    m_StartTime(0),
+    m_AudioOriginSamples(0),
+    m_AudioOriginMs(0),
+    m_LastTimeMs(0) {
   CreateButtons(*m_OrganController, BUTTON_DEFS);
   Clear();
   UpdateDisplay();
@@ -240,43 +243,30 @@ void GOMidiRecorder::SendMidiRecorderMessage(GOMidiEvent &e) {
   SendEvent(e);
 }
 
-void GOMidiRecorder::Flush() {
-  if (!m_BufferPos)
-    return;
-  m_file.Write(m_Buffer, m_BufferPos);
-  m_FileLength += m_BufferPos;
-  m_BufferPos = 0;
-}
-
-void GOMidiRecorder::Ensure(unsigned length) {
-  if (m_BufferPos + length < sizeof(m_Buffer))
-    return;
-  Flush();
-}
-
-void GOMidiRecorder::Write(const void *data, unsigned len) {
-  if (len >= sizeof(m_Buffer)) {
-    Flush();
-    m_file.Write(data, len);
-    m_FileLength += len;
-    return;
-  }
-  Ensure(len);
-  memcpy(m_Buffer + m_BufferPos, data, len);
-  m_BufferPos += len;
-}
-
-void GOMidiRecorder::EncodeLength(unsigned len) {
-  char buf[16];
-  unsigned l = sizeof(buf) - 1;
-  buf[l] = len & 0x7F;
-  len = len >> 7;
-  while (len) {
-    l--;
-    buf[l] = 0x80 | (len & 0x7F);
-    len = len >> 7;
+// how far the audio clock may deviate from the wall clock before re-syncing
+static constexpr int64_t MAX_CLOCK_DEVIATION_MS = 1000;
+
+int64_t GOMidiRecorder::GetEventTimeMs() {
+  const int64_t wallMs = (wxGetLocalTimeMillis() - m_StartTime).GetValue();
+  const uint64_t eventTime = m_OrganController->GetEventTime();
+  int64_t timeMs = wallMs;
+
+  if (eventTime) {
+    const unsigned sampleRate = m_OrganController->GetSampleRate();
+
+    if (m_AudioOriginSamples && eventTime >= m_AudioOriginSamples)
+      timeMs = m_AudioOriginMs
+        + int64_t(eventTime - m_AudioOriginSamples) * 1000 / sampleRate;
+    // the sound engine has been started or restarted
+    if (
+      !m_AudioOriginSamples || eventTime < m_AudioOriginSamples
+      || std::abs(timeMs - wallMs) > MAX_CLOCK_DEVIATION_MS) {
+      m_AudioOriginSamples = eventTime;
+      m_AudioOriginMs = wallMs;
+      timeMs = wallMs;
+    }
   }
-  Write(buf + l, sizeof(buf) - l);
+  return std::max(timeMs, m_LastTimeMs);
 }
 
 void GOMidiRecorder::WriteEvent(GOMidiEvent &e) {
@@ -284,19 +274,20 @@ void GOMidiRecorder::WriteEvent(GOMidiEvent &e) {
     return;
   std::vector<std::vector<unsigned char>> msg;
   e.ToMidi(msg, m_Map);
-  for (unsigned i = 0; i < msg.size(); i++) {
-    EncodeLength((e.GetTime() - m_Last).GetValue());
-    if (msg[i][0] == 0xF0) {
-      Write(&msg[i][0], 1);
-      EncodeLength(msg[i].size() - 1);
-      Write(&msg[i][1], msg[i].size() - 1);
-    } else
-      Write(&msg[i][0], msg[i].size());
-    m_Last = e.GetTime();
-  }
+
+  GOMutexLocker locker(m_WriteLock);
+
+  if (!m_writer.IsOpen())
+    return;
+
+  const int64_t timeMs = GetEventTimeMs();
+
+  for (unsigned i = 0; i < msg.size(); i++)
+    m_writer.WriteEvent(i ? 0 : unsigned(timeMs - m_LastTimeMs), msg[i]);
+  m_LastTimeMs = timeMs;
 }
 
-bool GOMidiRecorder::IsRecording() { return m_file.IsOpened(); }
+bool GOMidiRecorder::IsRecording() { return m_writer.IsOpen(); }
 
 void GOMidiRecorder::UpdateDisplay() {
   if (!IsRecording())
@@ -315,15 +306,11 @@ void GOMidiRecorder::StopRecording() {
   m_OrganController->GetTimer()->DeleteTimer(this);
   if (!IsRecording())
     return;
-  const unsigned char end[4] = {0x01, 0xFF, 0x2F, 0x00};
-  Write(end, sizeof(end));
-  Flush();
-  m_FileLength -= sizeof(MIDIHeaderChunk) + sizeof(MIDIFileHeader);
-  MIDIFileHeader h = {{'M', 'T', 'r', 'k'}, m_FileLength};
-  m_file.Seek(sizeof(MIDIHeaderChunk));
-  m_file.Write(&h, sizeof(h));
-  m_file.Flush();
-  m_file.Close();
+  {
+    GOMutexLocker locker(m_WriteLock);
+
+    m_writer.Close();
+  }
   if (!m_DoRename) {
     wxFileName name = m_Filename;
     go_sync_directory(name.GetPath());
@@ -336,9 +323,6 @@ void GOMidiRecorder::StopRecording() {
 }
 
 void GOMidiRecorder::StartRecording(bool rename) {
-  MIDIHeaderChunk h = {{{'M', 'T', 'h', 'd'}, 6}, 0, 1, 0xE728};
-  MIDIFileHeader t = {{'M', 'T', 'r', 'k'}, 0};
-
   StopRecording();
   if (!m_OrganController)
     return;
@@ -348,26 +332,18 @@ void GOMidiRecorder::StartRecording(bool rename) {
     + wxDateTime::UNow().Format(_("%Y-%m-%d-%H-%M-%S.%l.mid"));
   m_DoRename = rename;
 
-  m_file.Create(m_Filename, true);
-  if (!m_file.IsOpened()) {
-    wxLogError(_("Unable to open file %s for writing"), m_Filename.c_str());
-    return;
-  }
+  {
+    GOMutexLocker locker(m_WriteLock);
 
-  m_FileLength = 0;
-  m_BufferPos = 0;
-  Write(&h, sizeof(h));
-  Write(&t, sizeof(t));
-
-  wxString s = m_OrganController->GetOrganName();
-  wxCharBuffer b = s.ToAscii();
-  unsigned len = s.length();
-  unsigned char th[] = {0x00, 0xFF, 0x04};
-  Write(&th, sizeof(th));
-  EncodeLength(len);
-  Write(b.data(), len);
-
-  m_Last = wxGetLocalTimeMillis();
+    if (!m_writer.Open(m_Filename, m_OrganController->GetOrganName())) {
+      wxLogError(_("Unable to open file %s for writing"), m_Filename.c_str());
+      return;
+    }
+    m_StartTime = wxGetLocalTimeMillis();
+    m_AudioOriginSamples = 0;
+    m_AudioOriginMs = 0;
+    m_LastTimeMs = 0;
+  }
   if (m_DoRename)
     m_buttons[ID_MIDI_RECORDER_RECORD_RENAME]->Display(true);
   else
@@ -394,6 +370,12 @@ GOLabelControl *GOMidiRecorder::GetLabelControl(
 }
 
 void GOMidiRecorder::HandleTimer() {
+  {
+    GOMutexLocker locker(m_WriteLock);
+
+    // let the writer thread save the events of the last second
+    m_writer.Commit();
+  }
   m_RecordSeconds++;
   UpdateDisplay();
 }
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,13 +8,15 @@
 #ifndef GOMIDIRECORDER_H
 #define GOMIDIRECORDER_H
 
-#include <wx/file.h>
 #include <wx/string.h>
 
+#include <cstdint>
 #include <vector>
 
 #include "control/GOElementCreator.h"
 #include "control/GOLabelControl.h"
+#include "midi/files/GOMidiFileWriter.h"
+#include "threading/GOMutex.h"
 
 #include "GOTime.h"
 #include "GOTimerCallback.h"
@@ -41,23 +43,33 @@ private:
   std::vector<midi_map> m_Mappings;
   std::vector<midi_map> m_Preconfig;
   unsigned m_OutputDevice;
-  wxFile m_file;
   wxString m_Filename;
   bool m_DoRename;
-  char m_Buffer[2000];
-  unsigned m_BufferPos;
-  unsigned m_FileLength;
-  GOTime m_Last;
+  GOMidiFileWriter m_writer;
+  // serializes the writing of the events from the midi and the main threads
+  GOMutex m_WriteLock;
+  // the wall clock time of starting the recording
+  GOTime m_StartTime;
+  // the audio clock time in samples corresponding to m_AudioOriginMs.
+  // 0 - not known yet
+  uint64_t m_AudioOriginSamples;
+  // the recording time in ms corresponding to m_AudioOriginSamples
+  int64_t m_AudioOriginMs;
+  // the recording time of the last written event in ms
+  int64_t m_LastTimeMs;
 
   void ButtonStateChanged(int id, bool newState) override;
 
   void UpdateDisplay();
   void HandleTimer() override;
 
-  void Ensure(unsigned length);
-  void Flush();
-  void EncodeLength(unsigned len);
-  void Write(const void *data, unsigned len);
+  /**
+   * Returns the recording time of the event being processed in ms. It is
+   * taken from the audio clock when the sound engine is running, so the events
+   * are recorded at the times they sound. Otherwise the wall clock is used.
+   * Must be called with m_WriteLock locked
+   */
+  int64_t GetEventTimeMs();
   void WriteEvent(GOMidiEvent &e);
   void SendEvent(GOMidiEvent &e);
   bool SetupMapping(unsigned element, bool isNRPN);
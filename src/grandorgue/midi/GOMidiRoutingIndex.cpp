@@ -0,0 +1,42 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOMidiRoutingIndex.h"
+
+#include <algorithm>
+
+#include "midi/elements/GOMidiReceiver.h"
+
+#include "GOEventHandler.h"
+
+void GOMidiRoutingIndex::Update(
+  const std::vector<GOEventHandler *> &handlers, unsigned handlersVersion) {
+  const unsigned patternsVersion = GOMidiReceiver::getPatternsVersion();
+
+  if (
+    m_IsValid && handlersVersion == m_HandlersVersion
+    && patternsVersion == m_PatternsVersion)
+    return;
+
+  std::vector<uint32_t> routes;
+
+  m_routes.clear();
+  m_AnyEventHandlers.clear();
+  for (unsigned i = 0; i < handlers.size(); i++) {
+    routes.clear();
+    if (handlers[i]->GetMidiRoutes(routes)) {
+      std::sort(routes.begin(), routes.end());
+      routes.erase(std::unique(routes.begin(), routes.end()), routes.end());
+      for (uint32_t route : routes)
+        m_routes[route].push_back(i);
+    } else
+      m_AnyEventHandlers.push_back(i);
+  }
+  m_HandlersVersion = handlersVersion;
+  m_PatternsVersion = patternsVersion;
+  m_IsValid = true;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOMIDIROUTINGINDEX_H
+#define GOMIDIROUTINGINDEX_H
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "midi/events/GOMidiEvent.h"
+
+class GOEventHandler;
+
+/**
+ * An index of the midi event handlers by the routes of the events they may
+ * react on. A route consists of the event type, the channel and the key (the
+ * controller number). The channel and the key may be ANY.
+ * Allows to pass an event only to the handlers that may match it instead of
+ * all handlers of the organ.
+ */
+
+class GOMidiRoutingIndex {
+public:
+  static constexpr int ANY = -1;
+
+  static uint32_t makeRoute(GOMidiEvent::MidiType type, int channel, int key) {
+    return ((uint32_t)type << 24) | (((uint32_t)channel & 0xFF) << 16)
+      | ((uint32_t)key & 0xFFFF);
+  }
+
+  /**
+   * Whether the events of this type must be passed to all handlers. Such
+   * events change the internal matching state of the receivers
+   */
+  static bool isBroadcast(GOMidiEvent::MidiType type) {
+    return type == GOMidiEvent::MIDI_SYSEX_GO_CLEAR
+      || type == GOMidiEvent::MIDI_SYSEX_GO_SETUP
+      || type == GOMidiEvent::MIDI_SYSEX_GO_SAMPLESET;
+  }
+
+private:
+  // the indices of the handlers in the ascending order
+  using HandlerIndices = std::vector<unsigned>;
+
+  std::unordered_map<uint32_t, HandlerIndices> m_routes;
+  // the handlers that may react on any event
+  HandlerIndices m_AnyEventHandlers;
+  bool m_IsValid;
+  unsigned m_HandlersVersion;
+  unsigned m_PatternsVersion;
+
+  const HandlerIndices *FindRoute(uint32_t route) const {
+    auto it = m_routes.find(route);
+
+    return it != m_routes.end() ? &it->second : nullptr;
+  }
+
+public:
+  GOMidiRoutingIndex()
+    : m_IsValid(false), m_HandlersVersion(0), m_PatternsVersion(0) {}
+
+  void Invalidate() { m_IsValid = false; }
+
+  /**
+   * Rebuilds the index if the handlers or their midi settings have been
+   * changed since the last build
+   * @param handlers all handlers of the organ
+   * @param handlersVersion is changed when a handler is added or removed
+   */
+  void Update(
+    const std::vector<GOEventHandler *> &handlers, unsigned handlersVersion);
+
+  /**
+   * Calls f for each handler that may react on the event. The handlers are
+   * visited in the same order as they are in the vector passed to Update()
+   * @param e the event
+   * @param f the function accepting the handler index
+   */
+  template <typename F> void ForEachHandler(const GOMidiEvent &e, F f) const {
+    const GOMidiEvent::MidiType type = e.GetMidiType();
+    const HandlerIndices *lists[] = {
+      &m_AnyEventHandlers,
+      FindRoute(makeRoute(type, e.GetChannel(), e.GetKey())),
+      FindRoute(makeRoute(type, e.GetChannel(), ANY)),
+      FindRoute(makeRoute(type, ANY, e.GetKey())),
+      FindRoute(makeRoute(type, ANY, ANY))};
+    constexpr unsigned N_LISTS = sizeof(lists) / sizeof(lists[0]);
+    unsigned positions[N_LISTS] = {};
+
+    // merge the sorted lists. Some of them may be the same list
+    for (;;) {
+      unsigned minIndex = UINT_MAX;
+
+      for (unsigned i = 0; i < N_LISTS; i++)
+        if (lists[i] && positions[i] < lists[i]->size())
+          minIndex = std::min(minIndex, (*lists[i])[positions[i]]);
+      if (minIndex == UINT_MAX)
+        break;
+      for (unsigned i = 0; i < N_LISTS; i++)
+        if (
+          lists[i] && positions[i] < lists[i]->size()
+          && (*lists[i])[positions[i]] == minIndex)
+          positions[i]++;
+      f(minIndex);
+    }
+  }
+};
+
+#endif /* GOMIDIROUTINGINDEX_H */
@@ -7,11 +7,15 @@
 
 #include "GOMidiSystem.h"
 
+#include <chrono>
+#include <thread>
+
 #include "GOEvent.h"
 #include "GOMidiListener.h"
 #include "config/GOConfig.h"
 #include "config/GOMidiDeviceConfig.h"
 #include "midi/events/GOMidiWxEvent.h"
+#include "threading/GOMutexLocker.h"
 #include "ports/GOMidiInPort.h"
 #include "ports/GOMidiOutPort.h"
 
@@ -20,18 +24,58 @@ EVT_MIDI(GOMidiSystem::OnMidiEvent)
 END_EVENT_TABLE()
 
 GOMidiSystem::GOMidiSystem(GOConfig &config)
-  : m_config(config), m_MidiMap(config.GetMidiMap()) {}
+  : m_config(config),
+    m_MidiMap(config.GetMidiMap()),
+    m_NOutQueuedEvents(0),
+    m_SendingThread(*this) {
+  m_SendingThread.Start();
+}
 
 void GOMidiSystem::UpdateDevices(const GOPortsConfig &portsConfig) {
   m_MidiFactory.addMissingInDevices(this, portsConfig, m_midi_in_devices);
-  m_MidiFactory.addMissingOutDevices(this, portsConfig, m_midi_out_devices);
+  {
+    GOMutexLocker locker(m_OutDevicesLock);
+
+    m_MidiFactory.addMissingOutDevices(this, portsConfig, m_midi_out_devices);
+  }
 }
 
 GOMidiSystem::~GOMidiSystem() {
+  m_SendingThread.MarkForStop();
+  OnOutEventQueued();
+  m_SendingThread.Wait();
   m_midi_in_devices.clear();
   m_midi_out_devices.clear();
 }
 
+void GOMidiSystem::OnOutEventQueued() {
+  m_NOutQueuedEvents.fetch_add(1);
+  m_NOutQueuedEvents.notify_one();
+}
+
+// how long to wait when the rate limit of some port is reached
+static constexpr std::chrono::milliseconds RATE_LIMIT_WAIT(5);
+
+void GOMidiSystem::SendQueuedEvents(GOThread *pThread) {
+  while (!pThread->ShouldStop()) {
+    // load the counter before sending, so no wakeup is lost
+    const unsigned nQueuedEvents = m_NOutQueuedEvents.load();
+    bool isRateLimited = false;
+
+    {
+      GOMutexLocker locker(m_OutDevicesLock);
+
+      for (GOMidiPort *pPort : m_midi_out_devices)
+        if (((GOMidiOutPort *)pPort)->SendQueued())
+          isRateLimited = true;
+    }
+    if (isRateLimited)
+      std::this_thread::sleep_for(RATE_LIMIT_WAIT);
+    else
+      m_NOutQueuedEvents.wait(nQueuedEvents);
+  }
+}
+
 void GOMidiSystem::Open() {
   const bool isToAutoAdd = m_config.IsToAutoAddMidi();
   const GOPortsConfig &portsConfig(m_config.GetMidiPortsConfig());
@@ -66,6 +110,8 @@ void GOMidiSystem::Open() {
       pPort->Close();
   }
 
+  GOMutexLocker outLocker(m_OutDevicesLock);
+
   for (GOMidiPort *pPort : m_midi_out_devices) {
     const wxString &portName = pPort->GetPortName();
     const wxString &apiName = pPort->GetApiName();
@@ -74,9 +120,10 @@ void GOMidiSystem::Open() {
     if (
       pPort->IsToUse() && portsConfig.IsEnabled(portName, apiName)
       && (devConf = m_config.m_MidiOut.FindByPhysicalName(pPort->GetName(), portName, apiName))
-      && devConf->m_IsEnabled)
+      && devConf->m_IsEnabled) {
+      ((GOMidiOutPort *)pPort)->SetRateLimited(devConf->m_IsRateLimited);
       pPort->Open(m_MidiMap.EnsureLogicalName(devConf->GetLogicalName()));
-    else
+    } else
       pPort->Close();
   }
 }
@@ -8,11 +8,15 @@
 #ifndef GOMIDISYSTEM_H
 #define GOMIDISYSTEM_H
 
+#include <atomic>
+
 #include <wx/event.h>
 
 #include "config/GOPortsConfig.h"
 #include "ports/GOMidiPortFactory.h"
 #include "ptrvector.h"
+#include "threading/GOMutex.h"
+#include "threading/GOThread.h"
 
 class GOMidiEvent;
 class GOMidiPort;
@@ -24,11 +28,24 @@ class GOMidiWxEvent;
 
 /**
  * This class represents a GrandOrgue-wide MIDI system. It may be used even
- * without any organ is loaded and without the Sound System is open
+ * without any organ is loaded and without the Sound System is open.
+ *
+ * The events being sent are queued by the output ports and then are sent by
+ * a separate midi sending thread.
  */
 
 class GOMidiSystem : public wxEvtHandler {
 private:
+  class SendingThread : public GOThread {
+  private:
+    GOMidiSystem &r_midi;
+
+    void Entry() override { r_midi.SendQueuedEvents(this); }
+
+  public:
+    SendingThread(GOMidiSystem &midi) : r_midi(midi) {}
+  };
+
   GOConfig &m_config;
   GOMidiMap &m_MidiMap;
 
@@ -39,6 +56,14 @@ private:
   std::vector<GOMidiListener *> m_Listeners;
   GOMidiPortFactory m_MidiFactory;
 
+  // protects m_midi_out_devices from being changed while sending
+  GOMutex m_OutDevicesLock;
+  // the number of events queued for sending since start
+  std::atomic_uint m_NOutQueuedEvents;
+  SendingThread m_SendingThread;
+
+  void SendQueuedEvents(GOThread *pThread);
+
 public:
   GOMidiSystem(GOConfig &settings);
   ~GOMidiSystem();
@@ -46,6 +71,12 @@ public:
   void Open();
   void UpdateDevices(const GOPortsConfig &portsConfig);
 
+  /**
+   * Wakes the midi sending thread up. Is called by an output port after it
+   * has queued an event
+   */
+  void OnOutEventQueued();
+  // passes the event to the main thread
   void Recv(const GOMidiEvent &e);
   void PlayEvent(const GOMidiEvent &e);
   void OnMidiEvent(GOMidiWxEvent &e);
@@ -1,16 +1,19 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
 
 #include "GOMidiReceiver.h"
 
+#include <atomic>
+
 #include "config/GOConfig.h"
 #include "config/GOConfigReader.h"
 #include "config/GOConfigWriter.h"
 #include "midi/GOMidiMap.h"
+#include "midi/GOMidiRoutingIndex.h"
 #include "midi/events/GOMidiEvent.h"
 #include "midi/events/GORodgers.h"
 #include "yaml/go-wx-yaml.h"
@@ -192,6 +195,7 @@ void GOMidiReceiver::Load(
             127));
     }
   }
+  OnEventsChanged();
 }
 
 void GOMidiReceiver::Save(
@@ -372,6 +376,7 @@ void GOMidiReceiver::FromYaml(
       }
     }
   }
+  OnEventsChanged();
 }
 
 bool GOMidiReceiver::hasChannel(GOMidiReceiverMessageType type) {
@@ -587,6 +592,476 @@ unsigned GOMidiReceiver::createInternal(unsigned device) {
   return pos;
 }
 
+static std::atomic_uint patterns_version(0);
+
+void GOMidiReceiver::OnEventsChanged() {
+  patterns_version++;
+  CompilePatterns();
+}
+
+unsigned GOMidiReceiver::getPatternsVersion() { return patterns_version; }
+
+static constexpr uint32_t event_type_bit(GOMidiEvent::MidiType type) {
+  return 1u << type;
+}
+
+/**
+ * Returns the event types a pattern may match
+ * @param receiverType the receiver type the patterns are matched for
+ * @param type the pattern message type
+ * @return a bit for each GOMidiEvent::MidiType. 0 - the pattern never matches
+ */
+static uint32_t matching_event_types(
+  GOMidiReceiverType receiverType, GOMidiReceiverMessageType type) {
+  if (receiverType == MIDI_RECV_MANUAL)
+    return type == MIDI_M_NOTE || type == MIDI_M_NOTE_NO_VELOCITY
+        || type == MIDI_M_NOTE_SHORT_OCTAVE || type == MIDI_M_NOTE_NORMAL
+      ? event_type_bit(GOMidiEvent::MIDI_NOTE)
+        | event_type_bit(GOMidiEvent::MIDI_AFTERTOUCH)
+        | event_type_bit(GOMidiEvent::MIDI_CTRL_CHANGE)
+      : 0;
+  if (receiverType == MIDI_RECV_ENCLOSURE)
+    switch (type) {
+    case MIDI_M_CTRL_CHANGE:
+      return event_type_bit(GOMidiEvent::MIDI_CTRL_CHANGE);
+    case MIDI_M_RPN:
+      return event_type_bit(GOMidiEvent::MIDI_RPN);
+    case MIDI_M_NRPN:
+      return event_type_bit(GOMidiEvent::MIDI_NRPN);
+    case MIDI_M_PGM_RANGE:
+      return event_type_bit(GOMidiEvent::MIDI_PGM_CHANGE);
+    default:
+      return 0;
+    }
+  switch (type) {
+  case MIDI_M_NOTE:
+  case MIDI_M_NOTE_ON:
+  case MIDI_M_NOTE_OFF:
+  case MIDI_M_NOTE_ON_OFF:
+  case MIDI_M_NOTE_FIXED_ON:
+  case MIDI_M_NOTE_FIXED_OFF:
+    return event_type_bit(GOMidiEvent::MIDI_NOTE);
+
+  case MIDI_M_CTRL_CHANGE:
+  case MIDI_M_CTRL_CHANGE_ON:
+  case MIDI_M_CTRL_CHANGE_OFF:
+  case MIDI_M_CTRL_CHANGE_ON_OFF:
+  case MIDI_M_CTRL_CHANGE_FIXED:
+  case MIDI_M_CTRL_CHANGE_FIXED_ON:
+  case MIDI_M_CTRL_CHANGE_FIXED_OFF:
+  case MIDI_M_CTRL_CHANGE_FIXED_ON_OFF:
+  case MIDI_M_CTRL_BIT:
+    return event_type_bit(GOMidiEvent::MIDI_CTRL_CHANGE);
+
+  case MIDI_M_RPN:
+  case MIDI_M_RPN_ON:
+  case MIDI_M_RPN_OFF:
+  case MIDI_M_RPN_ON_OFF:
+  case MIDI_M_RPN_RANGE:
+    return event_type_bit(GOMidiEvent::MIDI_RPN);
+
+  case MIDI_M_NRPN:
+  case MIDI_M_NRPN_ON:
+  case MIDI_M_NRPN_OFF:
+  case MIDI_M_NRPN_ON_OFF:
+  case MIDI_M_NRPN_RANGE:
+    return event_type_bit(GOMidiEvent::MIDI_NRPN);
+
+  case MIDI_M_PGM_CHANGE:
+  case MIDI_M_PGM_RANGE:
+    return event_type_bit(GOMidiEvent::MIDI_PGM_CHANGE);
+
+  case MIDI_M_SYSEX_JOHANNUS_9:
+    return event_type_bit(GOMidiEvent::MIDI_SYSEX_JOHANNUS_9);
+
+  case MIDI_M_SYSEX_JOHANNUS_11:
+    return event_type_bit(GOMidiEvent::MIDI_SYSEX_JOHANNUS_11);
+
+  case MIDI_M_SYSEX_VISCOUNT:
+  case MIDI_M_SYSEX_VISCOUNT_TOGGLE:
+    return event_type_bit(GOMidiEvent::MIDI_SYSEX_VISCOUNT);
+
+  case MIDI_M_SYSEX_RODGERS_STOP_CHANGE:
+    return event_type_bit(GOMidiEvent::MIDI_SYSEX_RODGERS_STOP_CHANGE);
+
+  case MIDI_M_SYSEX_AHLBORN_GALANTI:
+  case MIDI_M_SYSEX_AHLBORN_GALANTI_TOGGLE:
+    return event_type_bit(GOMidiEvent::MIDI_SYSEX_AHLBORN_GALANTI);
+
+  default:
+    // never match for non-manual receivers
+    return 0;
+  }
+}
+
+/**
+ * Matches the value with the on/off range of MIDI_M_NOTE, MIDI_M_CTRL_CHANGE,
+ * MIDI_M_RPN and MIDI_M_NRPN patterns
+ */
+static GOMidiMatchType match_on_off_range(
+  const GOMidiReceiverEventPattern &pattern, int value) {
+  if (pattern.low_value <= pattern.high_value) {
+    if (value <= pattern.low_value)
+      return MIDI_MATCH_OFF;
+    if (value >= pattern.high_value)
+      return MIDI_MATCH_ON;
+  } else {
+    if (value >= pattern.low_value)
+      return MIDI_MATCH_OFF;
+    if (value <= pattern.high_value)
+      return MIDI_MATCH_ON;
+  }
+  return MIDI_MATCH_NONE;
+}
+
+template <GOMidiReceiverType R, GOMidiReceiverMessageType M>
+bool GOMidiReceiver::matchPattern(
+  GOMidiReceiver &receiver,
+  unsigned index,
+  const GOMidiEvent &e,
+  const KeyMap *pMidiMap,
+  int transpose,
+  int &key,
+  int &value,
+  GOMidiMatchType &result) {
+  const GOMidiReceiverEventPattern &pattern = receiver.m_events[index];
+  const GOMidiEvent::MidiType eMidiType = e.GetMidiType();
+  const int eKey = e.GetKey();
+  const int eValue = e.GetValue();
+  auto matched = [&result](GOMidiMatchType match) {
+    result = match;
+    return match != MIDI_MATCH_NONE;
+  };
+  // the matching is complete even if the event is suppressed by debouncing
+  auto debounced = [&](GOMidiMatchType match) {
+    result = receiver.debounce(e, match, index);
+    return true;
+  };
+
+  if constexpr (R == MIDI_RECV_MANUAL) {
+    if (eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE)
+      return (eKey == MIDI_CTRL_NOTES_OFF || eKey == MIDI_CTRL_SOUNDS_OFF)
+        && matched(MIDI_MATCH_RESET);
+    if (eKey < pattern.low_key || eKey > pattern.high_key)
+      return false;
+    key = eKey;
+    if constexpr (M == MIDI_M_NOTE_SHORT_OCTAVE) {
+      const int no = eKey - pattern.low_key;
+
+      if (no <= 3)
+        return false;
+      if (no == 4 || no == 6 || no == 8)
+        key -= 4;
+    }
+    key = key + transpose + pattern.key;
+    if (key < 0 || key > 127)
+      return false;
+    if constexpr (M != MIDI_M_NOTE_SHORT_OCTAVE && M != MIDI_M_NOTE_NORMAL)
+      if (pMidiMap)
+        key = (*pMidiMap)[key];
+    if constexpr (M == MIDI_M_NOTE_NO_VELOCITY) {
+      value = eValue ? 127 : 0;
+      if (eMidiType == GOMidiEvent::MIDI_AFTERTOUCH)
+        return false;
+    } else
+      value = pattern.ConvertSrcValueToInt(eValue);
+    if (pattern.low_value <= pattern.high_value) {
+      if (eValue < pattern.low_value)
+        return matched(MIDI_MATCH_OFF);
+      if (eValue <= pattern.high_value)
+        return matched(MIDI_MATCH_ON);
+    } else {
+      if (eValue >= pattern.low_value)
+        return matched(MIDI_MATCH_OFF);
+      if (eValue >= pattern.high_value)
+        return matched(MIDI_MATCH_ON);
+    }
+    return false;
+  } else if constexpr (R == MIDI_RECV_ENCLOSURE) {
+    if constexpr (M == MIDI_M_PGM_RANGE) {
+      if (
+        !(pattern.low_value <= eKey && eKey <= pattern.high_value)
+        && !(pattern.high_value <= eKey && eKey <= pattern.low_value))
+        return false;
+    } else if (pattern.key != eKey)
+      return false;
+    value = pattern.ConvertSrcValueToInt(eValue);
+    return matched(MIDI_MATCH_CHANGE);
+  } else if constexpr (
+    M == MIDI_M_NOTE || M == MIDI_M_RPN || M == MIDI_M_NRPN)
+    return pattern.key == eKey
+      && matched(match_on_off_range(pattern, eValue));
+  else if constexpr (M == MIDI_M_CTRL_CHANGE) {
+    const GOMidiMatchType match = pattern.key == eKey
+      ? match_on_off_range(pattern, eValue)
+      : MIDI_MATCH_NONE;
+
+    return match != MIDI_MATCH_NONE && debounced(match);
+  } else if constexpr (
+    M == MIDI_M_NOTE_ON || M == MIDI_M_CTRL_CHANGE_ON || M == MIDI_M_RPN_ON
+    || M == MIDI_M_NRPN_ON)
+    return pattern.key == eKey && eValue >= pattern.high_value
+      && debounced(MIDI_MATCH_CHANGE);
+  else if constexpr (
+    M == MIDI_M_NOTE_OFF || M == MIDI_M_CTRL_CHANGE_OFF || M == MIDI_M_RPN_OFF
+    || M == MIDI_M_NRPN_OFF)
+    return pattern.key == eKey && eValue <= pattern.low_value
+      && debounced(MIDI_MATCH_CHANGE);
+  else if constexpr (
+    M == MIDI_M_NOTE_ON_OFF || M == MIDI_M_CTRL_CHANGE_ON_OFF
+    || M == MIDI_M_RPN_ON_OFF || M == MIDI_M_NRPN_ON_OFF)
+    return pattern.key == eKey
+      && (eValue >= pattern.high_value || eValue <= pattern.low_value)
+      && debounced(MIDI_MATCH_CHANGE);
+  else if constexpr (M == MIDI_M_CTRL_CHANGE_FIXED) {
+    if (pattern.key != eKey)
+      return false;
+    if (eValue == pattern.low_value)
+      return debounced(MIDI_MATCH_OFF);
+    if (eValue == pattern.high_value)
+      return debounced(MIDI_MATCH_ON);
+    return false;
+  } else if constexpr (
+    M == MIDI_M_CTRL_CHANGE_FIXED_ON || M == MIDI_M_NOTE_FIXED_ON)
+    return pattern.key == eKey && eValue == pattern.high_value
+      && debounced(MIDI_MATCH_ON);
+  else if constexpr (
+    M == MIDI_M_CTRL_CHANGE_FIXED_OFF || M == MIDI_M_NOTE_FIXED_OFF)
+    return pattern.key == eKey && eValue == pattern.low_value
+      && debounced(MIDI_MATCH_OFF);
+  else if constexpr (M == MIDI_M_CTRL_CHANGE_FIXED_ON_OFF)
+    return pattern.key == eKey
+      && (eValue == pattern.high_value || eValue == pattern.low_value)
+      && debounced(MIDI_MATCH_CHANGE);
+  else if constexpr (M == MIDI_M_CTRL_BIT)
+    return pattern.key == eKey
+      && debounced(
+             eValue & (1 << pattern.low_value) ? MIDI_MATCH_ON
+                                               : MIDI_MATCH_OFF);
+  else if constexpr (
+    M == MIDI_M_PGM_CHANGE || M == MIDI_M_SYSEX_JOHANNUS_9)
+    return pattern.key == eKey && debounced(MIDI_MATCH_CHANGE);
+  else if constexpr (M == MIDI_M_SYSEX_JOHANNUS_11)
+    return pattern.key == eKey && pattern.low_value <= eValue
+      && pattern.high_value >= eValue && debounced(MIDI_MATCH_CHANGE);
+  else if constexpr (M == MIDI_M_PGM_RANGE) {
+    if (pattern.low_value == eKey)
+      return matched(MIDI_MATCH_OFF);
+    if (pattern.high_value == eKey)
+      return matched(MIDI_MATCH_ON);
+    return false;
+  } else if constexpr (M == MIDI_M_RPN_RANGE || M == MIDI_M_NRPN_RANGE) {
+    if (pattern.key != eValue)
+      return false;
+    if (pattern.low_value == eKey)
+      return matched(MIDI_MATCH_OFF);
+    if (pattern.high_value == eKey)
+      return matched(MIDI_MATCH_ON);
+    return false;
+  } else if constexpr (
+    M == MIDI_M_SYSEX_VISCOUNT || M == MIDI_M_SYSEX_AHLBORN_GALANTI) {
+    if (pattern.low_value == eValue)
+      return matched(MIDI_MATCH_OFF);
+    if (pattern.high_value == eValue)
+      return matched(MIDI_MATCH_ON);
+    return false;
+  } else if constexpr (M == MIDI_M_SYSEX_VISCOUNT_TOGGLE)
+    return pattern.low_value == eValue && debounced(MIDI_MATCH_CHANGE);
+  else if constexpr (M == MIDI_M_SYSEX_AHLBORN_GALANTI_TOGGLE)
+    return (pattern.low_value == eValue || pattern.high_value == eValue)
+      && debounced(MIDI_MATCH_CHANGE);
+  else if constexpr (M == MIDI_M_SYSEX_RODGERS_STOP_CHANGE) {
+    if (pattern.key != e.GetChannel())
+      return false;
+    switch (
+      GORodgersGetBit(pattern.low_value, eKey, e.GetData(), e.GetDataSize())) {
+    case MIDI_BIT_STATE::MIDI_BIT_CLEAR:
+      return matched(MIDI_MATCH_OFF);
+
+    case MIDI_BIT_STATE::MIDI_BIT_SET:
+      return matched(MIDI_MATCH_ON);
+
+    default:
+      return false;
+    }
+  } else
+    // is never called because matching_event_types() returns 0
+    return false;
+}
+
+template <GOMidiReceiverType R, std::size_t... M>
+GOMidiReceiver::MatchFunc GOMidiReceiver::getMatcher(
+  GOMidiReceiverMessageType type, std::index_sequence<M...>) {
+  static constexpr MatchFunc MATCHERS[]
+    = {&matchPattern<R, GOMidiReceiverMessageType(M)>...};
+
+  return MATCHERS[type];
+}
+
+void GOMidiReceiver::CompilePatterns() {
+  // the other receivers match the same way as drawstops
+  const GOMidiReceiverType matchingType
+    = m_type == MIDI_RECV_MANUAL || m_type == MIDI_RECV_ENCLOSURE
+    ? m_type
+    : MIDI_RECV_DRAWSTOP;
+  // MIDI_M_NOTE_NORMAL is the last message type
+  const auto messageTypes = std::make_index_sequence<MIDI_M_NOTE_NORMAL + 1>();
+
+  m_CompiledPatterns.clear();
+  for (unsigned i = 0; i < m_events.size(); i++) {
+    const auto &pattern = m_events[i];
+    const uint32_t eventTypes
+      = matching_event_types(matchingType, pattern.type);
+
+    if (!eventTypes || pattern.type > MIDI_M_NOTE_NORMAL)
+      continue;
+
+    MatchFunc fn;
+
+    if (matchingType == MIDI_RECV_MANUAL)
+      fn = getMatcher<MIDI_RECV_MANUAL>(pattern.type, messageTypes);
+    else if (matchingType == MIDI_RECV_ENCLOSURE)
+      fn = getMatcher<MIDI_RECV_ENCLOSURE>(pattern.type, messageTypes);
+    else
+      fn = getMatcher<MIDI_RECV_DRAWSTOP>(pattern.type, messageTypes);
+    m_CompiledPatterns.push_back(
+      {fn,
+       eventTypes,
+       pattern.channel != -1 && hasChannel(pattern.type) ? pattern.channel
+                                                          : -1,
+       pattern.deviceId,
+       i});
+  }
+}
+
+bool GOMidiReceiver::GetMidiRoutes(std::vector<uint32_t> &routes) const {
+  // the internal matches are set up by sysex at runtime
+  if (!m_Internal.empty())
+    return false;
+
+  const int any = GOMidiRoutingIndex::ANY;
+
+  for (const auto &pattern : m_events) {
+    const GOMidiReceiverMessageType pType = pattern.type;
+    const int channel
+      = pattern.channel != -1 && hasChannel(pType) ? pattern.channel : any;
+    auto addRoute = [&routes, channel](GOMidiEvent::MidiType type, int key) {
+      routes.push_back(GOMidiRoutingIndex::makeRoute(type, channel, key));
+    };
+
+    if (m_type == MIDI_RECV_MANUAL) {
+      if (
+        pType == MIDI_M_NOTE || pType == MIDI_M_NOTE_NO_VELOCITY
+        || pType == MIDI_M_NOTE_SHORT_OCTAVE || pType == MIDI_M_NOTE_NORMAL) {
+        // the key is transposed at runtime
+        addRoute(GOMidiEvent::MIDI_NOTE, any);
+        addRoute(GOMidiEvent::MIDI_AFTERTOUCH, any);
+        addRoute(GOMidiEvent::MIDI_CTRL_CHANGE, MIDI_CTRL_NOTES_OFF);
+        addRoute(GOMidiEvent::MIDI_CTRL_CHANGE, MIDI_CTRL_SOUNDS_OFF);
+      }
+      continue;
+    }
+    if (m_type == MIDI_RECV_ENCLOSURE) {
+      if (pType == MIDI_M_CTRL_CHANGE)
+        addRoute(GOMidiEvent::MIDI_CTRL_CHANGE, pattern.key);
+      else if (pType == MIDI_M_RPN)
+        addRoute(GOMidiEvent::MIDI_RPN, pattern.key);
+      else if (pType == MIDI_M_NRPN)
+        addRoute(GOMidiEvent::MIDI_NRPN, pattern.key);
+      else if (pType == MIDI_M_PGM_RANGE)
+        addRoute(GOMidiEvent::MIDI_PGM_CHANGE, any);
+      continue;
+    }
+    switch (pType) {
+    case MIDI_M_NOTE:
+    case MIDI_M_NOTE_ON:
+    case MIDI_M_NOTE_OFF:
+    case MIDI_M_NOTE_ON_OFF:
+    case MIDI_M_NOTE_FIXED_ON:
+    case MIDI_M_NOTE_FIXED_OFF:
+      addRoute(GOMidiEvent::MIDI_NOTE, pattern.key);
+      break;
+
+    case MIDI_M_CTRL_CHANGE:
+    case MIDI_M_CTRL_CHANGE_ON:
+    case MIDI_M_CTRL_CHANGE_OFF:
+    case MIDI_M_CTRL_CHANGE_ON_OFF:
+    case MIDI_M_CTRL_CHANGE_FIXED:
+    case MIDI_M_CTRL_CHANGE_FIXED_ON:
+    case MIDI_M_CTRL_CHANGE_FIXED_OFF:
+    case MIDI_M_CTRL_CHANGE_FIXED_ON_OFF:
+    case MIDI_M_CTRL_BIT:
+      addRoute(GOMidiEvent::MIDI_CTRL_CHANGE, pattern.key);
+      break;
+
+    case MIDI_M_RPN:
+    case MIDI_M_RPN_ON:
+    case MIDI_M_RPN_OFF:
+    case MIDI_M_RPN_ON_OFF:
+      addRoute(GOMidiEvent::MIDI_RPN, pattern.key);
+      break;
+
+    case MIDI_M_NRPN:
+    case MIDI_M_NRPN_ON:
+    case MIDI_M_NRPN_OFF:
+    case MIDI_M_NRPN_ON_OFF:
+      addRoute(GOMidiEvent::MIDI_NRPN, pattern.key);
+      break;
+
+    case MIDI_M_PGM_CHANGE:
+      addRoute(GOMidiEvent::MIDI_PGM_CHANGE, pattern.key);
+      break;
+
+    case MIDI_M_SYSEX_JOHANNUS_9:
+      addRoute(GOMidiEvent::MIDI_SYSEX_JOHANNUS_9, pattern.key);
+      break;
+
+    case MIDI_M_SYSEX_JOHANNUS_11:
+      addRoute(GOMidiEvent::MIDI_SYSEX_JOHANNUS_11, pattern.key);
+      break;
+
+    // for the following types the event key is matched with a range
+    case MIDI_M_PGM_RANGE:
+      addRoute(GOMidiEvent::MIDI_PGM_CHANGE, any);
+      break;
+
+    case MIDI_M_RPN_RANGE:
+      addRoute(GOMidiEvent::MIDI_RPN, any);
+      break;
+
+    case MIDI_M_NRPN_RANGE:
+      addRoute(GOMidiEvent::MIDI_NRPN, any);
+      break;
+
+    case MIDI_M_SYSEX_VISCOUNT:
+    case MIDI_M_SYSEX_VISCOUNT_TOGGLE:
+      addRoute(GOMidiEvent::MIDI_SYSEX_VISCOUNT, any);
+      break;
+
+    case MIDI_M_SYSEX_RODGERS_STOP_CHANGE:
+      routes.push_back(GOMidiRoutingIndex::makeRoute(
+        GOMidiEvent::MIDI_SYSEX_RODGERS_STOP_CHANGE, any, any));
+      break;
+
+    case MIDI_M_SYSEX_AHLBORN_GALANTI:
+    case MIDI_M_SYSEX_AHLBORN_GALANTI_TOGGLE:
+      addRoute(GOMidiEvent::MIDI_SYSEX_AHLBORN_GALANTI, any);
+      break;
+
+    case MIDI_M_NONE:
+    case MIDI_M_NOTE_NO_VELOCITY:
+    case MIDI_M_NOTE_SHORT_OCTAVE:
+    case MIDI_M_NOTE_NORMAL:
+      // never match for non-manual receivers
+      break;
+
+    default:
+      return false;
+    }
+  }
+  return true;
+}
+
 GOMidiMatchType GOMidiReceiver::Match(const GOMidiEvent &e) {
   int key;
   int value;
@@ -666,374 +1141,18 @@ GOMidiMatchType GOMidiReceiver::Match(
       return MIDI_MATCH_NONE;
     }
 
-  for (unsigned i = 0; i < m_events.size(); i++) {
-    const auto &pattern = m_events[i];
+  const uint32_t eventTypeBit = 1u << eMidiType;
 
-    if (
-      pattern.channel != -1 && pattern.channel != e.GetChannel()
-      && hasChannel(pattern.type))
-      continue;
-    if (pattern.deviceId != 0 && pattern.deviceId != e.GetDevice())
-      continue;
-    if (m_type == MIDI_RECV_MANUAL) {
-      if (
-        pattern.type != MIDI_M_NOTE && pattern.type != MIDI_M_NOTE_NO_VELOCITY
-        && pattern.type != MIDI_M_NOTE_SHORT_OCTAVE
-        && pattern.type != MIDI_M_NOTE_NORMAL)
-        continue;
-      if (
-        eMidiType == GOMidiEvent::MIDI_NOTE
-        || eMidiType == GOMidiEvent::MIDI_AFTERTOUCH) {
-        if (e.GetKey() < pattern.low_key || e.GetKey() > pattern.high_key)
-          continue;
-        key = e.GetKey();
-        if (pattern.type == MIDI_M_NOTE_SHORT_OCTAVE) {
-          int no = e.GetKey() - pattern.low_key;
-          if (no <= 3)
-            continue;
-          if (no == 4 || no == 6 || no == 8)
-            key -= 4;
-        }
-        key = key + transpose + pattern.key;
-        if (key < 0)
-          continue;
-        if (key > 127)
-          continue;
-        if (
-          pMidiMap && pattern.type != MIDI_M_NOTE_SHORT_OCTAVE
-          && pattern.type != MIDI_M_NOTE_NORMAL)
-          key = (*pMidiMap)[key];
-        if (pattern.type == MIDI_M_NOTE_NO_VELOCITY) {
-          value = e.GetValue() ? 127 : 0;
-          if (eMidiType == GOMidiEvent::MIDI_AFTERTOUCH)
-            continue;
-        } else
-          value = pattern.ConvertSrcValueToInt(e.GetValue());
-        if (pattern.low_value <= pattern.high_value) {
-          if (e.GetValue() < pattern.low_value)
-            return MIDI_MATCH_OFF;
-          if (e.GetValue() <= pattern.high_value)
-            return MIDI_MATCH_ON;
-        } else {
-          if (e.GetValue() >= pattern.low_value)
-            return MIDI_MATCH_OFF;
-          if (e.GetValue() >= pattern.high_value)
-            return MIDI_MATCH_ON;
-        }
-        continue;
-      }
-      if (
-        eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
-        && e.GetKey() == MIDI_CTRL_NOTES_OFF)
-        return MIDI_MATCH_RESET;
-
-      if (
-        eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
-        && e.GetKey() == MIDI_CTRL_SOUNDS_OFF)
-        return MIDI_MATCH_RESET;
-
-      continue;
-    }
-    if (m_type == MIDI_RECV_ENCLOSURE) {
-      if (
-        pattern.type == MIDI_M_CTRL_CHANGE
-        && eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
-        && pattern.key == e.GetKey()) {
-        value = pattern.ConvertSrcValueToInt(e.GetValue());
-        return MIDI_MATCH_CHANGE;
-      }
-      if (
-        pattern.type == MIDI_M_RPN && eMidiType == GOMidiEvent::MIDI_RPN
-        && pattern.key == e.GetKey()) {
-        value = pattern.ConvertSrcValueToInt(e.GetValue());
-        return MIDI_MATCH_CHANGE;
-      }
-      if (
-        pattern.type == MIDI_M_NRPN && eMidiType == GOMidiEvent::MIDI_NRPN
-        && pattern.key == e.GetKey()) {
-        value = pattern.ConvertSrcValueToInt(e.GetValue());
-        return MIDI_MATCH_CHANGE;
-      }
-      if (
-        pattern.type == MIDI_M_PGM_RANGE
-        && eMidiType == GOMidiEvent::MIDI_PGM_CHANGE)
-        if (
-          (pattern.low_value <= e.GetKey() && e.GetKey() <= pattern.high_value)
-          || (pattern.high_value <= e.GetKey() && e.GetKey() <= pattern.low_value)) {
-          value = pattern.ConvertSrcValueToInt(e.GetValue());
-          return MIDI_MATCH_CHANGE;
-        }
-      continue;
-    }
-    if (
-      eMidiType == GOMidiEvent::MIDI_NOTE && pattern.type == MIDI_M_NOTE
-      && pattern.key == e.GetKey()) {
-      if (pattern.low_value <= pattern.high_value) {
-        if (e.GetValue() <= pattern.low_value)
-          return MIDI_MATCH_OFF;
-        if (e.GetValue() >= pattern.high_value)
-          return MIDI_MATCH_ON;
-      } else {
-        if (e.GetValue() >= pattern.low_value)
-          return MIDI_MATCH_OFF;
-        if (e.GetValue() <= pattern.high_value)
-          return MIDI_MATCH_ON;
-      }
-      continue;
-    }
-    if (
-      eMidiType == GOMidiEvent::MIDI_NOTE && pattern.type == MIDI_M_NOTE_ON
-      && pattern.key == e.GetKey() && e.GetValue() >= pattern.high_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_NOTE && pattern.type == MIDI_M_NOTE_OFF
-      && pattern.key == e.GetKey() && e.GetValue() <= pattern.low_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_NOTE && pattern.type == MIDI_M_NOTE_ON_OFF
-      && pattern.key == e.GetKey() && e.GetValue() >= pattern.high_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_NOTE && pattern.type == MIDI_M_NOTE_ON_OFF
-      && pattern.key == e.GetKey() && e.GetValue() <= pattern.low_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-
-    if (
-      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
-      && pattern.type == MIDI_M_CTRL_CHANGE && pattern.key == e.GetKey()) {
-      if (pattern.low_value <= pattern.high_value) {
-        if (e.GetValue() <= pattern.low_value)
-          return debounce(e, MIDI_MATCH_OFF, i);
-        if (e.GetValue() >= pattern.high_value)
-          return debounce(e, MIDI_MATCH_ON, i);
-      } else {
-        if (e.GetValue() >= pattern.low_value)
-          return debounce(e, MIDI_MATCH_OFF, i);
-        if (e.GetValue() <= pattern.high_value)
-          return debounce(e, MIDI_MATCH_ON, i);
-      }
-      continue;
-    }
-    if (
-      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
-      && pattern.type == MIDI_M_CTRL_CHANGE_ON && pattern.key == e.GetKey()
-      && e.GetValue() >= pattern.high_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
-      && pattern.type == MIDI_M_CTRL_CHANGE_OFF && pattern.key == e.GetKey()
-      && e.GetValue() <= pattern.low_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
-      && pattern.type == MIDI_M_CTRL_CHANGE_ON_OFF && pattern.key == e.GetKey()
-      && e.GetValue() >= pattern.high_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
-      && pattern.type == MIDI_M_CTRL_CHANGE_ON_OFF && pattern.key == e.GetKey()
-      && e.GetValue() <= pattern.low_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
-      && pattern.type == MIDI_M_CTRL_CHANGE_FIXED
-      && pattern.key == e.GetKey()) {
-      if (e.GetValue() == pattern.low_value)
-        return debounce(e, MIDI_MATCH_OFF, i);
-      if (e.GetValue() == pattern.high_value)
-        return debounce(e, MIDI_MATCH_ON, i);
-      continue;
-    }
-    if (
-      ((eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
-        && pattern.type == MIDI_M_CTRL_CHANGE_FIXED_ON)
-       || (eMidiType == GOMidiEvent::MIDI_NOTE && pattern.type == MIDI_M_NOTE_FIXED_ON))
-      && pattern.key == e.GetKey() && e.GetValue() == pattern.high_value)
-      return debounce(e, MIDI_MATCH_ON, i);
-    if (
-      ((eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
-        && pattern.type == MIDI_M_CTRL_CHANGE_FIXED_OFF)
-       || (eMidiType == GOMidiEvent::MIDI_NOTE && pattern.type == MIDI_M_NOTE_FIXED_OFF))
-      && pattern.key == e.GetKey() && e.GetValue() == pattern.low_value)
-      return debounce(e, MIDI_MATCH_OFF, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
-      && pattern.type == MIDI_M_CTRL_CHANGE_FIXED_ON_OFF
-      && pattern.key == e.GetKey() && e.GetValue() == pattern.high_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
-      && pattern.type == MIDI_M_CTRL_CHANGE_FIXED_ON_OFF
-      && pattern.key == e.GetKey() && e.GetValue() == pattern.low_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
-      && pattern.type == MIDI_M_CTRL_BIT && pattern.key == e.GetKey()) {
-      unsigned mask = 1 << pattern.low_value;
-      if (e.GetValue() & mask)
-        return debounce(e, MIDI_MATCH_ON, i);
-      else
-        return debounce(e, MIDI_MATCH_OFF, i);
-    }
-
-    if (
-      eMidiType == GOMidiEvent::MIDI_RPN && pattern.type == MIDI_M_RPN
-      && pattern.key == e.GetKey()) {
-      if (pattern.low_value <= pattern.high_value) {
-        if (e.GetValue() <= pattern.low_value)
-          return MIDI_MATCH_OFF;
-        if (e.GetValue() >= pattern.high_value)
-          return MIDI_MATCH_ON;
-      } else {
-        if (e.GetValue() >= pattern.low_value)
-          return MIDI_MATCH_OFF;
-        if (e.GetValue() <= pattern.high_value)
-          return MIDI_MATCH_ON;
-      }
-      continue;
-    }
-    if (
-      eMidiType == GOMidiEvent::MIDI_RPN && pattern.type == MIDI_M_RPN_ON
-      && pattern.key == e.GetKey() && e.GetValue() >= pattern.high_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_RPN && pattern.type == MIDI_M_RPN_OFF
-      && pattern.key == e.GetKey() && e.GetValue() <= pattern.low_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_RPN && pattern.type == MIDI_M_RPN_ON_OFF
-      && pattern.key == e.GetKey() && e.GetValue() >= pattern.high_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_RPN && pattern.type == MIDI_M_RPN_ON_OFF
-      && pattern.key == e.GetKey() && e.GetValue() <= pattern.low_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
+  for (const CompiledPattern &pattern : m_CompiledPatterns) {
+    GOMidiMatchType result;
 
     if (
-      eMidiType == GOMidiEvent::MIDI_NRPN && pattern.type == MIDI_M_NRPN
-      && pattern.key == e.GetKey()) {
-      if (pattern.low_value <= pattern.high_value) {
-        if (e.GetValue() <= pattern.low_value)
-          return MIDI_MATCH_OFF;
-        if (e.GetValue() >= pattern.high_value)
-          return MIDI_MATCH_ON;
-      } else {
-        if (e.GetValue() >= pattern.low_value)
-          return MIDI_MATCH_OFF;
-        if (e.GetValue() <= pattern.high_value)
-          return MIDI_MATCH_ON;
-      }
-      continue;
-    }
-    if (
-      eMidiType == GOMidiEvent::MIDI_NRPN && pattern.type == MIDI_M_NRPN_ON
-      && pattern.key == e.GetKey() && e.GetValue() >= pattern.high_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_NRPN && pattern.type == MIDI_M_NRPN_OFF
-      && pattern.key == e.GetKey() && e.GetValue() <= pattern.low_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_NRPN && pattern.type == MIDI_M_NRPN_ON_OFF
-      && pattern.key == e.GetKey() && e.GetValue() >= pattern.high_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_NRPN && pattern.type == MIDI_M_NRPN_ON_OFF
-      && pattern.key == e.GetKey() && e.GetValue() <= pattern.low_value)
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-
-    if (
-      eMidiType == GOMidiEvent::MIDI_PGM_CHANGE
-      && pattern.type == MIDI_M_PGM_CHANGE && pattern.key == e.GetKey()) {
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    }
-    if (
-      eMidiType == GOMidiEvent::MIDI_PGM_CHANGE
-      && pattern.type == MIDI_M_PGM_RANGE && pattern.low_value == e.GetKey())
-      return MIDI_MATCH_OFF;
-    if (
-      eMidiType == GOMidiEvent::MIDI_PGM_CHANGE
-      && pattern.type == MIDI_M_PGM_RANGE && pattern.high_value == e.GetKey())
-      return MIDI_MATCH_ON;
-    if (
-      eMidiType == GOMidiEvent::MIDI_SYSEX_JOHANNUS_9
-      && pattern.type == MIDI_M_SYSEX_JOHANNUS_9 && pattern.key == e.GetKey()) {
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    }
-    if (
-      eMidiType == GOMidiEvent::MIDI_SYSEX_JOHANNUS_11
-      && pattern.type == MIDI_M_SYSEX_JOHANNUS_11 && pattern.key == e.GetKey()
-      && pattern.low_value <= e.GetValue()
-      && pattern.high_value >= e.GetValue()) {
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    }
-    if (
-      eMidiType == GOMidiEvent::MIDI_RPN && pattern.type == MIDI_M_RPN_RANGE
-      && pattern.low_value == e.GetKey() && pattern.key == e.GetValue())
-      return MIDI_MATCH_OFF;
-    if (
-      eMidiType == GOMidiEvent::MIDI_RPN && pattern.type == MIDI_M_RPN_RANGE
-      && pattern.high_value == e.GetKey() && pattern.key == e.GetValue())
-      return MIDI_MATCH_ON;
-    if (
-      eMidiType == GOMidiEvent::MIDI_NRPN && pattern.type == MIDI_M_NRPN_RANGE
-      && pattern.low_value == e.GetKey() && pattern.key == e.GetValue())
-      return MIDI_MATCH_OFF;
-    if (
-      eMidiType == GOMidiEvent::MIDI_NRPN && pattern.type == MIDI_M_NRPN_RANGE
-      && pattern.high_value == e.GetKey() && pattern.key == e.GetValue())
-      return MIDI_MATCH_ON;
-
-    if (
-      eMidiType == GOMidiEvent::MIDI_SYSEX_VISCOUNT
-      && pattern.type == MIDI_M_SYSEX_VISCOUNT
-      && pattern.low_value == e.GetValue())
-      return MIDI_MATCH_OFF;
-    if (
-      eMidiType == GOMidiEvent::MIDI_SYSEX_VISCOUNT
-      && pattern.type == MIDI_M_SYSEX_VISCOUNT
-      && pattern.high_value == e.GetValue())
-      return MIDI_MATCH_ON;
-    if (
-      eMidiType == GOMidiEvent::MIDI_SYSEX_VISCOUNT
-      && pattern.type == MIDI_M_SYSEX_VISCOUNT_TOGGLE
-      && pattern.low_value == e.GetValue()) {
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    }
-    if (
-      eMidiType == GOMidiEvent::MIDI_SYSEX_RODGERS_STOP_CHANGE
-      && pattern.type == MIDI_M_SYSEX_RODGERS_STOP_CHANGE
-      && pattern.key == e.GetChannel()) {
-      switch (GORodgersGetBit(pattern.low_value, e.GetKey(), e.GetData())) {
-      case MIDI_BIT_STATE::MIDI_BIT_CLEAR:
-        return MIDI_MATCH_OFF;
-
-      case MIDI_BIT_STATE::MIDI_BIT_SET:
-        return MIDI_MATCH_ON;
-
-      case MIDI_BIT_STATE::MIDI_BIT_NOT_PRESENT:;
-      }
-    }
-    if (
-      eMidiType == GOMidiEvent::MIDI_SYSEX_AHLBORN_GALANTI
-      && pattern.type == MIDI_M_SYSEX_AHLBORN_GALANTI
-      && pattern.low_value == e.GetValue())
-      return MIDI_MATCH_OFF;
-    if (
-      eMidiType == GOMidiEvent::MIDI_SYSEX_AHLBORN_GALANTI
-      && pattern.type == MIDI_M_SYSEX_AHLBORN_GALANTI
-      && pattern.high_value == e.GetValue())
-      return MIDI_MATCH_ON;
-    if (
-      eMidiType == GOMidiEvent::MIDI_SYSEX_AHLBORN_GALANTI
-      && pattern.type == MIDI_M_SYSEX_AHLBORN_GALANTI_TOGGLE
-      && pattern.low_value == e.GetValue())
-      return debounce(e, MIDI_MATCH_CHANGE, i);
-    if (
-      eMidiType == GOMidiEvent::MIDI_SYSEX_AHLBORN_GALANTI
-      && pattern.type == MIDI_M_SYSEX_AHLBORN_GALANTI_TOGGLE
-      && pattern.high_value == e.GetValue())
-      return debounce(e, MIDI_MATCH_CHANGE, i);
+      (pattern.eventTypes & eventTypeBit)
+      && (pattern.channel == -1 || pattern.channel == e.GetChannel())
+      && (pattern.deviceId == 0 || pattern.deviceId == e.GetDevice())
+      && pattern.fn(
+        *this, pattern.index, e, pMidiMap, transpose, key, value, result))
+      return result;
   }
   return MIDI_MATCH_NONE;
 }
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -9,6 +9,8 @@
 #define GOMIDIRECEIVER_H
 
 #include <cstdint>
+#include <utility>
+#include <vector>
 
 #include "config/GOConfigEnum.h"
 #include "midi/events/GOMidiMatchType.h"
@@ -36,17 +38,69 @@ private:
     int key;
   } midi_internal_match;
 
+  /**
+   * Matches the event with the pattern m_events[index]
+   * @return true if the matching is complete and Match() must return result.
+   *   false if the next pattern must be tried
+   */
+  using MatchFunc = bool (*)(
+    GOMidiReceiver &receiver,
+    unsigned index,
+    const GOMidiEvent &e,
+    const KeyMap *pMidiMap,
+    int transpose,
+    int &key,
+    int &value,
+    GOMidiMatchType &result);
+
+  /**
+   * A pattern prepared for matching. The common conditions are checked inline
+   * and the rest is checked by a matcher specialized for the receiver type and
+   * the pattern message type
+   */
+  struct CompiledPattern {
+    MatchFunc fn;
+    // a bit for each GOMidiEvent::MidiType the pattern may match
+    uint32_t eventTypes;
+    // -1 - any
+    int channel;
+    // 0 - any
+    unsigned deviceId;
+    // the index of the pattern in m_events
+    unsigned index;
+  };
+
   int m_ElementID;
   std::vector<GOTime> m_last;
   std::vector<midi_internal_match> m_Internal;
+  // only the patterns that may match something, in the order of m_events
+  std::vector<CompiledPattern> m_CompiledPatterns;
 
   GOMidiReceiverMessageType GetDefaultMidiType() const;
 
+  template <GOMidiReceiverType R, GOMidiReceiverMessageType M>
+  static bool matchPattern(
+    GOMidiReceiver &receiver,
+    unsigned index,
+    const GOMidiEvent &e,
+    const KeyMap *pMidiMap,
+    int transpose,
+    int &key,
+    int &value,
+    GOMidiMatchType &result);
+  template <GOMidiReceiverType R, std::size_t... M>
+  static MatchFunc getMatcher(
+    GOMidiReceiverMessageType type, std::index_sequence<M...>);
+  void CompilePatterns();
+
   GOMidiMatchType debounce(
     const GOMidiEvent &e, GOMidiMatchType event, unsigned index);
   void deleteInternal(unsigned device);
   unsigned createInternal(unsigned device);
 
+protected:
+  void OnEventsChanged() override;
+
 public:
   GOMidiReceiver(GOMidiReceiverType type);
 
@@ -69,6 +123,20 @@ public:
 
   void SetElementID(int id) { m_ElementID = id; }
 
+  /**
+   * Returns a number that is changed every time when the patterns of any
+   * receiver are changed. Is used for invalidating the midi routes
+   */
+  static unsigned getPatternsVersion();
+
+  /**
+   * Appends the routes of all midi events that the receiver may match.
+   * The routes are made with GOMidiRoutingIndex::makeRoute
+   * @param routes the vector to append the routes to
+   * @return false if the receiver may match any event
+   */
+  bool GetMidiRoutes(std::vector<uint32_t> &routes) const;
+
   GOMidiMatchType Match(const GOMidiEvent &e);
   GOMidiMatchType Match(
     const GOMidiEvent &e,
@@ -7,44 +7,58 @@
 
 #include "GOMidiEvent.h"
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
 #include <wx/intl.h>
+#include <wx/log.h>
 
 #include "midi/GOMidiMap.h"
 
 #include "GORodgers.h"
 
+// the events are copied between threads and queues without allocations
+static_assert(std::is_trivially_copyable_v<GOMidiEvent>);
+
 GOMidiEvent::GOMidiEvent()
   : m_MidiType(MIDI_NONE),
     m_channel(-1),
     m_key(-1),
     m_value(-1),
-    m_time(0),
-    m_string(),
-    m_data(),
+    m_device(0),
+    m_TimeMs(0),
+    m_TimeNs(0),
+    m_DataSize(0),
     m_IsToUseNoteOff(true),
-    m_IsAllowedToReload(true) {}
-
-GOMidiEvent::GOMidiEvent(const GOMidiEvent &e)
-  : m_MidiType(e.m_MidiType),
-    m_channel(e.m_channel),
-    m_key(e.m_key),
-    m_value(e.m_value),
-    m_device(e.m_device),
-    m_time(e.m_time),
-    m_string(e.m_string.Clone()),
-    m_data(e.m_data),
-    m_IsToUseNoteOff(e.m_IsToUseNoteOff),
-    m_IsAllowedToReload(e.m_IsAllowedToReload) {}
+    m_IsAllowedToReload(true) {
+  m_string[0] = 0;
+}
+
+void GOMidiEvent::SetString(const wxString &str) {
+  const wxCharBuffer b = str.ToAscii();
+  const unsigned len = std::min((unsigned)b.length(), MAX_STRING_LENGTH);
+
+  memcpy(m_string, b.data(), len);
+  m_string[len] = 0;
+}
 
 void GOMidiEvent::SetString(const wxString &str, unsigned length) {
   unsigned len = str.length();
   if (len < length) {
-    m_string = str;
-    m_string.Pad(length - len, wxT(' '), true);
+    wxString padded = str;
+
+    padded.Pad(length - len, wxT(' '), true);
+    SetString(padded);
   } else if (len == length)
-    m_string = str;
+    SetString(str);
   else
-    m_string = str.Mid(0, length);
+    SetString(str.Mid(0, length));
+}
+
+void GOMidiEvent::SetData(const uint8_t *data, unsigned size) {
+  m_DataSize = std::min(size, MAX_DATA_SIZE);
+  memcpy(m_data, data, m_DataSize);
 }
 
 void GOMidiEvent::FromMidi(
@@ -163,9 +177,13 @@ void GOMidiEvent::FromMidi(
       && msg[msg.size() - 1] == 0xf7) {
       SetChannel(msg[2]); /* device*/
       SetKey(msg[6]);
-      m_data.resize(msg.size() - 9);
-      for (unsigned i = 0; i < m_data.size(); i++)
-        m_data[i] = msg[7 + i];
+      if (msg.size() - 9 > MAX_DATA_SIZE) {
+        wxLogWarning(
+          _("Ignoring a Rodgers stop change message with %u data bytes"),
+          (unsigned)(msg.size() - 9));
+        return;
+      }
+      SetData(msg.data() + 7, msg.size() - 9);
       SetMidiType(MIDI_SYSEX_RODGERS_STOP_CHANGE);
       break;
     }
@@ -379,7 +397,7 @@ void GOMidiEvent::ToMidi(
     return;
 
   case MIDI_SYSEX_RODGERS_STOP_CHANGE: {
-    m.resize(7 + m_data.size() + 2);
+    m.resize(7 + m_DataSize + 2);
     m[0] = 0xf0;
     m[1] = 0x41;
     m[2] = GetChannel() & 0x7f; /* device */
@@ -387,10 +405,10 @@ void GOMidiEvent::ToMidi(
     m[4] = 0x12;
     m[5] = 0x01;
     m[6] = GetKey() & 0x7f;
-    for (unsigned i = 0; i < m_data.size(); i++)
+    for (unsigned i = 0; i < m_DataSize; i++)
       m[7 + i] = m_data[i];
-    m[7 + m_data.size() + 0] = GORodgersChecksum(m, 5, m_data.size() + 2);
-    m[7 + m_data.size() + 1] = 0xf7;
+    m[7 + m_DataSize + 0] = GORodgersChecksum(m, 5, m_DataSize + 2);
+    m[7 + m_DataSize + 1] = 0xf7;
     msg.push_back(m);
     return;
   }
@@ -496,7 +514,7 @@ wxString GOMidiEvent::ToString(GOMidiMap &map) const {
   case MIDI_SYSEX_RODGERS_STOP_CHANGE: {
     wxString data_string;
 
-    for (unsigned i = 0; i < m_data.size(); i++)
+    for (unsigned i = 0; i < m_DataSize; i++)
       data_string += wxString::Format(wxT(" %02x"), m_data[i]);
     return wxString::Format(
       _("sysex Rogers stop change device: %d offset: %d data %s"),
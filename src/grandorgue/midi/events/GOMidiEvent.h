@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -11,6 +11,8 @@
 #include <cstdint>
 #include <vector>
 
+#include <wx/string.h>
+
 #include "GOTime.h"
 
 class GOMidiMap;
@@ -25,6 +27,11 @@ class GOMidiMap;
 #define MIDI_CTRL_SOUNDS_OFF 120
 #define MIDI_CTRL_NOTES_OFF 123
 
+/**
+ * A midi event. It is trivially copyable and contains all its data inline,
+ * so creating and copying an event does not allocate. Passing a received
+ * event to the main thread still allocates a wx event (see GOMidiSystem::Recv)
+ */
 class GOMidiEvent {
 public:
   enum MidiType {
@@ -48,13 +55,26 @@ public:
     MIDI_SYSEX_RODGERS_STOP_CHANGE,
   };
 
+  // the maximal length of a string of a hardware display. It is the length of
+  // the longest display message (MIDI_SYSEX_HW_LCD)
+  static constexpr unsigned MAX_STRING_LENGTH = 32;
+  // the maximal size of the data of a sysex event. The data of a Rodgers stop
+  // change message is addressed with a 7-bit offset, so it never exceeds 128
+  // bytes
+  static constexpr unsigned MAX_DATA_SIZE = 128;
+
 private:
   MidiType m_MidiType;
   int m_channel, m_key, m_value;
   unsigned m_device;
-  GOTime m_time;
-  wxString m_string;
-  std::vector<uint8_t> m_data;
+  // GOTime in ms
+  int64_t m_TimeMs;
+  // the steady clock time of receiving the event in ns. 0 - unknown
+  int64_t m_TimeNs;
+  // an ascii zero-terminated string
+  char m_string[MAX_STRING_LENGTH + 1];
+  uint8_t m_data[MAX_DATA_SIZE];
+  unsigned m_DataSize;
   bool m_IsToUseNoteOff;
   /**
    * Is allowing to close the organ and to load another organ when playing this
@@ -64,7 +84,6 @@ private:
 
 public:
   GOMidiEvent();
-  GOMidiEvent(const GOMidiEvent &e);
 
   MidiType GetMidiType() const { return m_MidiType; }
   void SetMidiType(MidiType t) { m_MidiType = t; }
@@ -82,15 +101,29 @@ public:
   int GetValue() const { return m_value; }
   void SetValue(int v) { m_value = v; }
 
-  GOTime GetTime() const { return m_time; }
-  void SetTime(GOTime t) { m_time = t; }
+  GOTime GetTime() const { return GOTime(m_TimeMs); }
+  void SetTime(GOTime t) { m_TimeMs = t.GetValue(); }
+
+  int64_t GetTimeNs() const { return m_TimeNs; }
+  void SetTimeNs(int64_t timeNs) { m_TimeNs = timeNs; }
 
-  const wxString &GetString() const { return m_string; }
-  void SetString(const wxString &str) { m_string = str; }
+  wxString GetString() const { return wxString::FromAscii(m_string); }
+  /**
+   * Sets the string. It is truncated to MAX_STRING_LENGTH. No display message
+   * can carry a longer string
+   * @param str the string
+   */
+  void SetString(const wxString &str);
   void SetString(const wxString &str, unsigned length);
 
-  const std::vector<uint8_t> &GetData() const { return m_data; }
-  void SetData(const std::vector<uint8_t> &data) { m_data = data; }
+  const uint8_t *GetData() const { return m_data; }
+  unsigned GetDataSize() const { return m_DataSize; }
+  /**
+   * Sets the sysex data. It is truncated to MAX_DATA_SIZE
+   * @param data the data bytes
+   * @param size the number of bytes
+   */
+  void SetData(const uint8_t *data, unsigned size);
 
   void FromMidi(const std::vector<unsigned char> &msg, GOMidiMap &map);
   void ToMidi(
@@ -23,6 +23,9 @@ protected:
   MidiType m_type;
   std::vector<MidiEventPattern> m_events;
 
+  // Is called after the list of events has been changed
+  virtual void OnEventsChanged() {}
+
 public:
   GOMidiEventPatternList(MidiType type) : m_type(type) {}
   virtual ~GOMidiEventPatternList() {}
@@ -33,7 +36,10 @@ public:
 
   bool IsMidiConfigured() const { return !m_events.empty(); }
 
-  void ClearEvents() { m_events.clear(); }
+  void ClearEvents() {
+    m_events.clear();
+    OnEventsChanged();
+  }
 
   const MidiEventPattern &GetEvent(unsigned index) const {
     return m_events[index];
@@ -47,10 +53,14 @@ public:
 
   unsigned AddNewEvent() {
     m_events.emplace_back();
+    OnEventsChanged();
     return m_events.size() - 1;
   }
 
-  void DeleteEvent(unsigned index) { m_events.erase(m_events.begin() + index); }
+  void DeleteEvent(unsigned index) {
+    m_events.erase(m_events.begin() + index);
+    OnEventsChanged();
+  }
 
   /**
    * Assign the new list to the current one
@@ -73,6 +83,7 @@ public:
     if (result) {
       m_type = newList.m_type;
       m_events = nonEmptyEvents;
+      OnEventsChanged();
     }
     return result;
   }
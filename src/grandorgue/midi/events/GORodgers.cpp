@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -17,14 +17,14 @@ uint8_t GORodgersChecksum(
 
 MIDI_BIT_STATE
 GORodgersGetBit(
-  unsigned stop, unsigned offset, const std::vector<uint8_t> data) {
+  unsigned stop, unsigned offset, const uint8_t *data, unsigned size) {
   unsigned start = offset * 7;
   if (stop < start)
     return MIDI_BIT_STATE::MIDI_BIT_NOT_PRESENT;
   stop -= start;
   unsigned pos = stop / 7;
   unsigned bit = stop - pos * 7;
-  if (pos >= data.size())
+  if (pos >= size)
     return MIDI_BIT_STATE::MIDI_BIT_NOT_PRESENT;
   if (data[pos] & (1 << bit))
     return MIDI_BIT_STATE::MIDI_BIT_SET;
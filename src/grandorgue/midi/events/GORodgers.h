@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -23,7 +23,7 @@ uint8_t GORodgersChecksum(
   const std::vector<uint8_t> &msg, unsigned start, unsigned len);
 
 MIDI_BIT_STATE GORodgersGetBit(
-  unsigned stop, unsigned offset, const std::vector<uint8_t> data);
+  unsigned stop, unsigned offset, const uint8_t *data, unsigned size);
 unsigned GORodgersSetBit(unsigned stop, bool state, std::vector<uint8_t> &data);
 
 #endif
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOMidiFileWriter.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "GOMidiFile.h"
+
+GOMidiFileWriter::GOMidiFileWriter()
+  : m_file(),
+    m_FileLength(0),
+    m_chunks(N_CHUNKS),
+    m_NCommitted(0),
+    m_NWritten(0),
+    m_NWakeups(0),
+    m_thread(*this) {}
+
+GOMidiFileWriter::~GOMidiFileWriter() { Close(); }
+
+void GOMidiFileWriter::Wakeup() {
+  m_NWakeups.fetch_add(1);
+  m_NWakeups.notify_one();
+}
+
+void GOMidiFileWriter::WriteToFile(const void *data, unsigned len) {
+  m_file.Write(data, len);
+  m_FileLength += len;
+}
+
+void GOMidiFileWriter::WritePending() {
+  const unsigned nCommitted = m_NCommitted.load();
+
+  for (unsigned nWritten = m_NWritten.load(); nWritten != nCommitted;) {
+    const Chunk &chunk = m_chunks[nWritten % N_CHUNKS];
+
+    WriteToFile(chunk.m_data, chunk.m_size);
+    nWritten++;
+    m_NWritten.store(nWritten);
+    m_NWritten.notify_one();
+  }
+}
+
+void GOMidiFileWriter::WriteChunks(GOThread *pThread) {
+  while (!pThread->ShouldStop()) {
+    // load the counter before writing, so no wakeup is lost
+    const unsigned nWakeups = m_NWakeups.load();
+
+    WritePending();
+    m_NWakeups.wait(nWakeups);
+  }
+  // the chunks committed before stopping
+  WritePending();
+}
+
+void GOMidiFileWriter::Write(const void *data, unsigned len) {
+  const uint8_t *pData = (const uint8_t *)data;
+
+  while (len) {
+    Chunk &chunk = m_chunks[m_NCommitted.load() % N_CHUNKS];
+    const unsigned n = std::min(len, CHUNK_SIZE - chunk.m_size);
+
+    if (!n) {
+      Commit();
+      continue;
+    }
+    memcpy(chunk.m_data + chunk.m_size, pData, n);
+    chunk.m_size += n;
+    pData += n;
+    len -= n;
+  }
+}
+
+void GOMidiFileWriter::EncodeLength(unsigned len) {
+  uint8_t buf[16];
+  unsigned l = sizeof(buf) - 1;
+
+  buf[l] = len & 0x7F;
+  len = len >> 7;
+  while (len) {
+    l--;
+    buf[l] = 0x80 | (len & 0x7F);
+    len = len >> 7;
+  }
+  Write(buf + l, sizeof(buf) - l);
+}
+
+bool GOMidiFileWriter::Open(
+  const wxString &filename, const wxString &trackName) {
+  const MIDIHeaderChunk h = {{{'M', 'T', 'h', 'd'}, 6}, 0, 1, 0xE728};
+  const MIDIFileHeader t = {{'M', 'T', 'r', 'k'}, 0};
+  const unsigned char th[] = {0x00, 0xFF, 0x04};
+  const wxCharBuffer b = trackName.ToAscii();
+  const unsigned len = trackName.length();
+
+  Close();
+  m_file.Create(filename, true);
+  if (!m_file.IsOpened())
+    return false;
+  m_FileLength = 0;
+  m_NCommitted.store(0);
+  m_NWritten.store(0);
+  m_chunks[0].m_size = 0;
+  Write(&h, sizeof(h));
+  Write(&t, sizeof(t));
+  Write(th, sizeof(th));
+  EncodeLength(len);
+  Write(b.data(), len);
+  m_thread.Start();
+  return true;
+}
+
+void GOMidiFileWriter::WriteEvent(
+  unsigned deltaMs, const std::vector<unsigned char> &msg) {
+  EncodeLength(deltaMs);
+  if (msg[0] == 0xF0) {
+    Write(&msg[0], 1);
+    EncodeLength(msg.size() - 1);
+    Write(&msg[1], msg.size() - 1);
+  } else
+    Write(msg.data(), msg.size());
+}
+
+void GOMidiFileWriter::Commit() {
+  const unsigned nCommitted = m_NCommitted.load();
+
+  if (!m_chunks[nCommitted % N_CHUNKS].m_size)
+    return;
+  m_NCommitted.store(nCommitted + 1);
+  Wakeup();
+
+  // wait until the next chunk has been written if the ring is full
+  unsigned nWritten;
+
+  while (nCommitted + 1 - (nWritten = m_NWritten.load()) >= N_CHUNKS)
+    m_NWritten.wait(nWritten);
+  m_chunks[(nCommitted + 1) % N_CHUNKS].m_size = 0;
+}
+
+void GOMidiFileWriter::Close() {
+  if (!IsOpen())
+    return;
+  Commit();
+  m_thread.MarkForStop();
+  Wakeup();
+  m_thread.Wait();
+
+  const unsigned char end[4] = {0x01, 0xFF, 0x2F, 0x00};
+
+  WriteToFile(end, sizeof(end));
+
+  const MIDIFileHeader h
+    = {{'M', 'T', 'r', 'k'},
+       m_FileLength - sizeof(MIDIHeaderChunk) - sizeof(MIDIFileHeader)};
+
+  m_file.Seek(sizeof(MIDIHeaderChunk));
+  m_file.Write(&h, sizeof(h));
+  m_file.Flush();
+  m_file.Close();
+}
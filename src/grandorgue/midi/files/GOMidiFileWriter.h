@@ -0,0 +1,104 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOMIDIFILEWRITER_H
+#define GOMIDIFILEWRITER_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <wx/file.h>
+#include <wx/string.h>
+
+#include "threading/GOThread.h"
+
+/**
+ * Writes a single-track midi file. The events are encoded into a preallocated
+ * ring of chunks and the committed chunks are written to the file by
+ * a separate thread, so the producer never waits for the disk unless the whole
+ * ring is full.
+ *
+ * There must be only one producer at a time: all calls of WriteEvent() and
+ * Commit() must be serialized by the caller
+ */
+class GOMidiFileWriter {
+private:
+  class WriterThread : public GOThread {
+  private:
+    GOMidiFileWriter &r_writer;
+
+    void Entry() override { r_writer.WriteChunks(this); }
+
+  public:
+    WriterThread(GOMidiFileWriter &writer) : r_writer(writer) {}
+  };
+
+  static constexpr unsigned CHUNK_SIZE = 4096;
+  // must be a power of 2
+  static constexpr unsigned N_CHUNKS = 64;
+
+  struct Chunk {
+    unsigned m_size;
+    uint8_t m_data[CHUNK_SIZE];
+  };
+
+  wxFile m_file;
+  // the number of bytes written to the file
+  unsigned m_FileLength;
+  std::vector<Chunk> m_chunks;
+  // the number of chunks committed by the producer. The chunk being filled is
+  // m_chunks[m_NCommitted % N_CHUNKS]
+  std::atomic_uint m_NCommitted;
+  // the number of chunks written to the file by the writer thread
+  std::atomic_uint m_NWritten;
+  // is incremented for waking the writer thread
+  std::atomic_uint m_NWakeups;
+  WriterThread m_thread;
+
+  void Wakeup();
+  // writes all the committed chunks to the file. Called by the writer thread
+  void WritePending();
+  void WriteChunks(GOThread *pThread);
+  void WriteToFile(const void *data, unsigned len);
+
+  void Write(const void *data, unsigned len);
+  void EncodeLength(unsigned len);
+
+public:
+  GOMidiFileWriter();
+  ~GOMidiFileWriter();
+
+  /**
+   * Creates the file, writes the midi header and the track name and starts
+   * the writer thread
+   * @param filename the file to create
+   * @param trackName the name of the track
+   * @return if the file has been created
+   */
+  bool Open(const wxString &filename, const wxString &trackName);
+  bool IsOpen() const { return m_file.IsOpened(); }
+
+  /**
+   * Encodes one midi message into the current chunk. Does not do any io
+   * @param deltaMs the time since the previous message in ms
+   * @param msg the midi message. A sysex message must start with 0xF0
+   */
+  void WriteEvent(unsigned deltaMs, const std::vector<unsigned char> &msg);
+  /**
+   * Passes the current chunk to the writer thread. Waits only if all chunks
+   * are still waiting to be written
+   */
+  void Commit();
+  /**
+   * Writes all the pending chunks, stops the writer thread, completes the
+   * track and closes the file
+   */
+  void Close();
+};
+
+#endif
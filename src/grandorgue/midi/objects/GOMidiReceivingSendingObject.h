@@ -62,6 +62,10 @@ protected:
 public:
   void PreparePlayback() override;
 
+  bool GetMidiRoutes(std::vector<uint32_t> &routes) const override {
+    return m_receiver.GetMidiRoutes(routes);
+  }
+
 private:
   void ProcessMidi(const GOMidiEvent &event) override;
 
@@ -25,7 +25,8 @@ GOMidiInPort::GOMidiInPort(
 
 GOMidiInPort::~GOMidiInPort() {}
 
-void GOMidiInPort::Receive(const std::vector<unsigned char> msg) {
+void GOMidiInPort::Receive(
+  const std::vector<unsigned char> &msg, int64_t timeNs) {
   if (!IsActive())
     return;
 
@@ -35,6 +36,7 @@ void GOMidiInPort::Receive(const std::vector<unsigned char> msg) {
     return;
   e.SetDevice(GetID());
   e.SetTime(wxGetLocalTimeMillis());
+  e.SetTimeNs(timeNs ? timeNs : go_steady_time_ns());
 
   if (!m_merger.Process(e))
     return;
@@ -8,6 +8,8 @@
 #ifndef GOMIDIINPORT_H
 #define GOMIDIINPORT_H
 
+#include <cstdint>
+
 #include "GOMidiPort.h"
 #include "midi/GOMidiInputMerger.h"
 #include "ptrvector.h"
@@ -19,7 +21,13 @@ protected:
 
   virtual const wxString GetMyNativePortName() const;
 
-  void Receive(const std::vector<unsigned char> msg);
+  /**
+   * Converts the message to an event and passes it for processing
+   * @param msg the raw midi message
+   * @param timeNs the steady clock time of receiving the message in ns. 0 means
+   *   the current time
+   */
+  void Receive(const std::vector<unsigned char> &msg, int64_t timeNs = 0);
 
 public:
   GOMidiInPort(
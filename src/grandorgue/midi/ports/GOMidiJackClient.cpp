@@ -0,0 +1,126 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+// wx should be included before windows.h (from jack.h), otherwise it cannot be
+// compiled with mingw
+#include <wx/intl.h>
+#include <wx/log.h>
+
+#include "GOMidiJackClient.h"
+
+#if defined(GO_USE_JACK)
+
+#include <algorithm>
+
+#include "threading/GOMutexLocker.h"
+
+#include "GOTime.h"
+
+static const char *CLIENT_NAME = "GrandOrgueMidi";
+static const char *PROBE_CLIENT_NAME = "GrandOrgueMidiProbe";
+// how long the result of probing the server is reused
+static constexpr int64_t PROBE_INTERVAL_NS = 5000000000LL;
+
+GOMidiJackClient::GOMidiJackClient()
+  : mp_client(nullptr), m_IsServerRunning(false), m_ProbeTimeNs(0) {}
+
+GOMidiJackClient &GOMidiJackClient::getInstance() {
+  static GOMidiJackClient instance;
+
+  return instance;
+}
+
+int GOMidiJackClient::jackProcessCallback(jack_nframes_t nFrames, void *pData) {
+  GOMidiJackClient *const pClient = (GOMidiJackClient *)pData;
+  GOMutexLocker locker(pClient->m_ProcessLock);
+
+  for (Port *pPort : pClient->m_ports)
+    pPort->OnJackProcess(pClient->mp_client, nFrames);
+  return 0;
+}
+
+bool GOMidiJackClient::IsServerRunning() {
+  GOMutexLocker locker(m_lock);
+
+  if (mp_client)
+    return true;
+
+  const int64_t nowNs = go_steady_time_ns();
+
+  if (!m_ProbeTimeNs || nowNs - m_ProbeTimeNs >= PROBE_INTERVAL_NS) {
+    jack_status_t status;
+    jack_client_t *pProbe
+      = jack_client_open(PROBE_CLIENT_NAME, JackNoStartServer, &status);
+
+    if (pProbe)
+      jack_client_close(pProbe);
+    m_IsServerRunning = pProbe;
+    m_ProbeTimeNs = nowNs;
+  }
+  return m_IsServerRunning;
+}
+
+jack_port_t *GOMidiJackClient::RegisterPort(
+  Port *pPort, const wxString &portName, unsigned long flags) {
+  GOMutexLocker locker(m_lock);
+
+  if (!mp_client) {
+    jack_status_t status;
+
+    mp_client = jack_client_open(CLIENT_NAME, JackNoStartServer, &status);
+    if (!mp_client)
+      return nullptr;
+    if (
+      jack_set_process_callback(mp_client, &jackProcessCallback, this)
+      || jack_activate(mp_client)) {
+      Close();
+      return nullptr;
+    }
+  }
+
+  jack_port_t *const pJackPort = jack_port_register(
+    mp_client, portName.utf8_str(), JACK_DEFAULT_MIDI_TYPE, flags, 0);
+
+  if (pJackPort) {
+    std::vector<Port *> ports(m_ports);
+
+    ports.push_back(pPort);
+    SetPorts(ports);
+  } else if (m_ports.empty())
+    Close();
+  return pJackPort;
+}
+
+void GOMidiJackClient::UnregisterPort(Port *pPort, jack_port_t *pJackPort) {
+  GOMutexLocker locker(m_lock);
+
+  std::vector<Port *> ports(m_ports);
+
+  ports.erase(std::remove(ports.begin(), ports.end(), pPort), ports.end());
+  SetPorts(ports);
+  if (mp_client && pJackPort)
+    jack_port_unregister(mp_client, pJackPort);
+  if (m_ports.empty())
+    Close();
+}
+
+void GOMidiJackClient::SetPorts(std::vector<Port *> &ports) {
+  GOMutexLocker processLocker(m_ProcessLock);
+
+  // no allocation while the process cycle is waiting
+  m_ports.swap(ports);
+}
+
+void GOMidiJackClient::Close() {
+  if (mp_client) {
+    jack_deactivate(mp_client);
+    jack_client_close(mp_client);
+    mp_client = nullptr;
+  }
+}
+
+#endif /* GO_USE_JACK */
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOMIDIJACKCLIENT_H
+#define GOMIDIJACKCLIENT_H
+
+#if defined(GO_USE_JACK)
+
+#include <cstdint>
+#include <vector>
+
+#include <wx/string.h>
+
+#if defined(_WIN32) && !defined(WIN32)
+// see GOSoundJackPort.h
+#define WIN32 1
+#endif
+#include <jack/jack.h>
+
+#include "threading/GOMutex.h"
+
+/**
+ * The JACK client shared by all native JACK midi ports. It is opened when the
+ * first port is registered and is closed when the last one is unregistered.
+ * Each JACK process cycle is passed to all registered ports
+ */
+class GOMidiJackClient {
+public:
+  class Port {
+  public:
+    virtual ~Port() {}
+
+    /**
+     * Is called from the JACK process thread. Must not block or allocate
+     */
+    virtual void OnJackProcess(jack_client_t *pClient, jack_nframes_t nFrames)
+      = 0;
+  };
+
+private:
+  // protects mp_client, m_ports and the probe result against concurrent changes
+  GOMutex m_lock;
+  /* Is held by the process cycle while it calls the ports, so a port is never
+   * called after it has been unregistered. Other threads hold it only for
+   * swapping m_ports, so the process cycle never waits long */
+  GOMutex m_ProcessLock;
+  jack_client_t *mp_client;
+  std::vector<Port *> m_ports;
+  bool m_IsServerRunning;
+  // the steady clock time of the last server probe. 0 - never probed
+  int64_t m_ProbeTimeNs;
+
+  GOMidiJackClient();
+
+  static int jackProcessCallback(jack_nframes_t nFrames, void *pData);
+
+  /**
+   * Replaces m_ports with ports. The old list is returned in ports, so it is
+   * freed outside of m_ProcessLock
+   */
+  void SetPorts(std::vector<Port *> &ports);
+  void Close();
+
+public:
+  static GOMidiJackClient &getInstance();
+
+  /**
+   * Checks whether a JACK server is running without starting it. The result
+   * of probing the server is reused for some seconds
+   */
+  bool IsServerRunning();
+
+  /**
+   * Registers a new JACK midi port and starts calling pPort in each process
+   * cycle. Opens the client if it has not been opened yet
+   * @param pPort the port to call
+   * @param portName the JACK name of the port
+   * @param flags the JACK port flags (JackPortIsInput or JackPortIsOutput)
+   * @return the registered JACK port or nullptr if it could not be registered
+   */
+  jack_port_t *RegisterPort(
+    Port *pPort, const wxString &portName, unsigned long flags);
+
+  /**
+   * Stops calling pPort and unregisters its JACK port. Closes the client when
+   * no more ports are registered
+   */
+  void UnregisterPort(Port *pPort, jack_port_t *pJackPort);
+};
+
+#endif /* GO_USE_JACK */
+
+#endif /* GOMIDIJACKCLIENT_H */
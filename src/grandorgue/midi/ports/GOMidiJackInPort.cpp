@@ -0,0 +1,166 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+// wx should be included before windows.h (from jack.h), otherwise it cannot be
+// compiled with mingw
+#include <wx/intl.h>
+#include <wx/log.h>
+
+#include "GOMidiJackInPort.h"
+
+#if defined(GO_USE_JACK)
+
+#include <cstdint>
+
+#include <jack/midiport.h>
+
+#include "GOTime.h"
+#include "midi/GOMidiSystem.h"
+#include "threading/GOMutexLocker.h"
+
+#include "GOMidiJackPortFactory.h"
+
+static constexpr size_t RING_BUFFER_SIZE = 65536;
+
+// precedes the data of each message in the ring buffer
+struct GOMidiJackInMessageHeader {
+  int64_t timeNs;
+  uint32_t size;
+};
+
+GOMidiJackInPort::GOMidiJackInPort(
+  GOMidiSystem *midi, const wxString &deviceName, const wxString &fullName)
+  : GOMidiInPort(
+    midi,
+    GOMidiJackPortFactory::PORT_NAME,
+    wxEmptyString,
+    deviceName,
+    fullName),
+    m_HasDropped(false),
+    m_NWakeups(0),
+    m_thread(*this) {
+  m_msg.reserve(256);
+  m_thread.Start();
+}
+
+GOMidiJackInPort::~GOMidiJackInPort() {
+  Close();
+  m_thread.MarkForStop();
+  Wakeup();
+  m_thread.Wait();
+}
+
+void GOMidiJackInPort::Wakeup() {
+  m_NWakeups.fetch_add(1);
+  m_NWakeups.notify_one();
+}
+
+void GOMidiJackInPort::OnJackProcess(
+  jack_client_t *pClient, jack_nframes_t nFrames) {
+  void *pBuffer = jack_port_get_buffer(mp_JackPort, nFrames);
+  const jack_nframes_t nEvents = jack_midi_get_event_count(pBuffer);
+
+  if (nEvents) {
+    // The events of this cycle have arrived during the previous one. Convert
+    // their frames to the JACK time and then to the steady clock time
+    const jack_nframes_t arrivalStart = jack_last_frame_time(pClient) - nFrames;
+    const int64_t nowNs = go_steady_time_ns();
+    const jack_time_t nowUs = jack_get_time();
+    bool hasWritten = false;
+    jack_midi_event_t event;
+
+    for (jack_nframes_t i = 0; i < nEvents; i++)
+      if (!jack_midi_event_get(&event, pBuffer, i) && event.size) {
+        const jack_time_t eventUs
+          = jack_frames_to_time(pClient, arrivalStart + event.time);
+        GOMidiJackInMessageHeader header;
+
+        header.timeNs = nowNs - (int64_t(nowUs) - int64_t(eventUs)) * 1000;
+        header.size = event.size;
+        if (
+          jack_ringbuffer_write_space(mp_RingBuffer)
+          >= sizeof(header) + header.size) {
+          jack_ringbuffer_write(
+            mp_RingBuffer, (const char *)&header, sizeof(header));
+          jack_ringbuffer_write(
+            mp_RingBuffer, (const char *)event.buffer, header.size);
+          hasWritten = true;
+        } else
+          m_HasDropped.store(true);
+      }
+    if (hasWritten)
+      Wakeup();
+  }
+}
+
+void GOMidiJackInPort::ReadPending() {
+  GOMutexLocker locker(m_ReadMutex);
+  GOMidiJackInMessageHeader header;
+
+  if (!mp_RingBuffer)
+    return;
+  while (
+    jack_ringbuffer_peek(mp_RingBuffer, (char *)&header, sizeof(header))
+      == sizeof(header)
+    && jack_ringbuffer_read_space(mp_RingBuffer)
+      >= sizeof(header) + header.size) {
+    jack_ringbuffer_read_advance(mp_RingBuffer, sizeof(header));
+    m_msg.resize(header.size);
+    jack_ringbuffer_read(mp_RingBuffer, (char *)m_msg.data(), header.size);
+    Receive(m_msg, header.timeNs);
+  }
+  if (m_HasDropped.exchange(false))
+    wxLogError(_("JACK midi input buffer overflow"));
+}
+
+void GOMidiJackInPort::ReadMessages(GOThread *pThread) {
+  while (!pThread->ShouldStop()) {
+    // load the counter before reading, so no wakeup is lost
+    const unsigned nWakeups = m_NWakeups.load();
+
+    ReadPending();
+    m_NWakeups.wait(nWakeups);
+  }
+}
+
+bool GOMidiJackInPort::Open(unsigned id, int channel_shift) {
+  Close();
+
+  {
+    GOMutexLocker locker(m_ReadMutex);
+
+    mp_RingBuffer = jack_ringbuffer_create(RING_BUFFER_SIZE);
+  }
+  if (mp_RingBuffer)
+    mp_JackPort = GOMidiJackClient::getInstance().RegisterPort(
+      this, GetMyNativePortName(), JackPortIsInput);
+  // the process cycle may be called from now on
+  if (mp_JackPort)
+    m_IsActive = true;
+  else {
+    wxLogError(_("Unable to open the JACK midi input port"));
+    Close();
+  }
+  return GOMidiInPort::Open(id, channel_shift);
+}
+
+void GOMidiJackInPort::Close() {
+  m_IsActive = false;
+  if (mp_JackPort) {
+    GOMidiJackClient::getInstance().UnregisterPort(this, mp_JackPort);
+    mp_JackPort = nullptr;
+  }
+  if (mp_RingBuffer) {
+    GOMutexLocker locker(m_ReadMutex);
+
+    jack_ringbuffer_free(mp_RingBuffer);
+    mp_RingBuffer = nullptr;
+  }
+  GOMidiInPort::Close();
+}
+
+#endif /* GO_USE_JACK */
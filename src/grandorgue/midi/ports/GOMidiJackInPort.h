@@ -0,0 +1,77 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOMIDIJACKINPORT_H
+#define GOMIDIJACKINPORT_H
+
+#if defined(GO_USE_JACK)
+
+#include <atomic>
+#include <vector>
+
+#if defined(_WIN32) && !defined(WIN32)
+// see GOSoundJackPort.h
+#define WIN32 1
+#endif
+#include <jack/jack.h>
+#include <jack/ringbuffer.h>
+
+#include "threading/GOMutex.h"
+#include "threading/GOThread.h"
+
+#include "GOMidiInPort.h"
+#include "GOMidiJackClient.h"
+
+/**
+ * A midi input port of the shared JACK client. The raw messages are read in
+ * the JACK process cycle, are timestamped with their frame offsets and are
+ * passed through a lock-free ring buffer to a reading thread of the port that
+ * converts them to events. The organ model is not real-time safe, so the
+ * events cannot be processed in the JACK process cycle
+ */
+class GOMidiJackInPort : public GOMidiInPort, private GOMidiJackClient::Port {
+private:
+  class ReadingThread : public GOThread {
+  private:
+    GOMidiJackInPort &r_port;
+
+    void Entry() override { r_port.ReadMessages(this); }
+
+  public:
+    ReadingThread(GOMidiJackInPort &port) : r_port(port) {}
+  };
+
+  jack_port_t *mp_JackPort = nullptr;
+  jack_ringbuffer_t *mp_RingBuffer = nullptr;
+  // protects the ring buffer from being freed while reading from it
+  GOMutex m_ReadMutex;
+  // a message has been dropped because the ring buffer was full
+  std::atomic_bool m_HasDropped;
+  // is reused for all messages for avoiding allocations
+  std::vector<unsigned char> m_msg;
+  // is incremented for waking the reading thread
+  std::atomic_uint m_NWakeups;
+  ReadingThread m_thread;
+
+  void OnJackProcess(jack_client_t *pClient, jack_nframes_t nFrames) override;
+  void Wakeup();
+  // passes all the messages of the ring buffer to Receive()
+  void ReadPending();
+  void ReadMessages(GOThread *pThread);
+
+public:
+  GOMidiJackInPort(
+    GOMidiSystem *midi, const wxString &deviceName, const wxString &fullName);
+  ~GOMidiJackInPort();
+
+  bool Open(unsigned id, int channel_shift = 0) override;
+  void Close() override;
+};
+
+#endif /* GO_USE_JACK */
+
+#endif /* GOMIDIJACKINPORT_H */
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+// wx should be included before windows.h (from jack.h), otherwise it cannot be
+// compiled with mingw
+#include <wx/intl.h>
+#include <wx/log.h>
+
+#include "GOMidiJackOutPort.h"
+
+#if defined(GO_USE_JACK)
+
+#include <cstdint>
+
+#include <jack/midiport.h>
+
+#include "threading/GOMutexLocker.h"
+
+#include "GOMidiJackPortFactory.h"
+
+static constexpr size_t RING_BUFFER_SIZE = 65536;
+
+GOMidiJackOutPort::GOMidiJackOutPort(
+  GOMidiSystem *midi, const wxString &deviceName, const wxString &fullName)
+  : GOMidiOutPort(
+    midi,
+    GOMidiJackPortFactory::PORT_NAME,
+    wxEmptyString,
+    deviceName,
+    fullName) {}
+
+GOMidiJackOutPort::~GOMidiJackOutPort() { Close(); }
+
+void GOMidiJackOutPort::OnJackProcess(
+  jack_client_t *pClient, jack_nframes_t nFrames) {
+  jack_ringbuffer_t *const pRing = mp_RingBuffer;
+  void *pBuffer = jack_port_get_buffer(mp_JackPort, nFrames);
+  uint32_t size;
+
+  jack_midi_clear_buffer(pBuffer);
+  // each message is stored as its size followed by its data
+  while (
+    jack_ringbuffer_peek(pRing, (char *)&size, sizeof(size)) == sizeof(size)
+    && jack_ringbuffer_read_space(pRing) >= sizeof(size) + size) {
+    jack_midi_data_t *pData = jack_midi_event_reserve(pBuffer, 0, size);
+
+    if (!pData)
+      break; // the JACK buffer is full. Send the rest in the next cycle
+    jack_ringbuffer_read_advance(pRing, sizeof(size));
+    jack_ringbuffer_read(pRing, (char *)pData, size);
+  }
+}
+
+bool GOMidiJackOutPort::Open(unsigned id) {
+  Close();
+
+  mp_RingBuffer = jack_ringbuffer_create(RING_BUFFER_SIZE);
+  if (mp_RingBuffer)
+    mp_JackPort = GOMidiJackClient::getInstance().RegisterPort(
+      this, GetMyNativePortName(), JackPortIsOutput);
+  if (mp_JackPort)
+    m_IsActive = true;
+  else {
+    wxLogError(_("Unable to open the JACK midi output port"));
+    Close();
+  }
+  return GOMidiOutPort::Open(id);
+}
+
+void GOMidiJackOutPort::Close() {
+  m_IsActive = false;
+  if (mp_JackPort) {
+    GOMidiJackClient::getInstance().UnregisterPort(this, mp_JackPort);
+    mp_JackPort = nullptr;
+  }
+  if (mp_RingBuffer) {
+    GOMutexLocker locker(m_WriteMutex);
+
+    jack_ringbuffer_free(mp_RingBuffer);
+    mp_RingBuffer = nullptr;
+  }
+  GOMidiOutPort::Close();
+}
+
+void GOMidiJackOutPort::SendData(std::vector<unsigned char> &msg) {
+  GOMutexLocker locker(m_WriteMutex);
+  const uint32_t size = msg.size();
+
+  if (
+    mp_RingBuffer
+    && jack_ringbuffer_write_space(mp_RingBuffer) >= sizeof(size) + size) {
+    jack_ringbuffer_write(mp_RingBuffer, (const char *)&size, sizeof(size));
+    jack_ringbuffer_write(mp_RingBuffer, (const char *)msg.data(), size);
+  } else
+    wxLogError(_("JACK midi output buffer overflow"));
+}
+
+#endif /* GO_USE_JACK */
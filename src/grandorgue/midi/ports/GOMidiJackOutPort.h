@@ -0,0 +1,53 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOMIDIJACKOUTPORT_H
+#define GOMIDIJACKOUTPORT_H
+
+#if defined(GO_USE_JACK)
+
+#if defined(_WIN32) && !defined(WIN32)
+// see GOSoundJackPort.h
+#define WIN32 1
+#endif
+#include <jack/jack.h>
+#include <jack/ringbuffer.h>
+
+#include "threading/GOMutex.h"
+
+#include "GOMidiJackClient.h"
+#include "GOMidiOutPort.h"
+
+/**
+ * A midi output port of the shared JACK client. The messages are passed to
+ * the JACK process cycle through a lock-free ring buffer
+ */
+class GOMidiJackOutPort : public GOMidiOutPort,
+                          private GOMidiJackClient::Port {
+private:
+  jack_port_t *mp_JackPort = nullptr;
+  jack_ringbuffer_t *mp_RingBuffer = nullptr;
+  // protects the ring buffer from being freed while writing to it
+  GOMutex m_WriteMutex;
+
+  void OnJackProcess(jack_client_t *pClient, jack_nframes_t nFrames) override;
+
+protected:
+  void SendData(std::vector<unsigned char> &msg) override;
+
+public:
+  GOMidiJackOutPort(
+    GOMidiSystem *midi, const wxString &deviceName, const wxString &fullName);
+  ~GOMidiJackOutPort();
+
+  bool Open(unsigned id) override;
+  void Close() override;
+};
+
+#endif /* GO_USE_JACK */
+
+#endif /* GOMIDIJACKOUTPORT_H */
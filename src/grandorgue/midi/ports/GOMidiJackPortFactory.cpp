@@ -0,0 +1,67 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+// wx should be included before windows.h (from jack.h), otherwise it cannot be
+// compiled with mingw
+#include "GOMidiJackPortFactory.h"
+
+#include "GOMidiJackClient.h"
+#include "GOMidiJackInPort.h"
+#include "GOMidiJackOutPort.h"
+#include "GOMidiPortFactory.h"
+
+const wxString GOMidiJackPortFactory::PORT_NAME = wxT("Jack");
+
+#if defined(GO_USE_JACK)
+
+static const wxString IN_DEVICE_NAME = wxT("Native Input");
+static const wxString OUT_DEVICE_NAME = wxT("Native Output");
+
+static bool has_device(
+  const ptr_vector<GOMidiPort> &ports, const wxString &deviceName) {
+  for (const GOMidiPort *pPort : ports)
+    if (
+      pPort
+      && pPort->IsEqualTo(
+        GOMidiJackPortFactory::PORT_NAME, wxEmptyString, deviceName))
+      return true;
+  return false;
+}
+
+#endif /* GO_USE_JACK */
+
+void GOMidiJackPortFactory::addMissingInDevices(
+  GOMidiSystem *midi,
+  const GOPortsConfig &portsConfig,
+  ptr_vector<GOMidiPort> &ports) {
+#if defined(GO_USE_JACK)
+  if (
+    !has_device(ports, IN_DEVICE_NAME)
+    && GOMidiJackClient::getInstance().IsServerRunning())
+    ports.push_back(new GOMidiJackInPort(
+      midi,
+      IN_DEVICE_NAME,
+      GOMidiPortFactory::getInstance().ComposeDeviceName(
+        PORT_NAME, wxEmptyString, IN_DEVICE_NAME)));
+#endif
+}
+
+void GOMidiJackPortFactory::addMissingOutDevices(
+  GOMidiSystem *midi,
+  const GOPortsConfig &portsConfig,
+  ptr_vector<GOMidiPort> &ports) {
+#if defined(GO_USE_JACK)
+  if (
+    !has_device(ports, OUT_DEVICE_NAME)
+    && GOMidiJackClient::getInstance().IsServerRunning())
+    ports.push_back(new GOMidiJackOutPort(
+      midi,
+      OUT_DEVICE_NAME,
+      GOMidiPortFactory::getInstance().ComposeDeviceName(
+        PORT_NAME, wxEmptyString, OUT_DEVICE_NAME)));
+#endif
+}
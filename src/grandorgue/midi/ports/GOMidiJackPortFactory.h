@@ -0,0 +1,38 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOMIDIJACKPORTFACTORY_H
+#define GOMIDIJACKPORTFACTORY_H
+
+#include <wx/string.h>
+
+#include "config/GOPortsConfig.h"
+#include "ptrvector.h"
+
+class GOMidiPort;
+class GOMidiSystem;
+
+/**
+ * Creates the native JACK midi ports. They are available only if GrandOrgue
+ * is built with GO_USE_JACK and a JACK server is running. Otherwise the JACK
+ * midi devices are still accessible with the RtMidi ports
+ */
+class GOMidiJackPortFactory {
+public:
+  static const wxString PORT_NAME;
+
+  static void addMissingInDevices(
+    GOMidiSystem *midi,
+    const GOPortsConfig &portsConfig,
+    ptr_vector<GOMidiPort> &ports);
+  static void addMissingOutDevices(
+    GOMidiSystem *midi,
+    const GOPortsConfig &portsConfig,
+    ptr_vector<GOMidiPort> &ports);
+};
+
+#endif /* GOMIDIJACKPORTFACTORY_H */
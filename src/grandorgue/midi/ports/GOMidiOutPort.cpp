@@ -7,9 +7,16 @@
 
 #include "GOMidiOutPort.h"
 
+#include <algorithm>
+
 #include "midi/GOMidiMap.h"
 #include "midi/GOMidiSystem.h"
-#include "midi/events/GOMidiEvent.h"
+#include "threading/GOMutexLocker.h"
+
+// the speed of a physical midi cable
+static constexpr double MAX_BYTES_PER_SECOND = 3125.0;
+// the number of bytes that may be sent at once after a pause
+static constexpr double MAX_BURST_BYTES = 1024.0;
 
 GOMidiOutPort::GOMidiOutPort(
   GOMidiSystem *midi,
@@ -17,28 +24,126 @@ GOMidiOutPort::GOMidiOutPort(
   const wxString &apiName,
   const wxString &deviceName,
   const wxString &fullName)
-  : GOMidiPort(midi, portName, apiName, deviceName, fullName), m_merger() {}
+  : GOMidiPort(midi, portName, apiName, deviceName, fullName),
+    m_merger(),
+    m_SendingPos(0),
+    m_IsRateLimited(false),
+    m_AvailableBytes(MAX_BURST_BYTES),
+    m_LastRefillTime(std::chrono::steady_clock::now()) {}
 
 GOMidiOutPort::~GOMidiOutPort() {}
 
 bool GOMidiOutPort::Open(unsigned id) {
+  GOMutexLocker locker(m_QueueLock);
+
   GOMidiPort::Open(id);
   m_merger.Clear();
+  m_QueuedEvents.clear();
+  m_QueuedIndices.clear();
   return m_IsActive;
 }
 
+/**
+ * Calculates the key of the control the event changes. The queued event is
+ * replaced with the next event with the same key
+ * @param e the event
+ * @param key the calculated key
+ * @return false if the event must not be replaced, ex. a setup sequence
+ */
+static bool get_coalescing_key(const GOMidiEvent &e, uint64_t &key) {
+  int channel = e.GetChannel();
+  int control = e.GetKey();
+
+  switch (e.GetMidiType()) {
+  case GOMidiEvent::MIDI_NOTE:
+  case GOMidiEvent::MIDI_CTRL_CHANGE:
+  case GOMidiEvent::MIDI_RPN:
+  case GOMidiEvent::MIDI_NRPN:
+  case GOMidiEvent::MIDI_SYSEX_HW_STRING:
+  case GOMidiEvent::MIDI_SYSEX_RODGERS_STOP_CHANGE:
+    break;
+  case GOMidiEvent::MIDI_PGM_CHANGE:
+    // only the last selected program matters
+    control = 0;
+    break;
+  case GOMidiEvent::MIDI_SYSEX_HW_LCD:
+    // the channel is the color of the same display
+    channel = 0;
+    break;
+  default:
+    return false;
+  }
+  key = ((uint64_t)e.GetMidiType() << 40) | ((uint64_t)(channel & 0xFF) << 32)
+    | (uint32_t)control;
+  return true;
+}
+
 void GOMidiOutPort::Send(const GOMidiEvent &e) {
   if (!IsActive())
     return;
   if (GetID() == e.GetDevice() || e.GetDevice() == 0) {
+    GOMutexLocker locker(m_QueueLock);
     GOMidiEvent e1 = e;
+    uint64_t key;
+
     if (!m_merger.Process(e1))
       return;
-    std::vector<std::vector<unsigned char>> msg;
-    e1.ToMidi(msg, m_midi->GetMidiMap());
-    for (unsigned i = 0; i < msg.size(); i++)
-      SendData(msg[i]);
+    if (get_coalescing_key(e1, key)) {
+      auto inserted = m_QueuedIndices.emplace(key, m_QueuedEvents.size());
+
+      if (!inserted.second) {
+        // the control has not been sent yet. The last value wins
+        m_QueuedEvents[inserted.first->second] = e1;
+        return;
+      }
+    }
+    m_QueuedEvents.push_back(e1);
+    m_midi->OnOutEventQueued();
+  }
+}
+
+bool GOMidiOutPort::SendQueued() {
+  if (m_SendingPos >= m_SendingEvents.size()) {
+    // all taken events have been sent. Take the new ones keeping the capacity
+    GOMutexLocker locker(m_QueueLock);
+
+    m_SendingEvents.clear();
+    m_SendingPos = 0;
+    std::swap(m_SendingEvents, m_QueuedEvents);
+    m_QueuedIndices.clear();
+  }
+  if (!IsActive()) {
+    m_SendingPos = m_SendingEvents.size();
+    return false;
+  }
+
+  const bool isRateLimited = m_IsRateLimited.load();
+  const auto now = std::chrono::steady_clock::now();
+
+  m_AvailableBytes = std::min(
+    MAX_BURST_BYTES,
+    m_AvailableBytes
+      + std::chrono::duration<double>(now - m_LastRefillTime).count()
+        * MAX_BYTES_PER_SECOND);
+  m_LastRefillTime = now;
+  while (m_SendingPos < m_SendingEvents.size()) {
+    unsigned nBytes = 0;
+
+    m_SendingEvents[m_SendingPos].ToMidi(m_msgs, m_midi->GetMidiMap());
+    for (const auto &msg : m_msgs)
+      nBytes += msg.size();
+    // a message longer than the burst is sent when the whole burst is allowed
+    if (
+      isRateLimited && nBytes > m_AvailableBytes
+      && m_AvailableBytes < MAX_BURST_BYTES)
+      return true;
+    for (auto &msg : m_msgs)
+      SendData(msg);
+    if (isRateLimited)
+      m_AvailableBytes -= nBytes;
+    m_SendingPos++;
   }
+  return false;
 }
 
 const wxString GOMidiOutPort::GetMyNativePortName() const {
@@ -8,20 +8,52 @@
 #ifndef GOMIDIOUTPORT_H
 #define GOMIDIOUTPORT_H
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
 #include <wx/string.h>
 
 #include "GOMidiPort.h"
 #include "midi/GOMidiOutputMerger.h"
+#include "midi/events/GOMidiEvent.h"
 #include "ptrvector.h"
+#include "threading/GOMutex.h"
 
-class GOMidiEvent;
-
+/**
+ * A midi output port. The events being sent are queued and are really sent by
+ * the midi sending thread. While an event is waiting in the queue, the next
+ * event for the same control replaces it. The sending rate may be limited by
+ * the speed of a physical midi cable
+ */
 class GOMidiOutPort : public GOMidiPort {
 protected:
   GOMidiOutputMerger m_merger;
 
   virtual void SendData(std::vector<unsigned char> &msg) = 0;
 
+private:
+  // protects m_merger and the queue against concurrent senders
+  GOMutex m_QueueLock;
+  // the events waiting for sending
+  std::vector<GOMidiEvent> m_QueuedEvents;
+  // coalescing key -> index in m_QueuedEvents
+  std::unordered_map<uint64_t, unsigned> m_QueuedIndices;
+
+  // The following members are used by the midi sending thread only
+  // the events taken from the queue and being sent
+  std::vector<GOMidiEvent> m_SendingEvents;
+  unsigned m_SendingPos;
+  // the messages of one event. Is reused for avoiding allocations
+  std::vector<std::vector<unsigned char>> m_msgs;
+  // whether the sending rate is limited
+  std::atomic_bool m_IsRateLimited;
+  // the number of bytes that may be sent now without exceeding the rate
+  double m_AvailableBytes;
+  std::chrono::steady_clock::time_point m_LastRefillTime;
+
 public:
   GOMidiOutPort(
     GOMidiSystem *midi,
@@ -36,7 +68,25 @@ public:
 
   virtual bool Open(unsigned id);
 
+  /**
+   * Limits the sending rate to the speed of a DIN midi cable. Is needed for
+   * the devices connected with a DIN cable that lose the messages sent
+   * faster. Is not limited by default
+   */
+  void SetRateLimited(bool isRateLimited) { m_IsRateLimited = isRateLimited; }
+
+  /**
+   * Queues the event for sending
+   * @param e the event to send
+   */
   void Send(const GOMidiEvent &e);
+
+  /**
+   * Sends the queued events as far as the rate limit allows. Is called from
+   * the midi sending thread only
+   * @return whether some events are left because of the rate limit
+   */
+  bool SendQueued();
 };
 
 #endif
@@ -7,6 +7,7 @@
 
 #include "GOMidiPortFactory.h"
 
+#include "GOMidiJackPortFactory.h"
 #include "GOMidiRtPortFactory.h"
 
 static bool hasPortsPopulated = false;
@@ -15,6 +16,9 @@ static std::vector<wxString> portNames;
 const std::vector<wxString> &GOMidiPortFactory::GetPortNames() const {
   if (!hasPortsPopulated) {
     portNames.push_back(GOMidiRtPortFactory::PORT_NAME);
+#if defined(GO_USE_JACK)
+    portNames.push_back(GOMidiJackPortFactory::PORT_NAME);
+#endif
     hasPortsPopulated = true;
   }
   return portNames;
@@ -39,6 +43,8 @@ void GOMidiPortFactory::addMissingInDevices(
   if (portsConfig.IsEnabled(GOMidiRtPortFactory::PORT_NAME))
     GOMidiRtPortFactory::getInstance()->addMissingInDevices(
       midi, portsConfig, ports);
+  if (portsConfig.IsEnabled(GOMidiJackPortFactory::PORT_NAME))
+    GOMidiJackPortFactory::addMissingInDevices(midi, portsConfig, ports);
 }
 
 void GOMidiPortFactory::addMissingOutDevices(
@@ -48,6 +54,8 @@ void GOMidiPortFactory::addMissingOutDevices(
   if (portsConfig.IsEnabled(GOMidiRtPortFactory::PORT_NAME))
     GOMidiRtPortFactory::getInstance()->addMissingOutDevices(
       midi, portsConfig, ports);
+  if (portsConfig.IsEnabled(GOMidiJackPortFactory::PORT_NAME))
+    GOMidiJackPortFactory::addMissingOutDevices(midi, portsConfig, ports);
 }
 
 void GOMidiPortFactory::terminate() {
@@ -24,7 +24,8 @@ GOMidiRtInPort::GOMidiRtInPort(
     deviceName,
     fullName),
     m_api(api),
-    m_port(NULL) {}
+    m_port(NULL),
+    m_LastTimeNs(0) {}
 
 GOMidiRtInPort::~GOMidiRtInPort() { Close(true); }
 
@@ -63,6 +64,7 @@ bool GOMidiRtInPort::Open(unsigned id, int channel_shift) {
     wxString error = wxString::FromAscii(e.getMessage().c_str());
     wxLogError(_("RtMidi error: %s"), error.c_str());
   }
+  m_LastTimeNs = 0;
   return GOMidiInPort::Open(id, channel_shift);
 }
 
@@ -92,10 +94,24 @@ void GOMidiRtInPort::Close(bool isToFreePort) {
   }
 }
 
+// if the accumulated deltas differ from the real time more, resync with it
+static constexpr int64_t MAX_DELTA_DRIFT_NS = 20000000;
+
+int64_t GOMidiRtInPort::CalcMessageTime(double deltaTime) {
+  const int64_t nowNs = go_steady_time_ns();
+  int64_t timeNs = m_LastTimeNs + int64_t(deltaTime * 1e9);
+
+  // the first message or the accumulated deltas have drifted away
+  if (!m_LastTimeNs || timeNs > nowNs || nowNs - timeNs > MAX_DELTA_DRIFT_NS)
+    timeNs = nowNs;
+  m_LastTimeNs = timeNs;
+  return timeNs;
+}
+
 void GOMidiRtInPort::MIDICallback(
   double timeStamp, std::vector<unsigned char> *msg, void *userData) {
   GOMidiRtInPort *port = (GOMidiRtInPort *)userData;
 
   if (port->m_IsActive && port->m_port)
-    port->Receive(*msg);
+    port->Receive(*msg, port->CalcMessageTime(timeStamp));
 }
@@ -15,9 +15,20 @@ class GOMidiRtInPort : public GOMidiInPort {
 protected:
   const RtMidi::Api m_api;
   RtMidiIn *m_port;
+  // the steady clock time of the previous received message in ns. 0 - none
+  int64_t m_LastTimeNs;
 
   void Close(bool isToFreePort);
 
+  /**
+   * Calculates the steady clock time of receiving the message from the delta
+   * time reported by RtMidi. The deltas are more accurate than the time of the
+   * callback because RtMidi may deliver several messages at once
+   * @param deltaTime seconds since the previous message
+   * @return the time of receiving the message in ns
+   */
+  int64_t CalcMessageTime(double deltaTime);
+
   static void MIDICallback(
     double timeStamp, std::vector<unsigned char> *msg, void *userData);
 
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -10,6 +10,7 @@
 #include <wx/intl.h>
 
 #include "GOAlloc.h"
+#include "GOHash.h"
 
 void GOCacheObject::SetGroupAndPrefix(
   const wxString &group, const wxString &keyPrefix) {
@@ -37,6 +38,13 @@ const wxString GOCacheObject::GenerateMessage(const wxString &srcMsg) const {
   return res;
 }
 
+GOHashType GOCacheObject::GetCacheHash() const {
+  GOHash hash;
+
+  UpdateHash(hash);
+  return hash.getHash();
+}
+
 bool GOCacheObject::InitWithoutExc() {
   InitBeforeLoad();
   try {
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -17,6 +17,7 @@ class GOCacheWriter;
 class GOFileStore;
 class GOHash;
 class GOMemoryPool;
+typedef struct _GOHashType GOHashType;
 
 class GOCacheObject {
 private:
@@ -70,6 +71,12 @@ public:
 
   virtual bool SaveCache(GOCacheWriter &cache) const = 0;
   virtual void UpdateHash(GOHash &hash) const = 0;
+
+  /**
+   * Returns the hash of all the settings the cached data depends on. Objects
+   * with equal hashes have equal cached data
+   */
+  GOHashType GetCacheHash() const;
   virtual const wxString &GetLoadTitle() const = 0;
 
   // Returns the message string prefixed with group and keyPrefix
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -38,6 +38,9 @@ GOCoupler::GOCoupler(
     m_KeyVelocity(0),
     m_InternalVelocity(0),
     m_OutVelocity(0),
+    m_PressedKeys(),
+    m_InternalKeys(),
+    m_OutKeys(),
     m_CurrentTone(-1),
     m_LastTone(-1),
     m_FirstMidiNote(0),
@@ -53,6 +56,9 @@ void GOCoupler::PreparePlayback() {
 
   m_KeyVelocity.resize(src->GetLogicalKeyCount());
   std::fill(m_KeyVelocity.begin(), m_KeyVelocity.end(), 0);
+  m_PressedKeys.Clear();
+  m_InternalKeys.Clear();
+  m_OutKeys.Clear();
 
   if (m_FirstMidiNote > src->GetFirstLogicalKeyMIDINoteNumber())
     m_FirstLogicalKey
@@ -274,6 +280,7 @@ void GOCoupler::SetOut(int noteNumber, unsigned velocity) {
   if (m_InternalVelocity[note] == velocity)
     return;
   m_InternalVelocity[note] = velocity;
+  m_InternalKeys.Set(note, velocity);
 
   if (!IsEngaged())
     return;
@@ -281,6 +288,7 @@ void GOCoupler::SetOut(int noteNumber, unsigned velocity) {
   if (newstate)
     newstate--;
   m_OutVelocity[note] = newstate;
+  m_OutKeys.Set(note, newstate);
 
   GOManual *dest = r_OrganModel.GetManual(m_DestinationManual);
 
@@ -303,20 +311,12 @@ unsigned GOCoupler::GetInternalState(int noteNumber) {
 **/
 int GOCoupler::GetNextBasMelPressedKey(int afterKey) const {
   int nextNote = -1; // no key is pressed
-  const int keysCount = (int)m_KeyVelocity.size();
-
-  if (m_CouplerType == COUPLER_BASS) {
-    for (nextNote = afterKey + 1; nextNote < keysCount; nextNote++)
-      if (m_KeyVelocity[nextNote] > 0)
-        break;
-    if (nextNote == keysCount)
-      nextNote = -1;
-  } else if (m_CouplerType == COUPLER_MELODY) {
-    for (nextNote = (afterKey >= 0 ? afterKey : keysCount) - 1; nextNote >= 0;
-         nextNote--)
-      if (m_KeyVelocity[nextNote] > 0)
-        break;
-  }
+
+  if (m_CouplerType == COUPLER_BASS)
+    nextNote = m_PressedKeys.FindFirst(afterKey + 1);
+  else if (m_CouplerType == COUPLER_MELODY)
+    nextNote = afterKey >= 0 ? m_PressedKeys.FindLast(afterKey)
+                             : m_PressedKeys.FindLast();
   return nextNote;
 }
 
@@ -408,6 +408,7 @@ void GOCoupler::SetKey(
   if (m_KeyVelocity[note] == velocity)
     return;
   m_KeyVelocity[note] = velocity;
+  m_PressedKeys.Set(note, velocity);
   ChangeKey(note, velocity);
 }
 
@@ -417,15 +418,17 @@ void GOCoupler::OnDrawstopStateChanged(bool on) {
   else {
     GOManual *dest = r_OrganModel.GetManual(m_DestinationManual);
 
-    for (unsigned i = 0; i < m_InternalVelocity.size(); i++) {
+    // only the keys with a nonzero internal or output state may change
+    (m_InternalKeys | m_OutKeys).ForEach([&](unsigned i) {
       unsigned newstate = on ? m_InternalVelocity[i] : 0;
       if (newstate > 0)
         newstate--;
       if (m_OutVelocity[i] != newstate) {
         m_OutVelocity[i] = newstate;
+        m_OutKeys.Set(i, newstate);
         dest->SetKeyState(i, m_OutVelocity[i], m_CouplerIndexInDest);
       }
-    }
+    });
   }
 }
 
@@ -437,10 +440,8 @@ void GOCoupler::RefreshState() {
   else {
     GOManual *dest = r_OrganModel.GetManual(m_DestinationManual);
 
-    for (unsigned l = m_OutVelocity.size(), i = 0; i < l; i++)
-      // check if the key is set. Otherwise propagating is not necessary
-      if (m_OutVelocity[i])
-        dest->PropagateKeyToCouplers(i);
+    // only the set keys need propagating
+    m_OutKeys.ForEach([dest](unsigned i) { dest->PropagateKeyToCouplers(i); });
   }
 }
 
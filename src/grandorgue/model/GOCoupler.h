@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "GODrawstop.h"
+#include "GOKeyMask.h"
 
 class GOConfigReader;
 class GOConfigWriter;
@@ -40,6 +41,12 @@ private:
   std::vector<unsigned> m_InternalVelocity;
   /* Current ouput state */
   std::vector<unsigned> m_OutVelocity;
+  /* The keys with nonzero m_KeyVelocity */
+  GOKeyMask m_PressedKeys;
+  /* The keys with nonzero m_InternalVelocity */
+  GOKeyMask m_InternalKeys;
+  /* The keys with nonzero m_OutVelocity */
+  GOKeyMask m_OutKeys;
   int m_CurrentTone;
   int m_LastTone;
   int m_FirstMidiNote;
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -164,7 +164,7 @@ void GODrawstop::SetResultState(bool resState) {
     // must be before calling m_ControlledDrawstops[i]->Update();
     OnDrawstopStateChanged(resState);
     for (auto *pDrawstop : m_ControlledDrawstops)
-      pDrawstop->Update(); // reads IsEngaged()
+      r_OrganModel.UpdateDrawstop(pDrawstop); // reads IsEngaged()
   }
 }
 
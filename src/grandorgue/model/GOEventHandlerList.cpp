@@ -20,6 +20,7 @@ void GOEventHandlerList::Cleanup() {
   m_ControlChangedHandlers.Clear();
   m_MidiObjects.Clear();
   m_MidiEventHandlers.Clear();
+  m_MidiEventHandlersVersion++;
   m_LifecycleListeners.Clear();
   m_SaveableObjects.Clear();
 }
@@ -65,6 +65,8 @@ private:
   UPVector<GOEventHandler> m_MidiEventHandlers;
   UPVector<GOOrganLifecycleListener> m_LifecycleListeners;
   UPVector<GOSaveableObject> m_SaveableObjects;
+  // is changed every time when the midi event handlers are changed
+  unsigned m_MidiEventHandlersVersion = 0;
 
 public:
   const std::vector<GOCacheObject *> &GetCacheObjects() const {
@@ -83,6 +85,9 @@ public:
   const std::vector<GOEventHandler *> &GetMidiEventHandlers() const {
     return m_MidiEventHandlers.AsVector();
   }
+  unsigned GetMidiEventHandlersVersion() const {
+    return m_MidiEventHandlersVersion;
+  }
   const std::vector<GOOrganLifecycleListener *> &GetLifecycleListeners() const {
     return m_LifecycleListeners.AsVector();
   }
@@ -124,10 +129,12 @@ public:
 
   void RegisterEventHandler(GOEventHandler *handler) {
     m_MidiEventHandlers.Add(handler);
+    m_MidiEventHandlersVersion++;
   }
 
   void UnRegisterEventHandler(GOEventHandler *handler) {
     m_MidiEventHandlers.Remove(handler);
+    m_MidiEventHandlersVersion++;
   }
 
   void RegisterLifecycleListener(GOOrganLifecycleListener *handler) {
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOKEYMASK_H
+#define GOKEYMASK_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+/**
+ * A fixed size set of key indices stored as a bit mask. It allows to find
+ * the lowest/highest keys and to iterate over the set keys without scanning
+ * all keys of a manual
+ */
+class GOKeyMask {
+public:
+  // is enough for the logical keys of any manual
+  static constexpr unsigned MAX_KEYS = 256;
+
+private:
+  static constexpr unsigned WORD_BITS = 64;
+  static constexpr unsigned N_WORDS = MAX_KEYS / WORD_BITS;
+
+  std::array<uint64_t, N_WORDS> m_words;
+
+  static uint64_t bit(unsigned key) {
+    return uint64_t(1) << (key % WORD_BITS);
+  }
+
+public:
+  GOKeyMask() : m_words{} {}
+
+  void Clear() { m_words.fill(0); }
+
+  bool IsEmpty() const {
+    for (uint64_t word : m_words)
+      if (word)
+        return false;
+    return true;
+  }
+
+  bool Test(unsigned key) const {
+    return key < MAX_KEYS && (m_words[key / WORD_BITS] & bit(key));
+  }
+
+  void Set(unsigned key, bool isSet) {
+    if (key < MAX_KEYS) {
+      if (isSet)
+        m_words[key / WORD_BITS] |= bit(key);
+      else
+        m_words[key / WORD_BITS] &= ~bit(key);
+    }
+  }
+
+  /**
+   * Returns the lowest set key not less than fromKey or -1 if there is no one
+   */
+  int FindFirst(int fromKey = 0) const {
+    if (fromKey < 0)
+      fromKey = 0;
+    for (unsigned w = fromKey / WORD_BITS; w < N_WORDS; w++) {
+      uint64_t word = m_words[w];
+
+      if (w == unsigned(fromKey) / WORD_BITS)
+        word &= ~uint64_t(0) << (fromKey % WORD_BITS);
+      if (word)
+        return w * WORD_BITS + std::countr_zero(word);
+    }
+    return -1;
+  }
+
+  /**
+   * Returns the highest set key less than beforeKey or -1 if there is no one
+   */
+  int FindLast(int beforeKey = MAX_KEYS) const {
+    if (beforeKey > int(MAX_KEYS))
+      beforeKey = MAX_KEYS;
+    for (int w = (beforeKey - 1) / int(WORD_BITS); beforeKey > 0 && w >= 0;
+         w--) {
+      uint64_t word = m_words[w];
+      const unsigned nBits = beforeKey - w * WORD_BITS;
+
+      if (nBits < WORD_BITS)
+        word &= (uint64_t(1) << nBits) - 1;
+      if (word)
+        return (w + 1) * WORD_BITS - 1 - std::countl_zero(word);
+    }
+    return -1;
+  }
+
+  GOKeyMask &operator|=(const GOKeyMask &other) {
+    for (unsigned w = 0; w < N_WORDS; w++)
+      m_words[w] |= other.m_words[w];
+    return *this;
+  }
+
+  GOKeyMask operator|(const GOKeyMask &other) const {
+    GOKeyMask res(*this);
+
+    res |= other;
+    return res;
+  }
+
+  /**
+   * Calls f(key) for each set key in ascending order. f may modify the mask
+   * for the keys already visited
+   */
+  template <typename F> void ForEach(F f) const {
+    for (unsigned w = 0; w < N_WORDS; w++)
+      for (uint64_t word = m_words[w]; word; word &= word - 1)
+        f(w * WORD_BITS + std::countr_zero(word));
+  }
+};
+
+#endif /* GOKEYMASK_H */
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -12,10 +12,12 @@
 #include "combinations/control/GODivisionalButtonControl.h"
 #include "config/GOConfig.h"
 #include "config/GOConfigReader.h"
+#include "threading/GOMutexLocker.h"
 
 #include "GOCoupler.h"
 #include "GODocument.h"
 #include "GOOrganModel.h"
+#include "GORank.h"
 #include "GOStop.h"
 #include "GOSwitch.h"
 #include "GOTremulant.h"
@@ -32,8 +34,10 @@ GOManual::GOManual(
     m_KeyVelocity(0),
     m_RemoteVelocity(),
     m_Velocity(),
+    m_SoundingKeys(),
     m_DivisionKeyVelocities(),
     m_KeyVelocitiesByCoupler(),
+    m_ArePipeRoutesValid(false),
     m_manual_number(manualNumber),
     m_ShortName(wxString::Format(WX_ODF_OBJ_NUM_FMT, manualNumber)),
     m_MidiContext(m_ShortName, m_ShortName, pParentContext),
@@ -82,6 +86,7 @@ void GOManual::Resize() {
   m_KeyVelocitiesByCoupler.resize(m_nb_logical_keys);
   for (unsigned i = 0; i < m_KeyVelocitiesByCoupler.size(); i++)
     m_KeyVelocitiesByCoupler[i].resize(m_InputCouplers.size());
+  InvalidatePipeRoutes();
 }
 
 void GOManual::Init(
@@ -169,7 +174,10 @@ void GOManual::Load(GOConfigReader &cfg, const wxString &group) {
   m_stops.resize(0);
   for (unsigned i = 0; i < nb_stops; i++) {
     GOStop *pStop = new GOStop(
-      r_OrganModel, GetFirstLogicalKeyMIDINoteNumber(), &m_MidiContextStops);
+      r_OrganModel,
+      *this,
+      GetFirstLogicalKeyMIDINoteNumber(),
+      &m_MidiContextStops);
     unsigned localNumber = i + 1;
 
     pStop->SetHardName(wxString::Format(WX_ODF_OBJ_NUM_FMT, localNumber));
@@ -263,8 +271,20 @@ void GOManual::SetDivisionKeyState(unsigned keyIndex, unsigned velocity) {
     return;
   m_DivisionKeyVelocities[keyIndex] = velocity;
 
-  for (unsigned i = 0; i < m_stops.size(); i++)
-    m_stops[i]->SetKeyState(keyIndex + 1, velocity);
+  {
+    GOMutexLocker locker(m_PipeRoutesLock);
+
+    if (!m_ArePipeRoutesValid)
+      BuildPipeRoutes();
+    for (unsigned l = m_PipeRouteStarts[keyIndex + 1],
+                  i = m_PipeRouteStarts[keyIndex];
+         i < l;
+         i++) {
+      const GOStop::PipeRoute &route = m_PipeRoutes[i];
+
+      route.p_rank->SetPipeState(route.m_PipeIndex, velocity, route.m_StopID);
+    }
+  }
 
   int midi_note = keyIndex + m_first_accessible_key_midi_note_nb
     - m_first_accessible_logical_key_nb + 1;
@@ -272,6 +292,23 @@ void GOManual::SetDivisionKeyState(unsigned keyIndex, unsigned velocity) {
     SendDivisionMidiKey(midi_note, velocity);
 }
 
+void GOManual::BuildPipeRoutes() {
+  const unsigned nKeys = m_DivisionKeyVelocities.size();
+
+  // the stops change their states under m_PipeRoutesLock, so they are
+  // consistent with the routes built here
+  m_ArePipeRoutesValid = true;
+  m_PipeRoutes.clear();
+  m_PipeRouteStarts.resize(nKeys + 1);
+  for (unsigned keyIndex = 0; keyIndex < nKeys; keyIndex++) {
+    m_PipeRouteStarts[keyIndex] = m_PipeRoutes.size();
+    for (const GOStop *pStop : m_stops)
+      if (pStop->IsEngaged())
+        pStop->AddPipeRoutes(keyIndex + 1, m_PipeRoutes);
+  }
+  m_PipeRouteStarts[nKeys] = m_PipeRoutes.size();
+}
+
 void GOManual::PropagateKeyToCouplers(unsigned keyIndex) {
   if (keyIndex < m_Velocity.size()) {
     auto &keyVelocities = m_KeyVelocitiesByCoupler[keyIndex];
@@ -298,6 +335,7 @@ void GOManual::SetKeyState(
     if (m_RemoteVelocity[keyIndex] < m_KeyVelocitiesByCoupler[keyIndex][i])
       m_RemoteVelocity[keyIndex] = m_KeyVelocitiesByCoupler[keyIndex][i];
   }
+  m_SoundingKeys.Set(keyIndex, m_Velocity[keyIndex]);
 
   PropagateKeyToCouplers(keyIndex);
   SetDivisionKeyState(
@@ -336,8 +374,10 @@ void GOManual::SetUnisonOff(bool on) {
     if (--m_UnisonOff)
       return;
   }
-  for (unsigned note = 0; note < m_Velocity.size(); note++)
+  // m_RemoteVelocity never exceeds m_Velocity, so the silent keys are unchanged
+  m_SoundingKeys.ForEach([this, on](unsigned note) {
     SetDivisionKeyState(note, on ? m_RemoteVelocity[note] : m_Velocity[note]);
+  });
 }
 
 unsigned GOManual::GetLogicalKeyCount() { return m_nb_logical_keys; }
@@ -476,6 +516,7 @@ void GOManual::PreparePlayback() {
   m_UnisonOff = 0;
   for (unsigned i = 0; i < m_Velocity.size(); i++)
     m_Velocity[i] = 0;
+  m_SoundingKeys.Clear();
   for (unsigned i = 0; i < m_DivisionKeyVelocities.size(); i++)
     m_DivisionKeyVelocities[i] = 0;
   for (unsigned i = 0; i < m_RemoteVelocity.size(); i++)
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -10,6 +10,8 @@
 
 #include <wx/string.h>
 
+#include <atomic>
+
 #include "ptrvector.h"
 
 #include "combinations/control/GOCombinationButtonSet.h"
@@ -17,12 +19,15 @@
 #include "control/GOControl.h"
 #include "midi/objects/GOMidiObjectContext.h"
 #include "midi/objects/GOMidiObjectWithDivision.h"
+#include "threading/GOMutex.h"
+
+#include "GOKeyMask.h"
+#include "GOStop.h"
 
 class GOConfigReader;
 class GOCoupler;
 class GODivisionalButtonControl;
 class GOOrganModel;
-class GOStop;
 class GOSwitch;
 class GOTremulant;
 
@@ -40,8 +45,20 @@ private:
   /* Internal state affected by couplers */
   std::vector<unsigned> m_RemoteVelocity;
   std::vector<unsigned> m_Velocity;
+  /* The keys with nonzero m_Velocity */
+  GOKeyMask m_SoundingKeys;
   std::vector<unsigned> m_DivisionKeyVelocities;
   std::vector<std::vector<unsigned>> m_KeyVelocitiesByCoupler;
+  /*
+   * The pipes of the engaged stops for each division key. The pipes of the key
+   * i are m_PipeRoutes[m_PipeRouteStarts[i] .. m_PipeRouteStarts[i + 1])
+   */
+  std::vector<GOStop::PipeRoute> m_PipeRoutes;
+  std::vector<unsigned> m_PipeRouteStarts;
+  // is reset when a stop is engaged or disengaged
+  std::atomic_bool m_ArePipeRoutesValid;
+  // protects the routes from being rebuilt while a key is being set
+  GOMutex m_PipeRoutesLock;
   GOMidiReceiver::KeyMap m_MidiKeyMap;
   unsigned m_manual_number;
   wxString m_ShortName;
@@ -85,6 +102,8 @@ private:
    * @param velocity
    */
   void SetDivisionKeyState(unsigned keyIndex, unsigned velocity);
+  // Builds the pipe routes from the engaged stops
+  void BuildPipeRoutes();
 
   void AbortPlayback() override;
   void PreparePlayback() override;
@@ -137,6 +156,23 @@ public:
    * @param couplerID
    */
   void SetKeyState(unsigned keyIndex, unsigned velocity, unsigned couplerID);
+  /**
+   * Returns the key state passed to the stops
+   * @param keyIndex the key index started with 0
+   * @return the velocity. 0 means released
+   */
+  unsigned GetDivisionKeyVelocity(unsigned keyIndex) const {
+    return keyIndex < m_DivisionKeyVelocities.size()
+      ? m_DivisionKeyVelocities[keyIndex]
+      : 0;
+  }
+  // Must be called when the set of the engaged stops is changed
+  void InvalidatePipeRoutes() { m_ArePipeRoutesValid = false; }
+  /*
+   * Must be held while a stop is engaged or disengaged, so a key is routed
+   * either before or after the stop sets its pipe states
+   */
+  GOMutex &GetPipeRoutesLock() { return m_PipeRoutesLock; }
 
   /**
    * Set the note state (pressed, released), It is called from the MIDI receiver
@@ -7,12 +7,15 @@
 
 #include "GOOrganModel.h"
 
+#include <algorithm>
+
 #include <wx/intl.h>
 
 #include "combinations/control/GOGeneralButtonControl.h"
 #include "config/GOConfig.h"
 #include "config/GOConfigReader.h"
 #include "control/GOPistonControl.h"
+#include "loader/GOObjectParallelProcessor.h"
 #include "midi/objects/GOMidiObjectContext.h"
 #include "modification/GOModificationListener.h"
 
@@ -48,6 +51,7 @@ GOOrganModel::GOOrganModel(GOConfig &config)
     m_CombinationsStoreNonDisplayedDrawstops(false),
     m_RootPipeConfigNode(nullptr, this, nullptr),
     m_OrganModelModified(false),
+    m_DrawstopUpdatesDeferDepth(0),
     m_FirstManual(0),
     m_ODFManualCount(0),
     m_ODFRankCount(0) {
@@ -146,15 +150,34 @@ void GOOrganModel::Load(GOConfigReader &cfg) {
 
   m_ODFRankCount = cfg.ReadInteger(
     ODFSetting, WX_ORGAN, wxT("NumberOfRanks"), 0, 999, false);
+
+  // The ranks are loaded in three phases. The rank objects and their pipe
+  // objects are created serially, so all object ids and registration orders
+  // are the same as in a serial loading. Then the pipe settings, that are
+  // the most of the ODF, are parsed in parallel. At last the pipes are linked
+  // to the model serially in the rank order
+  std::vector<GORank *> odfRanks;
+
   for (unsigned i = 0; i < m_ODFRankCount; i++) {
     GORank *pRank = new GORank(*this);
     unsigned num = i + 1;
 
     pRank->SetContext(&MIDI_CONTEXT_RANKS);
     set_name_for_context(pRank, num);
-    pRank->Load(cfg, wxString::Format(wxT("Rank%03d"), num), -1);
+    pRank->LoadWithoutPipes(cfg, wxString::Format(wxT("Rank%03d"), num), -1);
     m_ranks.push_back(pRank);
+    odfRanks.push_back(pRank);
   }
+  // The pipes being parsed read the cached effective values of their ranks,
+  // windchests and the organ. Computing them before prevents the parallel
+  // tasks from computing them concurrently
+  for (GORank *pRank : odfRanks)
+    pRank->GetPipeConfig().ValidateEffectiveValues();
+  GOObjectParallelProcessor<GORank>(
+    odfRanks, [&cfg](GORank *pRank) { pRank->ParsePipes(cfg); })
+    .Run(m_config.LoadConcurrency());
+  for (GORank *pRank : odfRanks)
+    pRank->LinkPipes();
 
   // Switches must be loaded before manuals because manuals reference to
   // switches
@@ -251,6 +274,36 @@ void GOOrganModel::SetOrganModelModified(bool modified) {
     m_ModificationProxy.OnIsModifiedChanged(modified);
 }
 
+GOOrganModel::DeferredDrawstopUpdates::DeferredDrawstopUpdates(
+  GOOrganModel &model)
+  : r_model(model) {
+  r_model.m_DrawstopUpdatesDeferDepth++;
+}
+
+GOOrganModel::DeferredDrawstopUpdates::~DeferredDrawstopUpdates() {
+  if (--r_model.m_DrawstopUpdatesDeferDepth)
+    return;
+
+  std::vector<GODrawstop *> drawstops;
+
+  // the updates may change other drawstops. They are updated immediately now
+  drawstops.swap(r_model.m_DeferredDrawstopUpdates);
+  for (GODrawstop *pDrawstop : drawstops)
+    pDrawstop->Update();
+}
+
+void GOOrganModel::UpdateDrawstop(GODrawstop *pDrawstop) {
+  if (!m_DrawstopUpdatesDeferDepth)
+    pDrawstop->Update();
+  else if (
+    std::find(
+      m_DeferredDrawstopUpdates.begin(),
+      m_DeferredDrawstopUpdates.end(),
+      pDrawstop)
+    == m_DeferredDrawstopUpdates.end())
+    m_DeferredDrawstopUpdates.push_back(pDrawstop);
+}
+
 void GOOrganModel::UpdateTremulant(GOTremulant *tremulant) {
   for (unsigned i = 0; i < m_windchests.size(); i++)
     m_windchests[i]->UpdateTremulant(tremulant);
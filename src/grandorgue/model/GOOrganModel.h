@@ -9,6 +9,7 @@
 #define GOORGANMODEL_H
 
 #include <set>
+#include <vector>
 
 #include "ptrvector.h"
 
@@ -26,6 +27,7 @@
 class GOConfig;
 class GOConfigReader;
 class GODivisionalCoupler;
+class GODrawstop;
 class GOEnclosure;
 class GOGeneralButtonControl;
 class GOManual;
@@ -58,6 +60,11 @@ private:
 
   bool m_OrganModelModified;
 
+  // the number of existing DeferredDrawstopUpdates objects
+  unsigned m_DrawstopUpdatesDeferDepth;
+  // the drawstops to update when the last DeferredDrawstopUpdates ends
+  std::vector<GODrawstop *> m_DeferredDrawstopUpdates;
+
   /**
    * Walks across all manuals with divisional coupler engaged and returns the
    *   set of manuals where the divisional with the same number should be pushed
@@ -101,6 +108,22 @@ protected:
     GOButtonControl *buttonToLight, int manualIndexOnlyFor) override;
 
 public:
+  /**
+   * While an object of this class exists, the drawstops controlled by other
+   * drawstops (ex. switches with a function) are not updated on every change
+   * of the controlling drawstops but only once when the outermost object is
+   * destroyed. It avoids a switch being evaluated many times with transient
+   * states while a combination is applied
+   */
+  class DeferredDrawstopUpdates {
+  private:
+    GOOrganModel &r_model;
+
+  public:
+    DeferredDrawstopUpdates(GOOrganModel &model);
+    ~DeferredDrawstopUpdates();
+  };
+
   GOOrganModel(GOConfig &config);
   virtual ~GOOrganModel();
 
@@ -147,6 +170,11 @@ public:
     m_ModificationProxy.SetModificationListener(listener);
   }
 
+  /**
+   * Calls pDrawstop->Update() now or, if the updates are deferred, when the
+   * last DeferredDrawstopUpdates object ends
+   */
+  void UpdateDrawstop(GODrawstop *pDrawstop);
   void UpdateTremulant(GOTremulant *tremulant);
   void UpdateVolume();
 
@@ -41,9 +41,31 @@ public:
   GOPipe(
     GOEventHandlerList *handlerList, GORank *rank, unsigned midi_key_number);
   virtual ~GOPipe();
-  virtual void Load(
-    GOConfigReader &cfg, const wxString &group, const wxString &prefix)
-    = 0;
+
+  /**
+   * Reads the pipe settings from the ODF/CMB. Does not register the pipe
+   *   anywhere in the organ model, so it may be called concurrently for
+   *   different pipes
+   * @param cfg the config reader
+   * @param group the ODF group of the rank
+   * @param prefix the ODF key prefix of the pipe
+   */
+  virtual void ParseOdf(
+    GOConfigReader &cfg, const wxString &group, const wxString &prefix) {}
+
+  /**
+   * Registers the pipe read by ParseOdf in the organ model. Must be called
+   *   from the main thread in the pipe order, so all the registration lists
+   *   are the same as for a serial loading
+   */
+  virtual void LinkToModel() {}
+
+  void Load(
+    GOConfigReader &cfg, const wxString &group, const wxString &prefix) {
+    ParseOdf(cfg, group, prefix);
+    LinkToModel();
+  }
+
   /**
    * Called from GORank when a user presses the key
    * @param velocity the velocity value of the midi event
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -71,7 +71,18 @@ void GORank::Init(
   Resize();
 }
 
+static wxString pipe_prefix(unsigned pipeIndex) {
+  return wxString::Format(wxT("Pipe%03u"), pipeIndex + 1);
+}
+
 void GORank::Load(
+  GOConfigReader &cfg, const wxString &group, int defaultFirstMidiNoteNumber) {
+  LoadWithoutPipes(cfg, group, defaultFirstMidiNoteNumber);
+  ParsePipes(cfg);
+  LinkPipes();
+}
+
+void GORank::LoadWithoutPipes(
   GOConfigReader &cfg, const wxString &group, int defaultFirstMidiNoteNumber) {
   GOMidiSendingObject::Load(
     cfg, group, cfg.ReadString(ODFSetting, group, wxT("Name"), true));
@@ -110,9 +121,7 @@ void GORank::Load(
 
   m_Pipes.clear();
   for (unsigned i = 0; i < number_of_logical_pipes; i++) {
-    wxString buffer;
-    buffer.Printf(wxT("Pipe%03u"), i + 1);
-    wxString name = cfg.ReadStringTrim(ODFSetting, group, buffer);
+    wxString name = cfg.ReadStringTrim(ODFSetting, group, pipe_prefix(i));
     if (name == wxT("DUMMY")) {
       m_Pipes.push_back(
         new GODummyPipe(&r_OrganModel, this, m_FirstMidiNoteNumber + i));
@@ -130,12 +139,21 @@ void GORank::Load(
         m_MaxVolume,
         m_RetuneRank));
     }
-    m_Pipes[i]->Load(cfg, group, buffer);
   }
   m_PipeConfig.SetName(GetName());
   Resize();
 }
 
+void GORank::ParsePipes(GOConfigReader &cfg) {
+  for (unsigned l = m_Pipes.size(), i = 0; i < l; i++)
+    m_Pipes[i]->ParseOdf(cfg, m_group, pipe_prefix(i));
+}
+
+void GORank::LinkPipes() {
+  for (GOPipe *pPipe : m_Pipes)
+    pPipe->LinkToModel();
+}
+
 void GORank::SaveMidiObject(
   GOConfigWriter &cfg, const wxString &group, GOMidiMap &midiMap) const {
   GOMidiSendingObject::SaveMidiObject(cfg, group + wxT("Rank"), midiMap);
@@ -75,6 +75,26 @@ public:
   using GOMidiObject::Load; // Avoiding a compilation warning
   void Load(
     GOConfigReader &cfg, const wxString &group, int defaultFirstMidiNoteNumber);
+
+  /**
+   * The first phase of Load(): loads the rank itself and creates the pipe
+   *   objects without reading their settings. Must be called from the main
+   *   thread
+   */
+  void LoadWithoutPipes(
+    GOConfigReader &cfg, const wxString &group, int defaultFirstMidiNoteNumber);
+  /**
+   * The second phase of Load(): reads the settings of all pipes. Does not
+   *   modify the organ model, so it may be called for different ranks
+   *   concurrently
+   */
+  void ParsePipes(GOConfigReader &cfg);
+  /**
+   * The last phase of Load(): registers the pipes in the organ model. Must be
+   *   called from the main thread in the rank order
+   */
+  void LinkPipes();
+
   void AddPipe(GOPipe *pipe);
   unsigned RegisterStop(GOStop *stop);
   void SetPipeState(int pipeIndex, unsigned velocity, unsigned stopID);
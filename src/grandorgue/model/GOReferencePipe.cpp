@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -24,7 +24,7 @@ GOReferencePipe::GOReferencePipe(
     m_ReferenceID(0),
     m_Filename() {}
 
-void GOReferencePipe::Load(
+void GOReferencePipe::ParseOdf(
   GOConfigReader &cfg, const wxString &group, const wxString &prefix) {
   m_Filename = cfg.ReadStringTrim(ODFSetting, group, prefix);
   if (!m_Filename.StartsWith(wxT("REF:")))
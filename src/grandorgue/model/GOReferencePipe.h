@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -28,7 +28,8 @@ private:
 public:
   GOReferencePipe(GOOrganModel *model, GORank *rank, unsigned midi_key_number);
 
-  void Load(GOConfigReader &cfg, const wxString &group, const wxString &prefix)
+  void ParseOdf(
+    GOConfigReader &cfg, const wxString &group, const wxString &prefix)
     override;
 };
 
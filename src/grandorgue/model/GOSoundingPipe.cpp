@@ -213,12 +213,11 @@ void GOSoundingPipe::LoadReleaseFileInfo(
   m_ReleaseFileInfos.push_back(rinfo);
 }
 
-void GOSoundingPipe::Load(
+void GOSoundingPipe::ParseOdf(
   GOConfigReader &cfg, const wxString &group, const wxString &prefix) {
   SetGroupAndPrefix(group, prefix);
-  p_OrganModel->RegisterCacheObject(this);
   m_Filename = cfg.ReadStringTrim(ODFSetting, group, prefix);
-  m_PipeConfigNode.Load(cfg, group, prefix);
+  m_PipeConfigNode.ParseOdf(cfg, group, prefix);
   m_HarmonicNumber = cfg.ReadInteger(
     ODFSetting,
     group,
@@ -248,7 +247,6 @@ void GOSoundingPipe::Load(
   m_RetunePipe = cfg.ReadBoolean(
     ODFSetting, group, prefix + wxT("AcceptsRetuning"), false, m_RetunePipe);
   UpdateAmplitude();
-  p_OrganModel->GetWindchest(m_WindchestN - 1)->AddPipe(this);
 
   unsigned attack_count = cfg.ReadInteger(
     ODFSetting, group, prefix + wxT("AttackCount"), 0, 100, false, 0);
@@ -282,6 +280,12 @@ void GOSoundingPipe::Load(
     wxString::Format(_("%d: %s"), m_MidiKeyNumber, m_Filename.c_str()));
 }
 
+void GOSoundingPipe::LinkToModel() {
+  p_OrganModel->RegisterCacheObject(this);
+  m_PipeConfigNode.RegisterAsSaveable();
+  p_OrganModel->GetWindchest(m_WindchestN - 1)->AddPipe(this);
+}
+
 void GOSoundingPipe::LoadData(
   const GOFileStore &fileStore, GOMemoryPool &pool) {
   try {
@@ -496,6 +500,7 @@ void GOSoundingPipe::VelocityChanged(
       &m_LastStart);
     if (pSampler) {
       m_Instances++;
+      p_OrganModel->GetWindchest(m_WindchestN - 1)->OnPipeStarted();
       if (!m_SoundProvider.IsOneshot()) {
         p_CurrentLoopSampler = pSampler;
       }
@@ -503,6 +508,8 @@ void GOSoundingPipe::VelocityChanged(
   } else if (m_Instances && !velocity) {
     // the key released
     m_Instances--;
+    if (p_OrganModel)
+      p_OrganModel->GetWindchest(m_WindchestN - 1)->OnPipeStopped();
     if (p_CurrentLoopSampler && p_OrganModel) {
       m_LastStop
         = p_OrganModel->StopSample(&m_SoundProvider, p_CurrentLoopSampler);
@@ -124,8 +124,10 @@ public:
     const wxString &group,
     const wxString &prefix,
     const wxString &filename);
-  void Load(GOConfigReader &cfg, const wxString &group, const wxString &prefix)
+  void ParseOdf(
+    GOConfigReader &cfg, const wxString &group, const wxString &prefix)
     override;
+  void LinkToModel() override;
 };
 
 #endif
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -10,17 +10,20 @@
 #include <wx/intl.h>
 
 #include "config/GOConfigReader.h"
+#include "threading/GOMutexLocker.h"
 
+#include "GOManual.h"
 #include "GOOrganModel.h"
 #include "GORank.h"
 
 GOStop::GOStop(
   GOOrganModel &organModel,
+  GOManual &manual,
   unsigned first_midi_note_number,
   GOMidiObjectContext *pContext)
   : GODrawstop(organModel, OBJECT_TYPE_STOP),
+    r_manual(manual),
     m_RankInfo(0),
-    m_KeyVelocities(0),
     m_FirstMidiNoteNumber(first_midi_note_number),
     m_FirstAccessiblePipeLogicalKeyNumber(0),
     m_NumberOfAccessiblePipes(0) {
@@ -99,9 +102,6 @@ void GOStop::Load(GOConfigReader &cfg, const wxString &group) {
     info.StopID = info.Rank->RegisterStop(this);
     m_RankInfo.push_back(info);
   }
-
-  m_KeyVelocities.resize(m_NumberOfAccessiblePipes);
-  std::fill(m_KeyVelocities.begin(), m_KeyVelocities.end(), 0);
   GODrawstop::Load(cfg, group);
 }
 
@@ -120,7 +120,8 @@ void GOStop::SetRankKeyState(unsigned keyIndex, unsigned velocity) {
   }
 }
 
-void GOStop::SetKeyState(unsigned manualKeyNumber, unsigned velocity) {
+void GOStop::AddPipeRoutes(
+  unsigned manualKeyNumber, std::vector<PipeRoute> &routes) const {
   if (
     manualKeyNumber < m_FirstAccessiblePipeLogicalKeyNumber
     || manualKeyNumber
@@ -131,19 +132,34 @@ void GOStop::SetKeyState(unsigned manualKeyNumber, unsigned velocity) {
 
   unsigned keyIndex = manualKeyNumber - m_FirstAccessiblePipeLogicalKeyNumber;
 
-  if (m_KeyVelocities[keyIndex] == velocity)
-    return;
-  m_KeyVelocities[keyIndex] = velocity;
-  if (IsEngaged())
-    SetRankKeyState(keyIndex, m_KeyVelocities[keyIndex]);
+  for (const RankInfo &info : m_RankInfo) {
+    if (
+      keyIndex + 1 < info.FirstAccessibleKeyNumber
+      || keyIndex >= info.FirstAccessibleKeyNumber + info.PipeCount)
+      continue;
+
+    const int pipeIndex
+      = keyIndex + info.FirstPipeNumber - info.FirstAccessibleKeyNumber;
+
+    if (pipeIndex >= 0 && pipeIndex < (int)info.Rank->GetPipeCount())
+      routes.push_back({info.Rank, (unsigned)pipeIndex, info.StopID});
+  }
 }
 
 void GOStop::OnDrawstopStateChanged(bool on) {
   if (IsForEffects()) {
     SetRankKeyState(0, on ? 0x7f : 0x00);
   } else {
-    for (unsigned i = 0; i < m_NumberOfAccessiblePipes; i++)
-      SetRankKeyState(i, on ? m_KeyVelocities[i] : 0);
+    // a key set meanwhile would be routed with the old stop state
+    GOMutexLocker locker(r_manual.GetPipeRoutesLock());
+
+    r_manual.InvalidatePipeRoutes();
+    // the manual keeps the key states of all its stops
+    for (unsigned i = 0; i < m_NumberOfAccessiblePipes; i++) {
+      const unsigned keyIndex = i + m_FirstAccessiblePipeLogicalKeyNumber - 1;
+
+      SetRankKeyState(i, on ? r_manual.GetDivisionKeyVelocity(keyIndex) : 0);
+    }
   }
 }
 
@@ -157,9 +173,7 @@ void GOStop::AbortPlayback() {
 
 void GOStop::PreparePlayback() {
   GODrawstop::PreparePlayback();
-
-  m_KeyVelocities.resize(m_NumberOfAccessiblePipes);
-  std::fill(m_KeyVelocities.begin(), m_KeyVelocities.end(), 0);
+  r_manual.InvalidatePipeRoutes();
 }
 
 void GOStop::StartPlayback() {
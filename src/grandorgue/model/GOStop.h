@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -14,9 +14,18 @@
 
 #include "GODrawstop.h"
 
+class GOManual;
 class GORank;
 
 class GOStop : public GODrawstop {
+public:
+  // a pipe sounding on a manual key when the stop is engaged
+  struct PipeRoute {
+    GORank *p_rank;
+    unsigned m_PipeIndex;
+    unsigned m_StopID;
+  };
+
 private:
   typedef struct {
     GORank *Rank;
@@ -25,8 +34,8 @@ private:
     unsigned FirstPipeNumber;
     unsigned PipeCount;
   } RankInfo;
+  GOManual &r_manual;
   std::vector<RankInfo> m_RankInfo;
-  std::vector<unsigned> m_KeyVelocities;
   unsigned m_FirstMidiNoteNumber;
   unsigned m_FirstAccessiblePipeLogicalKeyNumber;
   unsigned m_NumberOfAccessiblePipes;
@@ -43,18 +52,20 @@ private:
 public:
   GOStop(
     GOOrganModel &organModel,
+    GOManual &manual,
     unsigned first_midi_note_number,
     GOMidiObjectContext *pContext);
   GORank *GetRank(unsigned index);
   void Load(GOConfigReader &cfg, const wxString &group) override;
 
   /**
-   * Set the key state (pressed, released). Called for both engaged and
-   *   disengaged stops
+   * Appends the pipes sounding on the key to the routes. The manual sets
+   *   these pipes directly while the stop is engaged
    * @param manualKeyNumber the key number in the manual (started with 1)
-   * @param velocity - the velocity of precing the key. 0 means released
+   * @param routes the vector to append the routes to
    */
-  void SetKeyState(unsigned manualKeyNumber, unsigned velocity);
+  void AddPipeRoutes(
+    unsigned manualKeyNumber, std::vector<PipeRoute> &routes) const;
   ~GOStop(void);
 };
 
@@ -34,6 +34,7 @@ GOTremulant::GOTremulant(GOOrganModel &organModel)
     m_StartRate(0),
     m_StopRate(0),
     m_AmpModDepth(0),
+    m_PitchModDepth(0),
     m_TremProvider(NULL),
     m_PlaybackHandle(0),
     m_LastStop(0),
@@ -69,6 +70,8 @@ void GOTremulant::Load(
     m_StopRate = cfg.ReadInteger(ODFSetting, group, wxT("StopRate"), 1, 100);
     m_AmpModDepth
       = cfg.ReadInteger(ODFSetting, group, wxT("AmpModDepth"), 1, 100);
+    m_PitchModDepth = cfg.ReadFloat(
+      ODFSetting, group, wxT("PitchModDepth"), 0, 100, false, 0);
     m_TremulantN = tremulantN;
     m_PlaybackHandle = 0;
   }
@@ -123,3 +126,10 @@ void GOTremulant::StartPlayback() {
 }
 
 GOTremulantType GOTremulant::GetTremulantType() { return m_TremulantType; }
+
+float GOTremulant::GetPitchPerAmplitude() const {
+  // the synthesized amplitude deviates by up to m_AmpModDepth percents
+  return m_TremulantType == GOSynthTrem && m_AmpModDepth
+    ? m_PitchModDepth * 100.0f / m_AmpModDepth
+    : 0.0f;
+}
@@ -32,6 +32,8 @@ private:
   int m_StartRate;
   int m_StopRate;
   int m_AmpModDepth;
+  // the pitch deviation in cents at the maximal amplitude deviation
+  float m_PitchModDepth;
   GOSoundProvider *m_TremProvider;
   GOSoundSampler *m_PlaybackHandle;
   uint64_t m_LastStop;
@@ -57,6 +59,13 @@ public:
   using GODrawstop::Load; // Avoiding a compilation warning
   void Load(GOConfigReader &cfg, const wxString &group, unsigned tremulantN);
   GOTremulantType GetTremulantType();
+
+  /**
+   * Returns how many cents the pitch of the windchest pipes deviates when
+   * the tremulant amplitude deviates from 1 by 1. 0 if the tremulant does not
+   * modulate the pitch
+   */
+  float GetPitchPerAmplitude() const;
 };
 
 #endif /* GOTREMULANT_H_ */
@@ -7,6 +7,8 @@
 
 #include "GOWindchest.h"
 
+#include <algorithm>
+
 #include <wx/intl.h>
 
 #include "config/GOConfigReader.h"
@@ -20,6 +22,9 @@ GOWindchest::GOWindchest(GOOrganModel &organModel)
   : r_OrganModel(organModel),
     m_Name(),
     m_Volume(1),
+    m_WindSag(0),
+    m_WindSagPipes(1),
+    m_NHeldPipes(0),
     m_enclosure(0),
     m_tremulant(0),
     m_ranks(0),
@@ -76,6 +81,10 @@ void GOWindchest::Load(GOConfigReader &cfg, wxString group, unsigned index) {
     wxT("Name"),
     false,
     wxString::Format(_("Windchest %d"), index + 1));
+  m_WindSag
+    = cfg.ReadFloat(ODFSetting, group, wxT("WindSag"), 0, 100, false, 0);
+  m_WindSagPipes = cfg.ReadInteger(
+    ODFSetting, group, wxT("WindSagPipes"), 1, 1000, false, 32);
   m_PipeConfig.Load(cfg, group, wxEmptyString);
   m_PipeConfig.SetName(GetName());
 }
@@ -89,10 +98,27 @@ void GOWindchest::UpdateVolume() {
 
 float GOWindchest::GetVolume() { return m_Volume; }
 
+void GOWindchest::SetWindSag(float cents, unsigned nPipes) {
+  m_WindSag = cents;
+  m_WindSagPipes = std::max(1u, nPipes);
+}
+
+float GOWindchest::GetWindSagPitchOffset() const {
+  const unsigned nPipes = m_NHeldPipes.load(std::memory_order_relaxed);
+
+  return m_WindSag
+    ? -m_WindSag * std::min(1.0f, float(nPipes) / m_WindSagPipes)
+    : 0.0f;
+}
+
 unsigned GOWindchest::GetTremulantCount() { return m_tremulant.size(); }
 
 unsigned GOWindchest::GetTremulantId(unsigned no) { return m_tremulant[no]; }
 
+GOTremulant *GOWindchest::GetTremulant(unsigned no) {
+  return r_OrganModel.GetTremulant(m_tremulant[no]);
+}
+
 unsigned GOWindchest::GetRankCount() { return m_ranks.size(); }
 
 GORank *GOWindchest::GetRank(unsigned index) {
@@ -128,4 +154,7 @@ void GOWindchest::UpdateTremulant(GOTremulant *tremulant) {
     }
 }
 
-void GOWindchest::PreparePlayback() { UpdateVolume(); }
+void GOWindchest::PreparePlayback() {
+  UpdateVolume();
+  m_NHeldPipes.store(0);
+}
@@ -8,6 +8,7 @@
 #ifndef GOWINDCHEST_H
 #define GOWINDCHEST_H
 
+#include <atomic>
 #include <vector>
 
 #include <wx/string.h>
@@ -32,6 +33,12 @@ private:
   wxString m_HardName;
 
   float m_Volume;
+  // the pitch drop in cents when m_WindSagPipes or more pipes are held
+  float m_WindSag;
+  unsigned m_WindSagPipes;
+  // the pipes with pressed keys. The release tails are not counted. Is
+  // changed by the pipes and is read by the sound engine
+  std::atomic_uint m_NHeldPipes;
   std::vector<GOEnclosure *> m_enclosure;
   std::vector<unsigned> m_tremulant;
   std::vector<GORank *> m_ranks;
@@ -51,8 +58,25 @@ public:
   void UpdateTremulant(GOTremulant *tremulant);
   void UpdateVolume();
   float GetVolume();
+
+  /**
+   * Sets the wind sag. It is usually loaded from the ODF
+   * @param cents the pitch drop at the full load
+   * @param nPipes the number of the held pipes that causes the full drop
+   */
+  void SetWindSag(float cents, unsigned nPipes);
+  // Are called by the pipes when their keys are pressed and released
+  void OnPipeStarted() { m_NHeldPipes.fetch_add(1); }
+  void OnPipeStopped() { m_NHeldPipes.fetch_sub(1); }
+  /**
+   * Returns the pitch offset in cents caused by the wind sag under the
+   * current load. It is 0 or negative
+   */
+  float GetWindSagPitchOffset() const;
+
   unsigned GetTremulantCount();
   unsigned GetTremulantId(unsigned index);
+  GOTremulant *GetTremulant(unsigned index);
   unsigned GetRankCount();
   GORank *GetRank(unsigned index);
   void AddRank(GORank *rank);
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -37,7 +37,8 @@ GOPipeConfig::GOPipeConfig(
     m_Compress(BOOL3_DEFAULT),
     m_AttackLoad(BOOL3_DEFAULT),
     m_ReleaseLoad(BOOL3_DEFAULT),
-    m_IgnorePitch(BOOL3_DEFAULT) {}
+    m_IgnorePitch(BOOL3_DEFAULT),
+    m_Generation(0) {}
 
 static const wxString WX_TUNING = wxT("Tuning");
 static const wxString WX_MANUAL_TUNING = wxT("ManualTuning");
@@ -121,6 +122,7 @@ void GOPipeConfig::LoadFromCmb(
     false,
     0);
 
+  m_Generation++;
   m_Callback->UpdateAmplitude();
   m_Callback->UpdateTuning();
   m_Callback->UpdateAudioGroup();
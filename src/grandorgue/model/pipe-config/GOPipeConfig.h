@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -50,6 +50,8 @@ private:
   GOBool3 m_AttackLoad;
   GOBool3 m_ReleaseLoad;
   GOBool3 m_IgnorePitch;
+  // is incremented on each change of any value
+  uint32_t m_Generation;
 
   // Load all customizable values from the .cmb
   void LoadFromCmb(
@@ -60,6 +62,7 @@ private:
 
 #define SET_MEMBER_BODY(value, member, callbackFun)                            \
   member = value;                                                              \
+  m_Generation++;                                                              \
   if (callbackFun)                                                             \
     (m_Callback->*callbackFun)();                                              \
   r_listener.NotifyPipeConfigModified();
@@ -100,6 +103,7 @@ public:
   void Save(GOConfigWriter &cfg);
 
   GOPipeUpdateCallback *GetCallback() const { return m_Callback; }
+  uint32_t GetGeneration() const { return m_Generation; }
 
   const wxString &GetAudioGroup() const { return m_AudioGroup; }
   void SetAudioGroup(const wxString &str) {
@@ -1,18 +1,27 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
 
 #include "GOPipeConfigNode.h"
 
+#include <vector>
+
 #include "config/GOConfig.h"
 #include "model/GOOrganModel.h"
+#include "threading/GOMutexLocker.h"
 
 #include "GOSampleStatistic.h"
 #include "GOStatisticCallback.h"
 
+// the nesting depth of DeferredUpdates in the current thread. The state is
+// per thread, so a change made in another thread is never deferred
+static thread_local unsigned deferred_depth = 0;
+// the nodes with m_PendingUpdates != 0
+static thread_local std::vector<GOPipeConfigNode *> deferred_nodes;
+
 GOPipeConfigNode::GOPipeConfigNode(
   GOPipeConfigNode *parent,
   GOOrganModel &organModel,
@@ -21,15 +30,55 @@ GOPipeConfigNode::GOPipeConfigNode(
   : r_OrganModel(organModel),
     m_config(organModel.GetConfig()),
     m_parent(parent),
-    m_PipeConfig(organModel, callback),
+    p_callback(callback),
+    m_PipeConfig(organModel, this),
     m_StatisticCallback(statistic),
-    m_Name() {
+    m_Name(),
+    m_EffectiveLock(),
+    m_effective(),
+    m_IsEffectiveValid(false),
+    m_EffectiveConfigGeneration(0),
+    m_EffectiveParentGeneration(0),
+    m_EffectiveGeneration(0),
+    m_PendingUpdates(0) {
   if (m_parent)
     m_parent->AddChild(this);
 }
 
+GOPipeConfigNode::DeferredUpdates::DeferredUpdates() { deferred_depth++; }
+
+GOPipeConfigNode::DeferredUpdates::~DeferredUpdates() {
+  if (--deferred_depth)
+    return;
+
+  std::vector<GOPipeConfigNode *> nodes;
+
+  nodes.swap(deferred_nodes);
+  // an update passed to an ancestor reaches the node anyway
+  for (GOPipeConfigNode *node : nodes) {
+    uint8_t updates = node->m_PendingUpdates;
+
+    for (const GOPipeConfigNode *ancestor = node->m_parent; ancestor;
+         ancestor = ancestor->m_parent)
+      updates &= ~ancestor->m_PendingUpdates;
+    node->m_PendingUpdates = updates;
+  }
+  for (GOPipeConfigNode *node : nodes) {
+    const uint8_t updates = node->m_PendingUpdates;
+
+    node->m_PendingUpdates = 0;
+    if (updates)
+      node->PropagateUpdates(updates);
+  }
+}
+
 void GOPipeConfigNode::SetParent(GOPipeConfigNode *parent) {
   m_parent = parent;
+  {
+    GOMutexLocker locker(m_EffectiveLock);
+
+    m_IsEffectiveValid = false;
+  }
   if (m_parent)
     m_parent->AddChild(this);
 }
@@ -42,11 +91,20 @@ void GOPipeConfigNode::Init(
 
 void GOPipeConfigNode::Load(
   GOConfigReader &cfg, const wxString &group, const wxString &prefix) {
-  r_OrganModel.RegisterSaveableObject(this);
+  RegisterAsSaveable();
+  ParseOdf(cfg, group, prefix);
+}
+
+void GOPipeConfigNode::ParseOdf(
+  GOConfigReader &cfg, const wxString &group, const wxString &prefix) {
   m_PipeConfig.Load(
     cfg, group, prefix, m_parent && m_parent->GetEffectivePercussive());
 }
 
+void GOPipeConfigNode::RegisterAsSaveable() {
+  r_OrganModel.RegisterSaveableObject(this);
+}
+
 wxString GOPipeConfigNode::GetEffectiveAudioGroup() const {
   if (m_PipeConfig.GetAudioGroup() != wxEmptyString)
     return m_PipeConfig.GetAudioGroup();
@@ -56,29 +114,61 @@ wxString GOPipeConfigNode::GetEffectiveAudioGroup() const {
     return wxEmptyString;
 }
 
-float GOPipeConfigNode::GetEffectiveAmplitude() const {
-  if (m_parent)
-    return m_PipeConfig.GetAmplitude() * m_parent->GetEffectiveAmplitude()
-      / 100.0;
-  else
-    return m_PipeConfig.GetAmplitude() / 100.0;
-}
-
-uint16_t GOPipeConfigNode::GetEffectiveReleaseTail() const {
-  unsigned releaseTail = m_parent ? m_parent->GetEffectiveReleaseTail() : 0;
-  const unsigned thisReleaseTail = m_PipeConfig.GetReleaseTail();
-
-  // Set releaseTail as minimum between the parent release tail and this one
-  if (thisReleaseTail && (!releaseTail || thisReleaseTail < releaseTail))
-    releaseTail = thisReleaseTail;
-  return releaseTail;
-}
-
-int8_t GOPipeConfigNode::GetEffectiveToneBalanceValue() const {
-  if (m_PipeConfig.GetToneBalanceValue())
-    return m_PipeConfig.GetToneBalanceValue();
-  else
-    return m_parent ? m_parent->GetEffectiveToneBalanceValue() : 0;
+GOPipeConfigNode::EffectiveValues GOPipeConfigNode::GetEffectiveValues(
+  uint32_t &generation) const {
+  // the parent values are copied under the parent lock before taking this
+  // lock, so the locks are never nested
+  uint32_t parentGeneration = 0;
+  const EffectiveValues parentValues = m_parent
+    ? m_parent->GetEffectiveValues(parentGeneration)
+    : EffectiveValues();
+  GOMutexLocker locker(m_EffectiveLock);
+  const uint32_t configGeneration = m_PipeConfig.GetGeneration();
+
+  generation = m_EffectiveGeneration;
+  if (
+    m_IsEffectiveValid && configGeneration == m_EffectiveConfigGeneration
+    && parentGeneration == m_EffectiveParentGeneration)
+    return m_effective;
+
+  EffectiveValues &e = m_effective;
+  const float amplitude = m_PipeConfig.GetAmplitude() / 100.0;
+  const uint16_t thisReleaseTail = m_PipeConfig.GetReleaseTail();
+  const int8_t thisToneBalance = m_PipeConfig.GetToneBalanceValue();
+
+  e.m_amplitude = amplitude;
+  e.m_gain = m_PipeConfig.GetGain();
+  e.m_PitchTuning = m_PipeConfig.GetPitchTuning();
+  e.m_PitchCorrection = m_PipeConfig.GetPitchCorrection();
+  e.m_ManualTuning = m_PipeConfig.GetManualTuning();
+  e.m_AutoTuningCorrection = m_PipeConfig.GetAutoTuningCorrection();
+  e.m_delay = m_PipeConfig.GetDelay();
+  e.m_ReleaseTail = thisReleaseTail;
+  e.m_ToneBalanceValue = thisToneBalance;
+  if (m_parent) {
+    e.m_amplitude *= parentValues.m_amplitude;
+    e.m_gain += parentValues.m_gain;
+    e.m_PitchTuning += parentValues.m_PitchTuning;
+    e.m_PitchCorrection += parentValues.m_PitchCorrection;
+    e.m_ManualTuning += parentValues.m_ManualTuning;
+    e.m_AutoTuningCorrection += parentValues.m_AutoTuningCorrection;
+    e.m_delay += parentValues.m_delay;
+
+    // the minimum between the parent release tail and this one
+    const uint16_t parentReleaseTail = parentValues.m_ReleaseTail;
+
+    if (
+      parentReleaseTail
+      && (!thisReleaseTail || parentReleaseTail < thisReleaseTail))
+      e.m_ReleaseTail = parentReleaseTail;
+    if (!thisToneBalance)
+      e.m_ToneBalanceValue = parentValues.m_ToneBalanceValue;
+  }
+  m_IsEffectiveValid = true;
+  m_EffectiveConfigGeneration = configGeneration;
+  m_EffectiveParentGeneration = parentGeneration;
+  generation = ++m_EffectiveGeneration;
+  return e;
 }
 
 uint8_t GOPipeConfigNode::GetEffectiveUint8(
@@ -98,6 +188,30 @@ GOSampleStatistic GOPipeConfigNode::GetStatistic() const {
   return GOSampleStatistic();
 }
 
+void GOPipeConfigNode::OnConfigChanged(uint8_t updates) {
+  if (deferred_depth) {
+    if (!m_PendingUpdates)
+      deferred_nodes.push_back(this);
+    m_PendingUpdates |= updates;
+  } else
+    PropagateUpdates(updates);
+}
+
+void GOPipeConfigNode::PropagateUpdates(uint8_t updates) {
+  if (!p_callback)
+    return;
+  if (updates & UPDATE_AMPLITUDE)
+    p_callback->UpdateAmplitude();
+  if (updates & UPDATE_TUNING)
+    p_callback->UpdateTuning();
+  if (updates & UPDATE_AUDIO_GROUP)
+    p_callback->UpdateAudioGroup();
+  if (updates & UPDATE_RELEASE_TAIL)
+    p_callback->UpdateReleaseTail();
+  if (updates & UPDATE_TONE_BALANCE)
+    p_callback->UpdateToneBalance();
+}
+
 void GOPipeConfigNode::ModifyManualTuning(float diff) {
   m_PipeConfig.SetManualTuning(m_PipeConfig.GetManualTuning() + diff);
 }
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -8,37 +8,113 @@
 #ifndef GOPIPECONFIGNODE_H
 #define GOPIPECONFIGNODE_H
 
+#include <cstdint>
+
 #include <config/GOConfig.h>
 
+#include "threading/GOMutex.h"
+
 #include "GOPipeConfig.h"
+#include "GOPipeUpdateCallback.h"
 #include "GOSaveableObject.h"
 
 class GOOrganModel;
 class GOSampleStatistic;
 class GOStatisticCallback;
 
-class GOPipeConfigNode : private GOSaveableObject {
+class GOPipeConfigNode : private GOSaveableObject,
+                         private GOPipeUpdateCallback {
+public:
+  /**
+   * While an object of this class exists in the current thread, the updates
+   * caused by changing the node configs are collected instead of being passed
+   * down the tree. When the outermost one is destroyed, each changed node is
+   * updated once, and only if none of its ancestors gets the same kind of
+   * update. So changing many settings of many nodes updates each pipe once.
+   *
+   * Only the changes made in the same thread are collected. The configs are
+   * changed in the main thread only, so the objects are created there
+   */
+  class DeferredUpdates {
+  public:
+    DeferredUpdates();
+    ~DeferredUpdates();
+
+    DeferredUpdates(const DeferredUpdates &) = delete;
+    DeferredUpdates &operator=(const DeferredUpdates &) = delete;
+  };
+
+  // kinds of updates passed down the tree. May be combined
+  enum {
+    UPDATE_AMPLITUDE = 1,
+    UPDATE_TUNING = 2,
+    UPDATE_AUDIO_GROUP = 4,
+    UPDATE_RELEASE_TAIL = 8,
+    UPDATE_TONE_BALANCE = 16,
+  };
+
 private:
+  // the numeric effective values that are cached
+  struct EffectiveValues {
+    float m_amplitude;
+    float m_gain;
+    float m_PitchTuning;
+    float m_PitchCorrection;
+    float m_ManualTuning;
+    float m_AutoTuningCorrection;
+    uint16_t m_delay;
+    uint16_t m_ReleaseTail;
+    int8_t m_ToneBalanceValue;
+  };
+
   GOOrganModel &r_OrganModel;
   const GOConfig &m_config;
   GOPipeConfigNode *m_parent;
+  GOPipeUpdateCallback *p_callback;
   GOPipeConfig m_PipeConfig;
   GOStatisticCallback *m_StatisticCallback;
   wxString m_Name;
 
+  /**
+   * The cache of the effective values. It is valid while
+   * m_PipeConfig.GetGeneration() == m_EffectiveConfigGeneration and
+   * m_parent->m_EffectiveGeneration == m_EffectiveParentGeneration, so a
+   * change of a node config makes stale the caches of its subtree only.
+   * The pipes being loaded in parallel read the caches of their common
+   * ancestors, so the cache is accessed under m_EffectiveLock only
+   */
+  mutable GOMutex m_EffectiveLock;
+  mutable EffectiveValues m_effective;
+  mutable bool m_IsEffectiveValid;
+  mutable uint32_t m_EffectiveConfigGeneration;
+  mutable uint32_t m_EffectiveParentGeneration;
+  // is incremented each time m_effective is recomputed
+  mutable uint32_t m_EffectiveGeneration;
+
+  // the updates collected by DeferredUpdates
+  uint8_t m_PendingUpdates;
+
   void Save(GOConfigWriter &cfg) override { m_PipeConfig.Save(cfg); }
 
-  template <typename T>
-  T GetEffectiveSum(
-    T (GOPipeConfig::*getThisValue)() const,
-    T (GOPipeConfigNode::*getParentValue)() const) const {
-    T value = (m_PipeConfig.*getThisValue)();
+  /**
+   * Returns a copy of the effective values, recomputing them if they are stale
+   * @param generation is set to the generation of the returned values
+   */
+  EffectiveValues GetEffectiveValues(uint32_t &generation) const;
+  EffectiveValues GetEffectiveValues() const {
+    uint32_t generation;
 
-    if (m_parent)
-      value += (m_parent->*getParentValue)();
-    return value;
+    return GetEffectiveValues(generation);
   }
 
+  // is called by m_PipeConfig when it has been changed
+  void OnConfigChanged(uint8_t updates);
+  void UpdateAmplitude() override { OnConfigChanged(UPDATE_AMPLITUDE); }
+  void UpdateTuning() override { OnConfigChanged(UPDATE_TUNING); }
+  void UpdateAudioGroup() override { OnConfigChanged(UPDATE_AUDIO_GROUP); }
+  void UpdateReleaseTail() override { OnConfigChanged(UPDATE_RELEASE_TAIL); }
+  void UpdateToneBalance() override { OnConfigChanged(UPDATE_TONE_BALANCE); }
+
   uint8_t GetEffectiveUint8(
     int8_t (GOPipeConfig::*getThisValue)() const,
     uint8_t (GOPipeConfigNode::*getParentValue)() const,
@@ -66,6 +142,14 @@ public:
   void SetParent(GOPipeConfigNode *parent);
   void Init(GOConfigReader &cfg, const wxString &group, const wxString &prefix);
   void Load(GOConfigReader &cfg, const wxString &group, const wxString &prefix);
+  /**
+   * Reads the config like Load() but does not register the node as a saveable
+   *   object, so it may be called concurrently for different nodes.
+   *   RegisterAsSaveable() must be called later from the main thread
+   */
+  void ParseOdf(
+    GOConfigReader &cfg, const wxString &group, const wxString &prefix);
+  void RegisterAsSaveable();
 
   const wxString &GetName() const { return m_Name; }
   void SetName(const wxString &name) { m_Name = name; }
@@ -74,45 +158,44 @@ public:
 
   wxString GetEffectiveAudioGroup() const;
 
-  float GetEffectiveAmplitude() const;
-
-  float GetEffectiveGain() const {
-    return GetEffectiveSum(
-      &GOPipeConfig::GetGain, &GOPipeConfigNode::GetEffectiveGain);
+  float GetEffectiveAmplitude() const {
+    return GetEffectiveValues().m_amplitude;
   }
 
+  float GetEffectiveGain() const { return GetEffectiveValues().m_gain; }
+
   float GetEffectivePitchTuning() const {
-    return GetEffectiveSum(
-      &GOPipeConfig::GetPitchTuning,
-      &GOPipeConfigNode::GetEffectivePitchTuning);
+    return GetEffectiveValues().m_PitchTuning;
   }
 
   float GetEffectivePitchCorrection() const {
-    return GetEffectiveSum(
-      &GOPipeConfig::GetPitchCorrection,
-      &GOPipeConfigNode::GetEffectivePitchCorrection);
+    return GetEffectiveValues().m_PitchCorrection;
   }
 
   float GetEffectiveManualTuning() const {
-    return GetEffectiveSum(
-      &GOPipeConfig::GetManualTuning,
-      &GOPipeConfigNode::GetEffectiveManualTuning);
+    return GetEffectiveValues().m_ManualTuning;
   }
 
   float GetEffectiveAutoTuningCorection() const {
-    return GetEffectiveSum(
-      &GOPipeConfig::GetAutoTuningCorrection,
-      &GOPipeConfigNode::GetEffectiveAutoTuningCorection);
+    return GetEffectiveValues().m_AutoTuningCorrection;
   }
 
-  uint16_t GetEffectiveDelay() const {
-    return GetEffectiveSum(
-      &GOPipeConfig::GetDelay, &GOPipeConfigNode::GetEffectiveDelay);
+  uint16_t GetEffectiveDelay() const { return GetEffectiveValues().m_delay; }
+
+  uint16_t GetEffectiveReleaseTail() const {
+    return GetEffectiveValues().m_ReleaseTail;
   }
 
-  uint16_t GetEffectiveReleaseTail() const;
+  int8_t GetEffectiveToneBalanceValue() const {
+    return GetEffectiveValues().m_ToneBalanceValue;
+  }
 
-  int8_t GetEffectiveToneBalanceValue() const;
+  /**
+   * Brings the cached effective values of this node and its ancestors up to
+   * date in advance, so the threads reading them later do not wait for each
+   * other computing them
+   */
+  void ValidateEffectiveValues() const { GetEffectiveValues(); }
 
   uint8_t GetEffectiveBitsPerSample() const {
     return GetEffectiveUint8(
@@ -182,6 +265,13 @@ public:
   virtual GOPipeConfigNode *GetChild(unsigned index) const { return nullptr; }
   virtual GOSampleStatistic GetStatistic() const;
 
+  /**
+   * Passes the updates to the callback of the node. A tree node passes them
+   * to all its children as well
+   * @param updates a combination of UPDATE_... flags
+   */
+  virtual void PropagateUpdates(uint8_t updates);
+
   void ModifyManualTuning(float diff);
   void ModifyAutoTuningCorrection(float diff);
 };
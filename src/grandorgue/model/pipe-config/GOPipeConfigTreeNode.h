@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -13,23 +13,15 @@
 #include "GOPipeConfigNode.h"
 #include "GOPipeUpdateCallback.h"
 
-class GOPipeConfigTreeNode : public GOPipeConfigNode,
-                             private GOPipeUpdateCallback {
+class GOPipeConfigTreeNode : public GOPipeConfigNode {
 private:
   std::vector<GOPipeConfigNode *> m_Childs;
-  GOPipeUpdateCallback *m_Callback;
-
-  void UpdateAmplitude() override;
-  void UpdateTuning() override;
-  void UpdateAudioGroup() override;
-  void UpdateReleaseTail() override;
-  void UpdateToneBalance() override;
 
 public:
   GOPipeConfigTreeNode(
     GOPipeConfigNode *parent,
     GOOrganModel *organModel,
-    GOPipeUpdateCallback *callback);
+    ::GOPipeUpdateCallback *callback);
 
   void AddChild(GOPipeConfigNode *node) override { m_Childs.push_back(node); }
   unsigned GetChildCount() const override { return m_Childs.size(); }
@@ -37,6 +29,7 @@ public:
     return m_Childs[index];
   }
   GOSampleStatistic GetStatistic() const override;
+  void PropagateUpdates(uint8_t updates) override;
 };
 
 #endif
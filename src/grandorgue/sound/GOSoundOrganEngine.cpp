@@ -8,6 +8,7 @@
 #include "GOSoundOrganEngine.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "buffer/GOSoundBufferMutable.h"
 #include "model/GOOrganModel.h"
@@ -15,6 +16,7 @@
 #include "model/GOWindchest.h"
 #include "playing/GOSoundReleaseAlignTable.h"
 #include "playing/GOSoundSampler.h"
+#include "playing/GOSoundSamplerBatch.h"
 #include "providers/GOSoundProvider.h"
 #include "tasks/GOSoundGroupTask.h"
 #include "tasks/GOSoundOutputTask.h"
@@ -26,17 +28,44 @@
 
 #include "GOEvent.h"
 #include "GOSoundRecorder.h"
+#include "GOTime.h"
+
+// the time of the midi event being processed in the current thread
+static thread_local int64_t t_EventTimeNs = 0;
+
+GOSoundOrganEngine::EventTimeScope::EventTimeScope(int64_t timeNs)
+  : m_PrevTimeNs(t_EventTimeNs) {
+  t_EventTimeNs = timeNs;
+}
+
+GOSoundOrganEngine::EventTimeScope::~EventTimeScope() {
+  t_EventTimeNs = m_PrevTimeNs;
+}
+
+// the engine time of the midi event being processed in the current thread
+static thread_local uint64_t t_EventSampleTime = 0;
+
+GOSoundOrganEngine::EventSampleTimeScope::EventSampleTimeScope(uint64_t time)
+  : m_PrevTime(t_EventSampleTime) {
+  t_EventSampleTime = time;
+}
+
+GOSoundOrganEngine::EventSampleTimeScope::~EventSampleTimeScope() {
+  t_EventSampleTime = m_PrevTime;
+}
 
 GOSoundOrganEngine::GOSoundOrganEngine()
   : m_PolyphonyLimiting(true),
     m_ScaledReleases(true),
     m_ReleaseAlignmentEnabled(true),
     m_RandomizeSpeaking(true),
+    m_EventLatencyPeriods(0),
     m_Volume(-15),
     m_SamplesPerBuffer(1),
     m_Gain(1),
     m_SampleRate(0),
     m_CurrentTime(1),
+    m_ClockOriginNs(0),
     m_SamplerPool(),
     m_AudioGroupCount(1),
     m_UsedPolyphony(0),
@@ -213,6 +242,7 @@ void GOSoundOrganEngine::Reset() {
   m_UsedPolyphony.store(0);
   m_SamplerPool.ReturnAll();
   m_CurrentTime = 1;
+  m_ClockOriginNs.store(0);
   m_Scheduler.Reset();
 }
 
@@ -228,10 +258,11 @@ void GOSoundOrganEngine::Setup(
       new GOSoundTremulantTask(*this, m_SamplesPerBuffer));
   m_WindchestTasks.clear();
   // a special windchest task for detached releases
-  m_WindchestTasks.push_back(new GOSoundWindchestTask(*this, NULL));
+  m_WindchestTasks.push_back(
+    new GOSoundWindchestTask(*this, NULL, m_SamplesPerBuffer));
   for (unsigned i = 0; i < organModel.GetWindchestCount(); i++)
-    m_WindchestTasks.push_back(
-      new GOSoundWindchestTask(*this, organModel.GetWindchest(i)));
+    m_WindchestTasks.push_back(new GOSoundWindchestTask(
+      *this, organModel.GetWindchest(i), m_SamplesPerBuffer));
   m_TouchTask
     = std::unique_ptr<GOSoundTouchTask>(new GOSoundTouchTask(memoryPool));
   m_HasBeenSetup.store(true);
@@ -262,13 +293,17 @@ float GOSoundOrganEngine::GetRandomFactor() const {
   return 1;
 }
 
-void GOSoundOrganEngine::PassSampler(GOSoundSampler *sampler) {
+GOSoundSamplerList &GOSoundOrganEngine::GetSamplerList(
+  const GOSoundSampler *sampler) {
   int taskId = sampler->m_SamplerTaskId;
 
-  if (isWindchestTask(taskId))
-    m_AudioGroupTasks[sampler->m_AudioGroupId]->Add(sampler);
-  else
-    m_TremulantTasks[tremulantTaskToIndex(taskId)]->Add(sampler);
+  return isWindchestTask(taskId)
+    ? m_AudioGroupTasks[sampler->m_AudioGroupId]->GetListFor(sampler)
+    : m_TremulantTasks[tremulantTaskToIndex(taskId)]->GetListFor(sampler);
+}
+
+void GOSoundOrganEngine::PassSampler(GOSoundSampler *sampler) {
+  GetSamplerList(sampler).Put(sampler);
 }
 
 void GOSoundOrganEngine::StartSampler(GOSoundSampler *sampler) {
@@ -276,28 +311,64 @@ void GOSoundOrganEngine::StartSampler(GOSoundSampler *sampler) {
 
   sampler->stop = 0;
   sampler->new_attack = 0;
+  sampler->decay_time = 0;
   sampler->p_WindchestTask = isWindchestTask(taskId)
     ? m_WindchestTasks[windchestTaskToIndex(taskId)]
     : nullptr;
-  PassSampler(sampler);
+
+  GOSoundSamplerList &list = GetSamplerList(sampler);
+
+  if (!GOSoundSamplerBatch::Add(list, sampler))
+    list.Put(sampler);
+}
+
+void GOSoundOrganEngine::ApplyVolume(
+  GOSoundSampler *sampler,
+  float *buffer,
+  unsigned nFrames,
+  const float *volumes,
+  unsigned startFrame) {
+  if (volumes)
+    sampler->fader.Process(nFrames, buffer, volumes + startFrame);
+  else
+    sampler->fader.Process(nFrames, buffer, 1.0f);
 }
 
 bool GOSoundOrganEngine::ProcessSampler(
   float *output_buffer,
   GOSoundSampler *sampler,
   unsigned n_frames,
-  float volume) {
+  const float *volumes,
+  float pitchFactor) {
   float temp[n_frames * 2];
-  const bool process_sampler = (sampler->time <= m_CurrentTime);
+  const uint64_t blockEnd = m_CurrentTime + n_frames;
+  // a timestamped sampler may start inside the block
+  const bool process_sampler = (sampler->time < blockEnd);
 
   if (process_sampler) {
+    const uint64_t startTime = std::max(sampler->time, m_CurrentTime);
+    const unsigned startFrame = startTime - m_CurrentTime;
+    const unsigned nFrames = n_frames - startFrame;
+
     if (sampler->is_release &&
         ((m_PolyphonyLimiting &&
           m_SamplerPool.UsedSamplerCount() >= m_PolyphonySoftLimit &&
-          m_CurrentTime - sampler->time > 172 * 16) ||
+          m_CurrentTime > sampler->time + 172 * 16) ||
          sampler->drop_counter > 1))
       sampler->fader.StartDecreasingVolume(MsToSamples(370));
 
+    // the pipe has been retuned or the windchest pitch has been changed since
+    // the previous block. Change the speed keeping the position, so the sound
+    // continues smoothly
+    const float tuning = sampler->p_SoundProvider
+      ? sampler->p_SoundProvider->GetTuning() * pitchFactor
+      : sampler->m_Tuning;
+
+    if (tuning != sampler->m_Tuning) {
+      sampler->stream.Retune(tuning / sampler->m_Tuning);
+      sampler->m_Tuning = tuning;
+    }
+
     /* The decoded sampler frame will contain values containing
      * sampler->pipe_section->sample_bits worth of significant bits.
      * It is the responsibility of the fade engine to bring these bits
@@ -306,22 +377,42 @@ bool GOSoundOrganEngine::ProcessSampler(
      *
      *     playback gain * (2 ^ -sampler->pipe_section->sample_bits)
      */
-    if (!sampler->stream.ReadBlock(temp, n_frames))
+    if (!sampler->stream.ReadBlock(temp, nFrames))
       sampler->p_SoundProvider = NULL;
 
-    sampler->fader.Process(n_frames, temp, volume);
+    float *fadedBuffer = temp;
+    unsigned nFadedFrames = nFrames;
+
+    if (sampler->decay_time && sampler->decay_time < blockEnd) {
+      // the decay starts inside the block. Play the frames before it as is
+      const unsigned nSteadyFrames
+        = std::max(sampler->decay_time, startTime) - startTime;
+
+      if (nSteadyFrames)
+        ApplyVolume(sampler, temp, nSteadyFrames, volumes, startFrame);
+      sampler->fader.StartDecreasingVolume(sampler->decay_length);
+      sampler->decay_time = 0;
+      fadedBuffer += nSteadyFrames * 2;
+      nFadedFrames -= nSteadyFrames;
+    }
+    ApplyVolume(
+      sampler, fadedBuffer, nFadedFrames, volumes, n_frames - nFadedFrames);
     if (sampler->toneBalanceFilterState.IsToApply())
-      sampler->toneBalanceFilterState.ProcessBuffer(n_frames, temp);
+      sampler->toneBalanceFilterState.ProcessBuffer(nFrames, temp);
 
     /* Add these samples to the current output buffer shifting
      * right by the necessary amount to bring the sample gain back
      * to unity (this value is computed in GOPipe.cpp)
      */
-    for (unsigned i = 0; i < n_frames * 2; i++)
-      output_buffer[i] += temp[i];
+    float *const output = output_buffer + startFrame * 2;
+
+    for (unsigned i = 0; i < nFrames * 2; i++)
+      output[i] += temp[i];
 
+    // a stop inside the next block is detected now, so the release sampler
+    // is ready to start exactly at the stop time
     if (
-      (sampler->stop && sampler->stop <= m_CurrentTime)
+      (sampler->stop && sampler->stop < blockEnd + n_frames)
       || (sampler->new_attack && sampler->new_attack <= m_CurrentTime)) {
       m_ReleaseProcessor->Add(sampler);
       return false;
@@ -387,6 +478,7 @@ void GOSoundOrganEngine::NextPeriod() {
   m_Scheduler.Exec();
 
   m_CurrentTime += m_SamplesPerBuffer;
+  UpdateClockOrigin();
   atomic_fetch_max_relaxed(m_UsedPolyphony, m_SamplerPool.UsedSamplerCount());
 
   // Audio thread: load with acquire so that the new vector written by
@@ -419,10 +511,68 @@ void GOSoundOrganEngine::NextPeriod() {
 
 unsigned GOSoundOrganEngine::SamplesDiffToMs(
   uint64_t fromSamples, uint64_t toSamples) const {
+  // a timestamped event may be positioned before the previous one
+  if (toSamples <= fromSamples)
+    return 0;
   return (unsigned)std::min(
     (toSamples - fromSamples) * 1000 / m_SampleRate, (uint64_t)UINT_MAX);
 }
 
+void GOSoundOrganEngine::UpdateClockOrigin() {
+  if (!m_SampleRate)
+    return;
+
+  // map now to the start of the block being computed since this period.
+  // Delivering it later is covered by m_EventLatencyPeriods
+  const double nsPerSample = 1e9 / m_SampleRate;
+  const int64_t originNs
+    = go_steady_time_ns() - int64_t(m_CurrentTime * nsPerSample);
+  const int64_t periodNs = int64_t(m_SamplesPerBuffer * nsPerSample);
+  const int64_t prevOriginNs = m_ClockOriginNs.load(std::memory_order_relaxed);
+  const int64_t diffNs = originNs - prevOriginNs;
+
+  // smooth the callback jitter but follow a clock drift or a dropout
+  m_ClockOriginNs.store(
+    !prevOriginNs || diffNs > periodNs || diffNs < -periodNs
+      ? originNs
+      : prevOriginNs + diffNs / 16,
+    std::memory_order_relaxed);
+}
+
+uint64_t GOSoundOrganEngine::GetEventTime() const {
+  const uint64_t currentTime = m_CurrentTime;
+  const int64_t originNs = m_ClockOriginNs.load(std::memory_order_relaxed);
+  const uint64_t latency = GetEventLatency();
+  uint64_t eventTime;
+
+  if (t_EventSampleTime)
+    eventTime = t_EventSampleTime;
+  else if (
+    !m_EventLatencyPeriods || !t_EventTimeNs || !originNs
+    || t_EventTimeNs <= originNs)
+    // the event latency is off or the event is not timestamped
+    return currentTime;
+  else
+    eventTime
+      = uint64_t((t_EventTimeNs - originNs) * 1e-9 * m_SampleRate) + latency;
+
+  // the event may be processed too late or be timestamped in the future
+  return std::clamp(
+    eventTime, currentTime, currentTime + latency + m_SamplesPerBuffer);
+}
+
+int64_t GOSoundOrganEngine::GetEventTimeNs(uint64_t time) const {
+  const int64_t originNs = m_ClockOriginNs.load(std::memory_order_relaxed);
+  const uint64_t latency = GetEventLatency();
+
+  if (!originNs || !m_SampleRate)
+    return 0;
+  // round up so that GetEventTime() does not return the previous sample
+  return originNs
+    + int64_t(std::ceil(
+      (time > latency ? time - latency : 0) * 1e9 / m_SampleRate));
+}
+
 GOSoundSampler *GOSoundOrganEngine::CreateTaskSample(
   const GOSoundProvider *pSoundProvider,
   int samplerTaskId,
@@ -433,7 +583,7 @@ GOSoundSampler *GOSoundOrganEngine::CreateTaskSample(
   bool isRelease,
   uint64_t *pStartTimeSamples) {
   unsigned delay_samples = (delay * m_SampleRate) / (1000);
-  uint64_t start_time = m_CurrentTime + delay_samples;
+  uint64_t start_time = GetEventTime() + delay_samples;
   unsigned eventIntervalMs = SamplesDiffToMs(prevEventTime, start_time);
 
   GOSoundSampler *sampler = nullptr;
@@ -450,6 +600,7 @@ GOSoundSampler *GOSoundOrganEngine::CreateTaskSample(
       sampler->p_SoundProvider = pSoundProvider;
       sampler->m_WaveTremulantStateFor = section->GetWaveTremulantStateFor();
       sampler->velocity = velocity;
+      sampler->m_Tuning = pSoundProvider->GetTuning();
       sampler->stream.InitStream(
         &m_resample,
         section,
@@ -502,7 +653,7 @@ void GOSoundOrganEngine::SwitchToAnotherAttack(GOSoundSampler *pSampler) {
         pSampler->stream.InitAlignedStream(
           section, m_interpolation, &new_sampler->stream);
         pSampler->p_SoundProvider = pProvider;
-        pSampler->time = m_CurrentTime + 1;
+        pSampler->time = m_CurrentTime + m_SamplesPerBuffer;
 
         pSampler->fader.Setup(
           gain_target,
@@ -530,14 +681,20 @@ void GOSoundOrganEngine::CreateReleaseSampler(GOSoundSampler *handle) {
    * automatically be placed back in the pool when the fade restores to
    * zero. */
   const GOSoundProvider *this_pipe = handle->p_SoundProvider;
+  // the sampler is passed to the next block, so the stop inside it is honored
+  const uint64_t stopTime = handle->stop;
+  const uint64_t releaseTime
+    = std::max(stopTime, m_CurrentTime + m_SamplesPerBuffer);
   const GOSoundAudioSection *release_section = this_pipe->GetRelease(
     handle->m_WaveTremulantStateFor,
-    SamplesDiffToMs(handle->time, m_CurrentTime));
+    SamplesDiffToMs(handle->time, releaseTime));
   unsigned crossFadeSamples = MsToSamples(
     release_section ? release_section->GetReleaseCrossfadeLength()
                     : this_pipe->GetAttackSwitchCrossfadeLength());
 
-  handle->fader.StartDecreasingVolume(crossFadeSamples);
+  // ProcessSampler starts decreasing at releaseTime
+  handle->decay_time = releaseTime;
+  handle->decay_length = crossFadeSamples;
   handle->is_release = true;
 
   int taskId = handle->m_SamplerTaskId;
@@ -552,7 +709,7 @@ void GOSoundOrganEngine::CreateReleaseSampler(GOSoundSampler *handle) {
     GOSoundSampler *new_sampler = m_SamplerPool.GetSampler();
     if (new_sampler != NULL) {
       new_sampler->p_SoundProvider = this_pipe;
-      new_sampler->time = m_CurrentTime + 1;
+      new_sampler->time = releaseTime;
       new_sampler->m_WaveTremulantStateFor
         = release_section->GetWaveTremulantStateFor();
 
@@ -569,7 +726,7 @@ void GOSoundOrganEngine::CreateReleaseSampler(GOSoundSampler *handle) {
         gain_target *= vol;
         if (m_ScaledReleases) {
           /* Note: "time" is in milliseconds. */
-          int time = ((m_CurrentTime - handle->time) * 1000) / m_SampleRate;
+          int time = SamplesDiffToMs(handle->time, releaseTime);
           /* TODO: below code should be replaced by a more accurate model of the
            * attack to get a better estimate of the amplitude when playing very
            * short notes; estimating attack duration from pipe MIDI pitch */
@@ -641,7 +798,9 @@ void GOSoundOrganEngine::CreateReleaseSampler(GOSoundSampler *handle) {
         && release_section->SupportsStreamAlignment()) {
         new_sampler->stream.InitAlignedStream(
           release_section, m_interpolation, &handle->stream);
+        new_sampler->m_Tuning = handle->m_Tuning;
       } else {
+        new_sampler->m_Tuning = this_pipe->GetTuning();
         new_sampler->stream.InitStream(
           &m_resample,
           release_section,
@@ -679,7 +838,7 @@ uint64_t GOSoundOrganEngine::StopSample(
   if (pipe != handle->p_SoundProvider)
     return 0;
 
-  handle->stop = m_CurrentTime + handle->delay;
+  handle->stop = GetEventTime() + handle->delay;
   return handle->stop;
 }
 
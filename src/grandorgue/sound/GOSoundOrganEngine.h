@@ -27,6 +27,7 @@ class GOOrganModel;
 class GOSoundBufferMutable;
 class GOSoundProvider;
 class GOSoundRecorder;
+class GOSoundSamplerList;
 class GOSoundGroupTask;
 class GOSoundOutputTask;
 class GOSoundReleaseTask;
@@ -56,6 +57,13 @@ private:
   bool m_ScaledReleases;
   bool m_ReleaseAlignmentEnabled;
   bool m_RandomizeSpeaking;
+  /* The samples of timestamped events are played this number of periods after
+   * the event time. 0 - the events are positioned at the start of the period
+   * they are processed in. Exact positioning needs 2 periods: the event must
+   * be processed before the period containing the event time is computed,
+   * including the release detection that occurs one period before the
+   * release */
+  unsigned m_EventLatencyPeriods;
   int m_Volume;
   unsigned m_SamplesPerBuffer;
   float m_Gain;
@@ -63,6 +71,9 @@ private:
 
   // time in samples
   uint64_t m_CurrentTime;
+  // the smoothed steady clock time in ns corresponding to the sample 0.
+  // 0 - unknown
+  std::atomic<int64_t> m_ClockOriginNs;
   GOSoundSamplerPool m_SamplerPool;
   unsigned m_AudioGroupCount;
   std::atomic_uint m_UsedPolyphony;
@@ -114,8 +125,24 @@ private:
 
   unsigned MsToSamples(unsigned ms) const { return m_SampleRate * ms / 1000; }
 
+  /**
+   * Applies the fader of the sampler to the frames of the block starting
+   * from startFrame
+   */
+  static void ApplyVolume(
+    GOSoundSampler *sampler,
+    float *buffer,
+    unsigned nFrames,
+    const float *volumes,
+    unsigned startFrame);
+
   unsigned SamplesDiffToMs(uint64_t fromSamples, uint64_t toSamples) const;
 
+  /**
+   * Updates m_ClockOriginNs from the current time. Is called once per period
+   */
+  void UpdateClockOrigin();
+
   /* samplerTaskId:
      -1 .. -n Tremulants
      0 (DETACHED_RELEASE_TASK_ID) detached release
@@ -131,6 +158,11 @@ private:
     return -taskId - 1;
   }
 
+  GOSoundSamplerList &GetSamplerList(const GOSoundSampler *sampler);
+  /**
+   * Passes a new sampler to its task. If the current thread has opened
+   * a GOSoundSamplerBatch::Scope then the sampler is passed when the scope ends
+   */
   void StartSampler(GOSoundSampler *sampler);
 
   GOSoundSampler *CreateTaskSample(
@@ -155,11 +187,53 @@ private:
   unsigned GetBufferSizeFor(unsigned outputIndex, unsigned n_frames) const;
 
 public:
+  /**
+   * While an object of this class exists, the samples started or stopped from
+   * the current thread are positioned at the given time inside the period
+   * instead of the beginning of the current period
+   */
+  class EventTimeScope {
+  private:
+    int64_t m_PrevTimeNs;
+
+  public:
+    /**
+     * @param timeNs the steady clock time of the event in ns. 0 - unknown
+     */
+    EventTimeScope(int64_t timeNs);
+    ~EventTimeScope();
+  };
+
+  /**
+   * The same as EventTimeScope but the time is given directly in samples of
+   * the engine clock. It is used when there is no real-time clock, ex. for
+   * offline rendering. Takes precedence over EventTimeScope
+   */
+  class EventSampleTimeScope {
+  private:
+    uint64_t m_PrevTime;
+
+  public:
+    /**
+     * @param time the engine time in samples. 0 - unknown
+     */
+    EventSampleTimeScope(uint64_t time);
+    ~EventSampleTimeScope();
+  };
+
   GOSoundOrganEngine();
   ~GOSoundOrganEngine();
 
   // Group 1: Independent setters (no call-order dependencies)
   unsigned GetSampleRate() const override { return m_SampleRate; }
+  /**
+   * Returns the time in samples to start or to stop a sample at for the event
+   * being processed in the current thread (see EventTimeScope and
+   * EventSampleTimeScope). If the event is not timestamped or the event
+   * latency is off, then returns m_CurrentTime. The sample time of
+   * EventSampleTimeScope is respected even when the event latency is off
+   */
+  uint64_t GetEventTime() const override;
   void SetSampleRate(unsigned sample_rate) { m_SampleRate = sample_rate; }
   void SetSamplesPerBuffer(unsigned sample_per_buffer) {
     m_SamplesPerBuffer = sample_per_buffer;
@@ -171,6 +245,9 @@ public:
   void SetPolyphonyLimiting(bool limiting) { m_PolyphonyLimiting = limiting; }
   void SetScaledReleases(bool enable) { m_ScaledReleases = enable; }
   void SetRandomizeSpeaking(bool enable) { m_RandomizeSpeaking = enable; }
+  void SetEventLatencyPeriods(unsigned periods) {
+    m_EventLatencyPeriods = periods;
+  }
   void SetInterpolationType(unsigned type) {
     m_interpolation = (GOSoundResample::InterpolationType)type;
   }
@@ -190,6 +267,18 @@ public:
   // Group 3: Other getters
   float GetGain() const { return m_Gain; }
   uint64_t GetTime() const { return m_CurrentTime; }
+  // the delay of positioning a timestamped event in samples
+  unsigned GetEventLatency() const {
+    return m_EventLatencyPeriods * m_SamplesPerBuffer;
+  }
+  /**
+   * Returns the steady clock timestamp an event should have for being
+   * positioned at the given time (see EventTimeScope). It is the inverse of
+   * GetEventTime()
+   * @param time the time in samples. Must not be less than GetTime()
+   * @return the timestamp in ns or 0 if the clock is not synchronized yet
+   */
+  int64_t GetEventTimeNs(uint64_t time) const;
   std::vector<float> GetMeterInfo();
   GOSoundScheduler &GetScheduler() { return m_Scheduler; }
 
@@ -241,8 +330,19 @@ public:
     unsigned outputIndex, bool isLast, GOSoundBufferMutable &outBuffer);
   void NextPeriod();
 
+  /**
+   * Renders one block of the sampler and adds it to the buffer
+   * @param volumes the volume of each frame of the block or nullptr for the
+   *   unity volume
+   * @param pitchFactor the windchest modulation of the playback speed
+   * @return if the sampler continues in the next block
+   */
   bool ProcessSampler(
-    float *buffer, GOSoundSampler *sampler, unsigned n_frames, float volume);
+    float *buffer,
+    GOSoundSampler *sampler,
+    unsigned n_frames,
+    const float *volumes,
+    float pitchFactor = 1.0f);
   void ProcessRelease(GOSoundSampler *sampler);
   void PassSampler(GOSoundSampler *sampler);
   void ReturnSampler(GOSoundSampler *sampler);
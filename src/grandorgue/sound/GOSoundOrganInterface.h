@@ -26,6 +26,13 @@ public:
   // ProxyDefault: 48000
   virtual unsigned GetSampleRate() const = 0;
 
+  /**
+   * Returns the engine time in samples of the event being processed in the
+   * current thread
+   */
+  // ProxyDefault: 0
+  virtual uint64_t GetEventTime() const = 0;
+
   // ProxyDefault: nullptr
   virtual GOSoundSampler *StartPipeSample(
     const GOSoundProvider *pipeProvider,
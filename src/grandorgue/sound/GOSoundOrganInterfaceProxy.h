@@ -25,6 +25,14 @@ public:
     return ForwardCall(&GOSoundOrganInterface::GetSampleRate, 48000u);
   }
 
+  /**
+   * Gets the time of the current event. Returns 0 if not connected.
+   */
+  uint64_t GetEventTime() const override {
+    return ForwardCall(
+      &GOSoundOrganInterface::GetEventTime, static_cast<uint64_t>(0));
+  }
+
   /**
    * Starts a pipe sample. Returns nullptr if not connected.
    */
@@ -123,6 +123,7 @@ void GOSoundSystem::OpenSound() {
   m_SoundEngine.SetHardPolyphony(m_config.PolyphonyLimit());
   m_SoundEngine.SetScaledReleases(m_config.ScaleRelease());
   m_SoundEngine.SetRandomizeSpeaking(m_config.RandomizeSpeaking());
+  m_SoundEngine.SetEventLatencyPeriods(m_config.EventLatency());
   m_SoundEngine.SetInterpolationType(m_config.m_InterpolationType());
   m_SoundEngine.SetAudioGroupCount(audio_group_count);
   unsigned sample_rate = m_config.SampleRate();
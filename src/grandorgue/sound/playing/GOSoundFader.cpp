@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2025 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -23,20 +23,15 @@ void GOSoundFader::Setup(
   m_DecreasingDeltaPerFrame = 0.0f;
   m_VelocityVolume = velocityVolume;
   m_LastExternalVolumePoint = -1; // will be set on the first Process() call
+  m_LastVelocityVolumePoint = -1;
 }
 
 // if the external volume is changed, do it smoothly in this number of frames
 static constexpr unsigned EXTERNAL_VOLUME_CHANGE_FRAMES = 1024;
 
-void GOSoundFader::Process(
-  unsigned nFrames, float *buffer, float externalVolume) {
-  // setup process
-
-  float startTargetVolumePoint = m_LastTargetVolumePoint;
-
-  // Calculate new m_LastTargetVolumePoint
-  // the target volume will be changed from startTargetVolumePoint to
-  // m_LastTargetVolumePoint during the nFrames
+void GOSoundFader::AdvanceTargetVolume(unsigned nFrames) {
+  // the target volume will be changed from the current
+  // m_LastTargetVolumePoint to the new one during the nFrames
 
   unsigned framesLeftAfterIncreasing = nFrames;
 
@@ -76,6 +71,15 @@ void GOSoundFader::Process(
       m_LastTargetVolumePoint = 0.0f;
     }
   }
+}
+
+void GOSoundFader::Process(
+  unsigned nFrames, float *buffer, float externalVolume) {
+  // setup process
+
+  float startTargetVolumePoint = m_LastTargetVolumePoint;
+
+  AdvanceTargetVolume(nFrames);
 
   // Calculate the external volume
   float targetExternalVolume = m_VelocityVolume * externalVolume;
@@ -120,3 +124,27 @@ void GOSoundFader::Process(
     }
   }
 }
+
+void GOSoundFader::Process(
+  unsigned nFrames, float *buffer, const float *externalVolumes) {
+  const float startTargetVolumePoint = m_LastTargetVolumePoint;
+
+  AdvanceTargetVolume(nFrames);
+  if (m_LastVelocityVolumePoint < 0.0f)
+    m_LastVelocityVolumePoint = m_VelocityVolume;
+
+  // the external volume is already smoothed, so only the target and the
+  // velocity volumes are changed linearly during the nFrames
+  float frameVolume = startTargetVolumePoint * m_LastVelocityVolumePoint;
+  const float frameVolumeDelta
+    = (m_LastTargetVolumePoint * m_VelocityVolume - frameVolume) / nFrames;
+
+  m_LastVelocityVolumePoint = m_VelocityVolume;
+  for (unsigned int i = 0; i < nFrames; i++, buffer += 2) {
+    const float frameTotalVolume = frameVolume * externalVolumes[i];
+
+    buffer[0] *= frameTotalVolume;
+    buffer[1] *= frameTotalVolume;
+    frameVolume += frameVolumeDelta;
+  }
+}
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -32,7 +32,9 @@
  *   ReleseTail limitation is used
  *
  * totalVol = targetVolume * externalVolume
- * This volume is applied in the Process() call
+ * This volume is applied in the Process() call. The external volume may be
+ * passed either as one value per period that the fader smooths itself or as a
+ * ramp of per frame values already smoothed by the caller
  */
 
 class GOSoundFader {
@@ -51,6 +53,11 @@ private:
   // Last volume points are the volumes at the end of previous Process()
   float m_LastTargetVolumePoint;
   float m_LastExternalVolumePoint;
+  // the velocity volume at the end of previous Process() with a volume ramp
+  float m_LastVelocityVolumePoint;
+
+  // Calculates the new m_LastTargetVolumePoint after nFrames
+  void AdvanceTargetVolume(unsigned nFrames);
 
 public:
   /**
@@ -94,6 +101,12 @@ public:
 
   void Process(unsigned nFrames, float *buffer, float externalVolume);
 
+  /**
+   * Applies the volume to the frames
+   * @param externalVolumes the external volume of each of nFrames frames
+   */
+  void Process(unsigned nFrames, float *buffer, const float *externalVolumes);
+
   bool IsSilent() const { return (m_LastTargetVolumePoint <= 0.0f); }
 };
 
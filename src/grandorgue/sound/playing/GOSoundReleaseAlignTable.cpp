@@ -9,6 +9,9 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
+#include <cstdint>
+
 #include "loader/cache/GOCache.h"
 #include "loader/cache/GOCacheWriter.h"
 
@@ -50,6 +53,61 @@ bool GOSoundReleaseAlignTable::Save(GOCacheWriter &cache) {
   return true;
 }
 
+static constexpr unsigned N_CELLS
+  = PHASE_ALIGN_DERIVATIVES * PHASE_ALIGN_AMPLITUDES;
+static constexpr unsigned ANALYSIS_CHUNK_LENGTH = 256;
+
+static inline int sum_channels(
+  const GOSoundAudioSection &release,
+  unsigned position,
+  unsigned channels,
+  GOSoundCompressionCache &cache) {
+  int f = 0;
+
+  for (unsigned int j = 0; j < channels; j++)
+    f += release.GetSample(position, j, &cache);
+  return f;
+}
+
+/**
+ * Calculates the table cell (derivIndex * PHASE_ALIGN_AMPLITUDES + ampIndex)
+ * for each of n sample points.
+ * The integer divisions are done in double precision. The quotients are exact
+ * enough for the truncated result to be the same as of the integer division,
+ * but unlike the integer division they may be vectorized.
+ * @param pSums n + 1 sums of all channels. pSums[0] is the sum at the point
+ *   preceding the first one
+ * @param pCells the n calculated cell indices
+ */
+static void compute_cells(
+  const int *__restrict pSums,
+  uint8_t *__restrict pCells,
+  unsigned n,
+  int maxAmplitude,
+  int maxDerivative) {
+  const double derivDivisor = 2.0 * maxDerivative;
+  const double ampDivisor = 2.0 * maxAmplitude;
+
+  // The compiler should auto-vectorize this loop
+  for (unsigned k = 0; k < n; k++) {
+    const int f = pSums[k + 1];
+    /* Bring v into the range -1..2*maxDerivative-1 */
+    const double vMod = double(f - pSums[k]) + (maxDerivative - 1);
+    /* Bring f into the range -1..2*maxAmplitude-1 */
+    const double fMod = double(f) + (maxAmplitude - 1);
+    const int derivIndex = std::clamp(
+      int(PHASE_ALIGN_DERIVATIVES * vMod / derivDivisor),
+      0,
+      PHASE_ALIGN_DERIVATIVES - 1);
+    const int ampIndex = std::clamp(
+      int(PHASE_ALIGN_AMPLITUDES * fMod / ampDivisor),
+      0,
+      PHASE_ALIGN_AMPLITUDES - 1);
+
+    pCells[k] = uint8_t(derivIndex * PHASE_ALIGN_AMPLITUDES + ampIndex);
+  }
+}
+
 void GOSoundReleaseAlignTable::ComputeTable(
   const GOSoundAudioSection &release,
   int phase_align_max_amplitude,
@@ -87,45 +145,41 @@ void GOSoundReleaseAlignTable::ComputeTable(
   bool found[PHASE_ALIGN_DERIVATIVES][PHASE_ALIGN_AMPLITUDES];
   memset(found, 0, sizeof(found));
 
-  int f_p = 0;
-  for (unsigned int j = 0; j < channels; j++)
-    f_p += release.GetSample(start_position + (BLOCK_HISTORY - 1), j, &cache);
-
-  for (unsigned i = BLOCK_HISTORY; i < required_search_len; i++) {
-    /* Store previous values */
-    int f = 0;
-    for (unsigned int j = 0; j < channels; j++)
-      f += release.GetSample(start_position + i, j, &cache);
-
-    /* Bring v into the range -1..2*m_PhaseAlignMaxDerivative-1 */
-    int v_mod = (f - f_p) + m_PhaseAlignMaxDerivative - 1;
-    int derivIndex
-      = (PHASE_ALIGN_DERIVATIVES * v_mod) / (2 * m_PhaseAlignMaxDerivative);
-
-    /* Bring f into the range -1..2*m_PhaseAlignMaxAmplitude-1 */
-    int f_mod = f + m_PhaseAlignMaxAmplitude - 1;
-    int ampIndex
-      = (PHASE_ALIGN_AMPLITUDES * f_mod) / (2 * m_PhaseAlignMaxAmplitude);
-
-    /* Store this release point if it was not already found */
-    derivIndex = (derivIndex < 0)
-      ? 0
-      : (
-        (derivIndex >= PHASE_ALIGN_DERIVATIVES) ? PHASE_ALIGN_DERIVATIVES - 1
-                                                : derivIndex);
-    ampIndex = (ampIndex < 0)
-      ? 0
-      : (
-        (ampIndex >= PHASE_ALIGN_AMPLITUDES) ? PHASE_ALIGN_AMPLITUDES - 1
-                                             : ampIndex);
-    assert((derivIndex >= 0) && (derivIndex < PHASE_ALIGN_DERIVATIVES));
-    assert((ampIndex >= 0) && (ampIndex < PHASE_ALIGN_AMPLITUDES));
-    if (!found[derivIndex][ampIndex]) {
-      m_PositionEntries[derivIndex][ampIndex] = i + 1 + start_position;
-      found[derivIndex][ampIndex] = true;
-    }
+  bool *pFound = &found[0][0];
+  int *pEntries = &m_PositionEntries[0][0];
+  unsigned nFound = 0;
+  /* The release is analysed by chunks so the analysis stops as soon as all
+   * table entries are found */
+  int sums[ANALYSIS_CHUNK_LENGTH + 1];
+  uint8_t cells[ANALYSIS_CHUNK_LENGTH];
+
+  int f_p = sum_channels(
+    release, start_position + (BLOCK_HISTORY - 1), channels, cache);
 
-    f_p = f;
+  for (unsigned chunkStart = BLOCK_HISTORY;
+       chunkStart < required_search_len && nFound < N_CELLS;
+       chunkStart += ANALYSIS_CHUNK_LENGTH) {
+    const unsigned n
+      = std::min(ANALYSIS_CHUNK_LENGTH, required_search_len - chunkStart);
+
+    sums[0] = f_p;
+    for (unsigned k = 0; k < n; k++)
+      sums[k + 1] = sum_channels(
+        release, start_position + chunkStart + k, channels, cache);
+    compute_cells(
+      sums, cells, n, m_PhaseAlignMaxAmplitude, m_PhaseAlignMaxDerivative);
+
+    /* Store the release points that were not already found */
+    for (unsigned k = 0; k < n; k++) {
+      const uint8_t cell = cells[k];
+
+      if (!pFound[cell]) {
+        pEntries[cell] = chunkStart + k + 1 + start_position;
+        pFound[cell] = true;
+        nFound++;
+      }
+    }
+    f_p = sums[n];
   }
 
 #ifndef NDEBUG
@@ -21,6 +21,7 @@
 
 #include "GOSoundResample.h"
 
+#include <algorithm>
 #include <cassert>
 #include <math.h>
 #include <stdlib.h>
@@ -35,8 +36,14 @@ void GOSoundResample::ResamplingPosition::Init(
   float factor, unsigned startIndex, const ResamplingPosition *pOld) {
   m_index = startIndex;
   m_fraction = pOld ? pOld->m_fraction : 0;
-  m_FractionIncrement
-    = roundf(factor * (pOld ? pOld->m_FractionIncrement : UPSAMPLE_FACTOR));
+  m_ExactIncrement
+    = factor * (pOld ? pOld->m_ExactIncrement : float(UPSAMPLE_FACTOR));
+  m_FractionIncrement = roundf(m_ExactIncrement);
+}
+
+void GOSoundResample::ResamplingPosition::Retune(float factor) {
+  m_ExactIncrement *= factor;
+  m_FractionIncrement = std::max(1u, unsigned(roundf(m_ExactIncrement)));
 }
 
 static double sinc(const double arg) {
@@ -2,7 +2,7 @@
  * GrandOrgue - free pipe organ simulator based on MyOrgan
  *
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  *
  * This program is free software; you can redistribute it and/or
  * modify it under the terms of the GNU General Public License as
@@ -58,6 +58,9 @@ public:
     // Increment of the source position for one target sample in
     //   1/UPSAMPLE_FACTOR units
     unsigned m_FractionIncrement;
+    // m_FractionIncrement before rounding. Repeated retuning is applied to it
+    //   so the rounding errors do not accumulate
+    float m_ExactIncrement;
 
   public:
     inline unsigned GetIndex() const { return m_index; }
@@ -79,6 +82,13 @@ public:
       unsigned startIndex = 0,
       const ResamplingPosition *pOld = nullptr);
 
+    /**
+     * Multiplies the resampling factor without changing the current position,
+     * so the stream continues without a phase jump
+     * @param factor the ratio of the new resampling factor to the old one
+     */
+    void Retune(float factor);
+
     /**
      * Advance the position for the next target sample
      */
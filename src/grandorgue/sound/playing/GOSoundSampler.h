@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2024 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -23,6 +23,10 @@ struct GOSoundSampler {
   GOSoundWindchestTask *p_WindchestTask;
   unsigned m_AudioGroupId;
   GOSoundStream stream;
+  /* the tuning of p_SoundProvider multiplied by the windchest pitch factor
+   * the stream is playing with. If any of them changes, the stream is
+   * retuned at the next block */
+  float m_Tuning;
   GOSoundFader fader;
   GOSoundFilter::FilterState toneBalanceFilterState;
   uint64_t time;
@@ -31,6 +35,10 @@ struct GOSoundSampler {
   /* current index of the current block into this sample */
   volatile unsigned long stop;
   volatile unsigned long new_attack;
+  /* the time when the volume starts decreasing during decay_length frames.
+   * 0 - no pending decay */
+  uint64_t decay_time;
+  unsigned decay_length;
   GOBool3 m_WaveTremulantStateFor;
   bool is_release;
   unsigned drop_counter;
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOSoundSamplerBatch.h"
+
+#include <vector>
+
+#include "GOSoundSampler.h"
+#include "GOSoundSamplerList.h"
+
+// the samplers collected for one list
+struct GOSoundSamplerChain {
+  GOSoundSamplerList *p_list;
+  GOSoundSampler *p_first;
+  GOSoundSampler *p_last;
+  unsigned m_count;
+};
+
+// the number of nested scopes in the current thread
+static thread_local unsigned t_ScopeDepth = 0;
+// there are only a few lists (audio groups, tremulants), so a linear search
+// is fast. The vector keeps its capacity between batches
+static thread_local std::vector<GOSoundSamplerChain> t_Chains;
+
+GOSoundSamplerBatch::Scope::Scope() { t_ScopeDepth++; }
+
+GOSoundSamplerBatch::Scope::~Scope() {
+  if (--t_ScopeDepth)
+    return;
+  for (const GOSoundSamplerChain &chain : t_Chains)
+    chain.p_list->PutChain(chain.p_first, chain.p_last, chain.m_count);
+  t_Chains.clear();
+}
+
+bool GOSoundSamplerBatch::Add(
+  GOSoundSamplerList &list, GOSoundSampler *sampler) {
+  if (!t_ScopeDepth)
+    return false;
+  for (GOSoundSamplerChain &chain : t_Chains)
+    if (chain.p_list == &list) {
+      sampler->next = chain.p_first;
+      chain.p_first = sampler;
+      chain.m_count++;
+      return true;
+    }
+  sampler->next = nullptr;
+  t_Chains.push_back({&list, sampler, sampler, 1});
+  return true;
+}
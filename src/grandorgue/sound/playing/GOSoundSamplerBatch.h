@@ -0,0 +1,41 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOSOUNDSAMPLERBATCH_H
+#define GOSOUNDSAMPLERBATCH_H
+
+class GOSoundSampler;
+class GOSoundSamplerList;
+
+/**
+ * Collects the samplers started by the current thread while a Scope exists
+ * and passes them to their sampler lists when the outermost Scope ends. So
+ * all pipes started by one event (a chord, a piston) begin in the same period
+ * and each sampler list receives them with a single atomic operation
+ */
+class GOSoundSamplerBatch {
+public:
+  class Scope {
+  public:
+    Scope();
+    ~Scope();
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+  };
+
+  /**
+   * Adds a started sampler to the batch of the current thread
+   * @param list the list the sampler should be put to
+   * @param sampler the sampler
+   * @return false if there is no batch in the current thread. Then the caller
+   *   must put the sampler to the list itself
+   */
+  static bool Add(GOSoundSamplerList &list, GOSoundSampler *sampler);
+};
+
+#endif /* GOSOUNDSAMPLERBATCH_H */
@@ -1,6 +1,6 @@
 /*
  * Copyright 2006 Milan Digital Audio LLC
- * Copyright 2009-2023 GrandOrgue contributors (see AUTHORS)
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
  * License GPL-2.0 or later
  * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
  */
@@ -40,17 +40,25 @@ public:
     } while (true);
   }
 
-  void Put(GOSoundSampler *sampler) {
+  /**
+   * Puts several samplers at once with a single atomic operation
+   * @param first the first sampler of a chain linked with next
+   * @param last the last sampler of the chain
+   * @param count the number of samplers in the chain
+   */
+  void PutChain(GOSoundSampler *first, GOSoundSampler *last, unsigned count) {
     do {
       GOSoundSampler *current = m_PutList;
-      sampler->next = current;
-      if (m_PutList.compare_exchange_strong(current, sampler)) {
-        m_PutCount.fetch_add(1);
+      last->next = current;
+      if (m_PutList.compare_exchange_strong(current, first)) {
+        m_PutCount.fetch_add(count);
         return;
       }
     } while (true);
   }
 
+  void Put(GOSoundSampler *sampler) { PutChain(sampler, sampler, 1); }
+
   unsigned GetCount() { return m_PutCount; }
 
   void Move() {
@@ -95,6 +95,10 @@ public:
     GOSoundResample::InterpolationType interpolation,
     const GOSoundStream *existing_stream);
 
+  /* Change the playback speed of the stream by the factor. The current
+   * position is kept */
+  void Retune(float factor) { m_ResamplingPos.Retune(factor); }
+
   /* Read an audio buffer from an audio section stream */
   bool ReadBlock(float *buffer, unsigned int n_blocks);
 };
@@ -7,6 +7,8 @@
 
 #include "GOSoundProvider.h"
 
+#include <cmath>
+
 #include <wx/intl.h>
 
 #include "loader/cache/GOCache.h"
@@ -165,7 +167,7 @@ int GOSoundProvider::IsOneshot() const {
 }
 
 void GOSoundProvider::SetTuning(float cent) {
-  m_Tuning = pow(pow(2, 1.0 / 1200.0), cent);
+  m_Tuning.store(exp2f(cent / 1200.0f), std::memory_order_relaxed);
 }
 
 void GOSoundProvider::SetToneBalanceValue(int8_t value) {
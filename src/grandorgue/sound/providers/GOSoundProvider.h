@@ -8,6 +8,7 @@
 #ifndef GOSOUNDPROVIDER_H_
 #define GOSOUNDPROVIDER_H_
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
@@ -41,7 +42,8 @@ protected:
   unsigned m_MidiKeyNumber;
   float m_MidiPitchFract;
   float m_Gain;
-  float m_Tuning;
+  // is set in the main thread and read by the audio threads
+  std::atomic<float> m_Tuning;
   int8_t m_ToneBalanceValue;
   GOSoundToneBalanceFilter m_ToneBalance;
   bool m_IsWaveTremulantActive;
@@ -84,6 +86,8 @@ public:
   int IsOneshot() const;
 
   float GetTuning() const;
+  // The samplers playing this provider follow the new tuning from the next
+  // block on
   void SetTuning(float cent);
   int8_t GetToneBalanceValue() const;
   void SetToneBalanceValue(int8_t value);
@@ -112,7 +116,9 @@ public:
 
 inline float GOSoundProvider::GetGain() const { return m_Gain; }
 
-inline float GOSoundProvider::GetTuning() const { return m_Tuning; }
+inline float GOSoundProvider::GetTuning() const {
+  return m_Tuning.load(std::memory_order_relaxed);
+}
 
 inline int8_t GOSoundProvider::GetToneBalanceValue() const {
   return m_ToneBalanceValue;
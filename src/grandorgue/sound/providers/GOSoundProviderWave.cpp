@@ -274,6 +274,9 @@ void GOSoundProviderWave::LoadFromOneFile(
       (GOWave::SAMPLE_FORMAT)bits_per_sample,
       wave.GetSampleRate(),
       wave_channels);
+    // the source samples are not needed more. Free them before allocating
+    // the sections
+    wave.ReleaseSampleData();
 
     if (is_attack)
       AddAttackSection(
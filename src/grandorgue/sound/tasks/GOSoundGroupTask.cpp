@@ -34,10 +34,7 @@ void GOSoundGroupTask::Clear() {
 }
 
 void GOSoundGroupTask::Add(GOSoundSampler *sampler) {
-  if (sampler->is_release)
-    m_Release.Put(sampler);
-  else
-    m_Active.Put(sampler);
+  GetListFor(sampler).Put(sampler);
 }
 
 void GOSoundGroupTask::ProcessList(
@@ -59,7 +56,11 @@ void GOSoundGroupTask::ProcessList(
     if (
       windchest
       && m_engine.ProcessSampler(
-        output_buffer, sampler, GetNFrames(), windchest->GetVolume()))
+        output_buffer,
+        sampler,
+        GetNFrames(),
+        windchest->GetVolumeRamp(),
+        windchest->GetPitchFactor()))
       Add(sampler);
   }
 }
@@ -56,6 +56,10 @@ public:
   void Reset();
   void Clear();
   void Add(GOSoundSampler *sampler);
+  // returns the list Add() would put the sampler to
+  GOSoundSamplerList &GetListFor(const GOSoundSampler *sampler) {
+    return sampler->is_release ? m_Release : m_Active;
+  }
   void WaitAndClear();
 };
 
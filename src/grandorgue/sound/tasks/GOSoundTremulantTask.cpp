@@ -57,7 +57,8 @@ void GOSoundTremulantTask::Run(GOSoundThread *thread) {
        sampler = m_Samplers.Get()) {
     bool keep;
     keep
-      = m_engine.ProcessSampler(output_buffer, sampler, m_SamplesPerBuffer, 1);
+      = m_engine.ProcessSampler(
+        output_buffer, sampler, m_SamplesPerBuffer, nullptr);
 
     if (keep)
       m_Samplers.Put(sampler);
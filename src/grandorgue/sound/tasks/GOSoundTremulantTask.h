@@ -36,6 +36,8 @@ public:
   void Reset();
   void Clear();
   void Add(GOSoundSampler *sampler);
+  // returns the list Add() would put the sampler to
+  GOSoundSamplerList &GetListFor(const GOSoundSampler *) { return m_Samplers; }
 
   float GetVolume() {
     if (!m_Done)
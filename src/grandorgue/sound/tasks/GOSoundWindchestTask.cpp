@@ -7,25 +7,47 @@
 
 #include "GOSoundWindchestTask.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "model/GOTremulant.h"
 #include "sound/GOSoundOrganEngine.h"
 #include "threading/GOMutexLocker.h"
 
 #include "GOSoundTremulantTask.h"
 
+// the time of spreading a change of the enclosure volume or of the gain
+static constexpr unsigned VOLUME_RAMP_MS = 20;
+
 GOSoundWindchestTask::GOSoundWindchestTask(
-  GOSoundOrganEngine &soundEngine, GOWindchest *pWindchest)
+  GOSoundOrganEngine &soundEngine,
+  GOWindchest *pWindchest,
+  unsigned samplesPerBuffer)
   : r_engine(soundEngine),
-    m_volume(0),
+    m_VolumeRamp(samplesPerBuffer),
+    m_RampFrames(1),
+    m_RampedVolume(-1),
+    m_RampedTarget(0),
+    m_RampedDelta(0),
+    m_LastTremulantVolume(0),
+    m_PitchFactor(1),
     m_done(false),
     p_windchest(pWindchest) {}
 
 void GOSoundWindchestTask::Init(
   ptr_vector<GOSoundTremulantTask> &tremulantTasks) {
+  m_RampFrames
+    = std::max(1u, r_engine.GetSampleRate() * VOLUME_RAMP_MS / 1000);
+  m_RampedVolume = -1;
   m_pTremulantTasks.clear();
+  m_TremulantPitches.clear();
   if (p_windchest)
-    for (unsigned i = 0; i < p_windchest->GetTremulantCount(); i++)
+    for (unsigned i = 0; i < p_windchest->GetTremulantCount(); i++) {
       m_pTremulantTasks.push_back(
         tremulantTasks[p_windchest->GetTremulantId(i)]);
+      m_TremulantPitches.push_back(
+        p_windchest->GetTremulant(i)->GetPitchPerAmplitude());
+    }
 }
 
 void GOSoundWindchestTask::Reset() {
@@ -39,15 +61,61 @@ void GOSoundWindchestTask::Run(GOSoundThread *pThread) {
     GOMutexLocker locker(m_mutex);
 
     if (!m_done.load()) {
-      float volume = r_engine.GetGain();
+      float tremulantVolume = 1;
+      float rampedVolume = r_engine.GetGain();
+      float pitchCents = 0;
 
       if (p_windchest) {
-        volume *= p_windchest->GetVolume();
-        for (unsigned i = 0; i < m_pTremulantTasks.size(); i++)
-          volume *= m_pTremulantTasks[i]->GetVolume();
+        rampedVolume *= p_windchest->GetVolume();
+        pitchCents += p_windchest->GetWindSagPitchOffset();
+        for (unsigned i = 0; i < m_pTremulantTasks.size(); i++) {
+          const float volume = m_pTremulantTasks[i]->GetVolume();
+
+          tremulantVolume *= volume;
+          pitchCents += m_TremulantPitches[i] * (volume - 1);
+        }
       }
-      m_volume = volume;
+      FillVolumeRamp(tremulantVolume, rampedVolume);
+      m_PitchFactor = pitchCents ? exp2f(pitchCents / 1200.0f) : 1.0f;
       m_done.store(true);
     }
   }
 }
+
+void GOSoundWindchestTask::FillVolumeRamp(
+  float tremulantVolume, float rampedVolume) {
+  if (m_RampedVolume < 0) {
+    // the first period after Init(). Nothing to smooth
+    m_RampedVolume = rampedVolume;
+    m_RampedTarget = rampedVolume;
+    m_RampedDelta = 0;
+    m_LastTremulantVolume = tremulantVolume;
+  }
+  if (rampedVolume != m_RampedTarget) {
+    // a new target is approached from the current volume in m_RampFrames
+    m_RampedTarget = rampedVolume;
+    m_RampedDelta = (rampedVolume - m_RampedVolume) / m_RampFrames;
+  }
+
+  const unsigned nFrames = m_VolumeRamp.size();
+  const float tremulantDelta
+    = (tremulantVolume - m_LastTremulantVolume) / nFrames;
+  float currTremulantVolume = m_LastTremulantVolume;
+  float currRampedVolume = m_RampedVolume;
+
+  for (unsigned i = 0; i < nFrames; i++) {
+    if (m_RampedDelta) {
+      currRampedVolume += m_RampedDelta;
+      if (
+        m_RampedDelta > 0 ? currRampedVolume >= m_RampedTarget
+                          : currRampedVolume <= m_RampedTarget) {
+        currRampedVolume = m_RampedTarget;
+        m_RampedDelta = 0;
+      }
+    }
+    currTremulantVolume += tremulantDelta;
+    m_VolumeRamp[i] = currTremulantVolume * currRampedVolume;
+  }
+  m_RampedVolume = currRampedVolume;
+  m_LastTremulantVolume = tremulantVolume;
+}
@@ -9,6 +9,7 @@
 #define GOSOUNDWINDCHESTTASK_H
 
 #include <atomic>
+#include <vector>
 
 #include "model/GOWindchest.h"
 #include "sound/scheduler/GOSoundTask.h"
@@ -24,14 +25,45 @@ class GOSoundWindchestTask : public GOSoundTask {
 private:
   GOSoundOrganEngine &r_engine;
   GOMutex m_mutex;
-  float m_volume;
+  /**
+   * The volume of each frame of the current period shared by all the
+   * windchest samplers. A change of the enclosure volume or of the engine
+   * gain is spread over m_RampFrames frames independently of the period size,
+   * so fast swell movements and volume changes do not click. The tremulant
+   * volumes are smooth curves already, so they change linearly within the
+   * period and keep their modulation depth
+   */
+  std::vector<float> m_VolumeRamp;
+  unsigned m_RampFrames;
+  // the enclosure volume multiplied by the engine gain at the end of the
+  // previous period. < 0 if unknown
+  float m_RampedVolume;
+  // the ramped volume that is being approached
+  float m_RampedTarget;
+  // the change of the ramped volume per frame while approaching
+  float m_RampedDelta;
+  // the tremulant volumes at the end of the previous period
+  float m_LastTremulantVolume;
+  // the pitch modulation of all the windchest samplers in this period
+  float m_PitchFactor;
   std::atomic_bool m_done;
   GOWindchest *p_windchest;
   std::vector<GOSoundTremulantTask *> m_pTremulantTasks;
+  // GOTremulant::GetPitchPerAmplitude() of each of m_pTremulantTasks
+  std::vector<float> m_TremulantPitches;
+
+  /**
+   * Fills m_VolumeRamp for the current period
+   * @param tremulantVolume the product of the tremulant volumes
+   * @param rampedVolume the enclosure volume multiplied by the engine gain
+   */
+  void FillVolumeRamp(float tremulantVolume, float rampedVolume);
 
 public:
   GOSoundWindchestTask(
-    GOSoundOrganEngine &sound_engine, GOWindchest *windchest);
+    GOSoundOrganEngine &sound_engine,
+    GOWindchest *windchest,
+    unsigned samples_per_buffer);
 
   unsigned GetGroup() override { return WINDCHEST; }
   unsigned GetCost() override { return 0; }
@@ -47,10 +79,22 @@ public:
     return p_windchest ? p_windchest->GetVolume() : 1;
   }
 
-  float GetVolume() {
+  // returns the volume of each frame of the current period
+  const float *GetVolumeRamp() {
+    if (!m_done.load())
+      Run();
+    return m_VolumeRamp.data();
+  }
+
+  /**
+   * Returns the factor of the playback speed of the windchest samplers in
+   * the current period. It reflects the wind sag and the tremulant pitch
+   * modulation
+   */
+  float GetPitchFactor() {
     if (!m_done.load())
       Run();
-    return m_volume;
+    return m_PitchFactor;
   }
 };
 
@@ -11,8 +11,16 @@
 
 #include "common/GOTestCollection.h"
 #include "testing/GOTestNameMap.h"
+#include "testing/loader/cache/GOTestCacheIndex.h"
+#include "testing/midi/GOTestMidiEvent.h"
+#include "testing/midi/GOTestMidiMatch.h"
+#include "testing/midi/GOTestMidiRouting.h"
+#include "testing/midi/GOTestPerfMidiDispatch.h"
+#include "testing/midi/GOTestPerfMidiMatch.h"
 #include "testing/model/GOTestDrawStop.h"
 #include "testing/model/GOTestOrganModel.h"
+#include "testing/model/GOTestPerfKeyMask.h"
+#include "testing/model/GOTestPipeConfigNode.h"
 #include "testing/model/GOTestSwitch.h"
 #include "testing/model/GOTestWindchest.h"
 #include "testing/sound/buffer/GOTestPerfSoundBufferMutable.h"
@@ -20,6 +28,9 @@
 #include "testing/sound/buffer/GOTestSoundBufferManaged.h"
 #include "testing/sound/buffer/GOTestSoundBufferMutable.h"
 #include "testing/sound/buffer/GOTestSoundBufferMutableMono.h"
+#include "testing/sound/playing/GOTestPerfReleaseAlignTable.h"
+#include "testing/sound/GOTestSoundEventTime.h"
+#include "testing/sound/GOTestSoundWindSag.h"
 
 int main(int argc, char *argv[]) {
   /*
@@ -48,12 +59,23 @@ int main(int argc, char *argv[]) {
   GOTestOrganModel testOrganModel;
   GOTestSwitch testSwitch;
   GOTestWindchest testWindchest;
+  GOTestPipeConfigNode testPipeConfigNode;
   GOTestNameMap goTestNameMap;
+  GOTestCacheIndex testCacheIndex;
+  GOTestMidiEvent testMidiEvent;
+  GOTestMidiMatch testMidiMatch;
+  GOTestMidiRouting testMidiRouting;
   GOTestSoundBuffer goTestSoundBuffer;
   GOTestSoundBufferManaged testSoundBufferManaged;
   GOTestSoundBufferMutable testSoundBufferMutable;
   GOTestSoundBufferMutableMono testSoundBufferMutableMono;
   GOTestPerfSoundBufferMutable testPerfSoundBufferMutable;
+  GOTestPerfMidiDispatch testPerfMidiDispatch;
+  GOTestPerfMidiMatch testPerfMidiMatch;
+  GOTestPerfKeyMask testPerfKeyMask;
+  GOTestPerfReleaseAlignTable testPerfReleaseAlignTable;
+  GOTestSoundEventTime testSoundEventTime;
+  GOTestSoundWindSag testSoundWindSag;
   /* end of instanciation */
   GOTestResultCollection test_result_collection;
   test_result_collection = GOTestCollection::Instance()->Run(categoryFilter);
@@ -28,7 +28,8 @@ bool GOTest::tearDown() { return true; }
 
 /* Class that initialize a new controller at each test setUp run */
 
-GOCommonControllerTest::GOCommonControllerTest() {}
+GOCommonControllerTest::GOCommonControllerTest(Category category)
+  : GOTest(category) {}
 
 bool GOCommonControllerTest::setUp() {
   // This initialize a new GOOrganController object that will be destroyed
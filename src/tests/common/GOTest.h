@@ -38,7 +38,7 @@ public:
 class GOCommonControllerTest : public GOTest {
 
 public:
-  GOCommonControllerTest();
+  GOCommonControllerTest(Category category = FUNCTIONAL);
   char *organ_directory;
   GOOrganController *controller;
   bool setUp();
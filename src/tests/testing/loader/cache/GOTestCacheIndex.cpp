@@ -0,0 +1,185 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestCacheIndex.h"
+
+#include <format>
+#include <vector>
+
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <wx/wfstream.h>
+
+#include "loader/cache/GOCache.h"
+#include "loader/cache/GOCacheIndex.h"
+#include "loader/cache/GOCacheWriter.h"
+
+#include "GOMemoryPool.h"
+
+const std::string GOTestCacheIndex::TEST_NAME = "GOTestCacheIndex";
+
+// the sizes of the entries written to the test cache. 0 is an empty object
+static const std::vector<unsigned> ENTRY_SIZES = {100, 0, 70000, 3};
+
+static GOHashType entry_hash(unsigned entryIndex) {
+  GOHashType hash = {};
+
+  hash.hash[0] = entryIndex + 1;
+  return hash;
+}
+
+static uint8_t entry_byte(unsigned entryIndex, unsigned pos) {
+  return uint8_t(entryIndex * 31 + pos);
+}
+
+// writes a cache file with ENTRY_SIZES entries the same way UpdateCache does
+static bool write_cache(const wxString &fileName, bool isCompressed) {
+  wxFileOutputStream file(fileName);
+  GOCacheWriter writer(file, isCompressed);
+  GOCacheIndex index;
+  bool isOk = file.IsOk() && writer.WriteHeader();
+
+  for (unsigned i = 0; isOk && i < ENTRY_SIZES.size(); i++) {
+    const uint64_t startPos = writer.GetPos();
+    std::vector<uint8_t> data(ENTRY_SIZES[i]);
+
+    for (unsigned j = 0; j < data.size(); j++)
+      data[j] = entry_byte(i, j);
+    isOk = writer.Write(data.data(), data.size());
+    index.AddEntry(entry_hash(i), writer.GetPos() - startPos);
+  }
+  isOk = writer.Finish() && isOk && index.Write(file);
+  file.Close();
+  return isOk;
+}
+
+static bool read_index(const wxString &fileName, GOCacheIndex &index) {
+  wxFile file(fileName);
+
+  return file.IsOpened() && index.Read(file);
+}
+
+void GOTestCacheIndex::TestRoundTrip(bool isCompressed) {
+  const std::string mode = isCompressed ? "compressed" : "uncompressed";
+  const wxString fileName = wxFileName::CreateTempFileName(wxT("gocache"));
+
+  GOAssert(
+    write_cache(fileName, isCompressed),
+    std::format("Unable to write the {} test cache", mode));
+
+  wxFile file(fileName);
+  GOCacheIndex index;
+
+  GOAssert(
+    index.Read(file), std::format("The {} cache index is rejected", mode));
+
+  const std::vector<GOCacheIndex::Entry> &entries = index.GetEntries();
+
+  GOAssert(
+    entries.size() == ENTRY_SIZES.size(),
+    std::format("The {} cache index has {} entries", mode, entries.size()));
+  for (unsigned i = 0; i < entries.size(); i++)
+    GOAssert(
+      entries[i].m_hash == entry_hash(i)
+        && entries[i].m_size == ENTRY_SIZES[i],
+      std::format("The {} cache index entry {} is wrong", mode, i));
+
+  // the data of each entry is found at the offset the index gives
+  GOMemoryPool pool;
+  GOCache reader(file, pool);
+
+  GOAssert(
+    reader.ReadHeader(), std::format("The {} cache has a bad header", mode));
+  for (unsigned i = 0; i < entries.size(); i++) {
+    const uint64_t startPos = reader.GetPos();
+
+    if (i % 2) {
+      // skip the odd entries as LoadCacheEntries does for unmatched ones
+      GOAssert(
+        reader.Skip(entries[i].m_size),
+        std::format("Unable to skip the {} cache entry {}", mode, i));
+      continue;
+    }
+
+    std::vector<uint8_t> data(entries[i].m_size);
+
+    GOAssert(
+      reader.Read(data.data(), data.size()),
+      std::format("Unable to read the {} cache entry {}", mode, i));
+    for (unsigned j = 0; j < data.size(); j++)
+      GOAssert(
+        data[j] == entry_byte(i, j),
+        std::format("The {} cache entry {} has wrong data", mode, i));
+    GOAssert(
+      reader.GetPos() - startPos == entries[i].m_size,
+      std::format("The {} cache entry {} has a wrong size", mode, i));
+  }
+  reader.Close();
+  file.Close();
+  wxRemoveFile(fileName);
+}
+
+void GOTestCacheIndex::TestTruncated() {
+  const wxString fileName = wxFileName::CreateTempFileName(wxT("gocache"));
+  const wxString truncatedName = fileName + wxT(".truncated");
+
+  GOAssert(write_cache(fileName, false), "Unable to write the test cache");
+
+  // copy all but the last byte, as if the writing has been interrupted
+  std::vector<uint8_t> content;
+  {
+    wxFile file(fileName);
+
+    content.resize(file.Length());
+    GOAssert(
+      file.Read(content.data(), content.size()) == ssize_t(content.size()),
+      "Unable to read the test cache");
+  }
+  {
+    wxFile file(truncatedName, wxFile::write);
+
+    file.Write(content.data(), content.size() - 1);
+  }
+
+  GOCacheIndex index;
+
+  GOAssert(
+    !read_index(truncatedName, index) && index.GetEntries().empty(),
+    "The index of a truncated cache is accepted");
+  wxRemoveFile(truncatedName);
+  wxRemoveFile(fileName);
+}
+
+void GOTestCacheIndex::TestStale() {
+  const wxString fileName = wxFileName::CreateTempFileName(wxT("gocache"));
+
+  GOAssert(write_cache(fileName, false), "Unable to write the test cache");
+  {
+    // change the size of the first entry so the index no longer describes the
+    // data. The trailer is 16 bytes, each entry has a hash and a 8 byte size
+    wxFile file(fileName, wxFile::read_write);
+    const wxFileOffset entrySize = sizeof(GOHashType::hash) + sizeof(uint64_t);
+    const wxFileOffset firstSizePos = file.Length() - 16
+      - entrySize * ENTRY_SIZES.size() + sizeof(GOHashType::hash);
+    const uint64_t wrongSize = ENTRY_SIZES[0] + 1;
+
+    file.Seek(firstSizePos);
+    file.Write(&wrongSize, sizeof(wrongSize));
+  }
+
+  GOCacheIndex index;
+
+  GOAssert(!read_index(fileName, index), "A stale cache index is accepted");
+  wxRemoveFile(fileName);
+}
+
+void GOTestCacheIndex::run() {
+  TestRoundTrip(false);
+  TestRoundTrip(true);
+  TestTruncated();
+  TestStale();
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTCACHEINDEX_H
+#define GOTESTCACHEINDEX_H
+
+#include "GOTest.h"
+
+#include <string>
+
+class GOTestCacheIndex : public GOTest {
+private:
+  static const std::string TEST_NAME;
+
+  void TestRoundTrip(bool isCompressed);
+  void TestTruncated();
+  void TestStale();
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTCACHEINDEX_H */
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestMidiEvent.h"
+
+#include <cstring>
+#include <format>
+#include <vector>
+
+#include "midi/GOMidiMap.h"
+#include "midi/events/GOMidiEvent.h"
+#include "midi/events/GORodgers.h"
+
+const std::string GOTestMidiEvent::TEST_NAME = "GOTestMidiEvent";
+
+/**
+ * Builds a Rodgers stop change message
+ * @param dataSize the number of data bytes
+ */
+static std::vector<uint8_t> make_rodgers_msg(unsigned dataSize) {
+  std::vector<uint8_t> msg {0xF0, 0x41, 0x10, 0x30, 0x12, 0x01, 0x00};
+
+  for (unsigned i = 0; i < dataSize; i++)
+    msg.push_back((i * 37) & 0x7F);
+  msg.push_back(0); // the checksum placeholder
+  msg.push_back(0xF7);
+  msg[msg.size() - 2] = GORodgersChecksum(msg, 5, msg.size() - 7);
+  return msg;
+}
+
+void GOTestMidiEvent::TestRodgersData() {
+  GOMidiMap map;
+  const std::vector<uint8_t> msg = make_rodgers_msg(GOMidiEvent::MAX_DATA_SIZE);
+  GOMidiEvent e;
+
+  e.FromMidi(msg, map);
+  GOAssert(
+    e.GetMidiType() == GOMidiEvent::MIDI_SYSEX_RODGERS_STOP_CHANGE,
+    std::format(
+      "A Rodgers message with {} data bytes is not recognized",
+      GOMidiEvent::MAX_DATA_SIZE));
+  GOAssert(
+    e.GetDataSize() == GOMidiEvent::MAX_DATA_SIZE
+      && !memcmp(e.GetData(), msg.data() + 7, GOMidiEvent::MAX_DATA_SIZE),
+    std::format("The Rodgers data is wrong: {} bytes", e.GetDataSize()));
+
+  std::vector<std::vector<uint8_t>> msgs;
+
+  e.ToMidi(msgs, map);
+  GOAssert(
+    msgs.size() == 1 && msgs[0] == msg,
+    "The Rodgers message is not converted back to the same bytes");
+
+  // a message longer than the 7-bit address range is ignored
+  GOMidiEvent e1;
+
+  e1.FromMidi(make_rodgers_msg(GOMidiEvent::MAX_DATA_SIZE + 1), map);
+  GOAssert(
+    e1.GetMidiType() == GOMidiEvent::MIDI_NONE,
+    std::format(
+      "A Rodgers message with {} data bytes is not ignored",
+      GOMidiEvent::MAX_DATA_SIZE + 1));
+}
+
+void GOTestMidiEvent::TestDisplayString() {
+  GOMidiMap map;
+  const std::string text(GOMidiEvent::MAX_STRING_LENGTH, 'A');
+  const std::string longText = text + "BCDEFGH";
+  GOMidiEvent e;
+  GOMidiEvent eLong;
+  std::vector<std::vector<uint8_t>> msgs;
+  std::vector<std::vector<uint8_t>> longMsgs;
+
+  e.SetMidiType(GOMidiEvent::MIDI_SYSEX_HW_LCD);
+  e.SetKey(1);
+  e.SetChannel(2);
+  e.SetString(wxString::FromAscii(text.c_str()));
+  GOAssert(
+    e.GetString() == wxString::FromAscii(text.c_str()),
+    std::format(
+      "A string of {} characters is not kept", GOMidiEvent::MAX_STRING_LENGTH));
+  e.ToMidi(msgs, map);
+  GOAssert(
+    msgs.size() == 1 && msgs[0].size() == 39
+      && std::string(msgs[0].begin() + 6, msgs[0].begin() + 38) == text,
+    "The LCD message does not contain the whole string");
+
+  // the longer string is cut to the same message as the display shows
+  eLong = e;
+  eLong.SetString(wxString::FromAscii(longText.c_str()));
+  GOAssert(
+    eLong.GetString() == wxString::FromAscii(text.c_str()),
+    "A long string is not truncated to the maximal length");
+  eLong.ToMidi(longMsgs, map);
+  GOAssert(
+    longMsgs == msgs, "A long string produces another LCD message than before");
+}
+
+void GOTestMidiEvent::run() {
+  TestRodgersData();
+  TestDisplayString();
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTMIDIEVENT_H
+#define GOTESTMIDIEVENT_H
+
+#include "GOTest.h"
+
+#include <string>
+
+/**
+ * Checks the conversion of the sysex messages with the variable size to
+ * events and back at the size limits of GOMidiEvent
+ */
+class GOTestMidiEvent : public GOTest {
+private:
+  static const std::string TEST_NAME;
+
+  void TestRodgersData();
+  void TestDisplayString();
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTMIDIEVENT_H */
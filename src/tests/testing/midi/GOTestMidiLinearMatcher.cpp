@@ -0,0 +1,405 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestMidiLinearMatcher.h"
+
+#include "midi/events/GOMidiEvent.h"
+#include "midi/events/GORodgers.h"
+
+GOMidiMatchType GOTestMidiLinearMatcher::debounce(
+  const GOMidiEvent &e, GOMidiMatchType event, unsigned index) {
+  if (e.GetTime() < m_last[index] + r_patterns.GetEvent(index).debounce_time)
+    return MIDI_MATCH_NONE;
+  m_last[index] = e.GetTime();
+  return event;
+}
+
+GOMidiMatchType GOTestMidiLinearMatcher::Match(
+  const GOMidiEvent &e,
+  const GOMidiReceiver::KeyMap *pMidiMap,
+  int transpose,
+  int &key,
+  int &value) {
+  const GOMidiReceiverType type = r_patterns.GetType();
+  const GOMidiEvent::MidiType eMidiType = e.GetMidiType();
+
+  value = 0;
+  for (unsigned i = 0; i < r_patterns.GetEventCount(); i++) {
+    const auto &pattern = r_patterns.GetEvent(i);
+
+    if (
+      pattern.channel != -1 && pattern.channel != e.GetChannel()
+      && GOMidiReceiver::hasChannel(pattern.type))
+      continue;
+    if (pattern.deviceId != 0 && pattern.deviceId != e.GetDevice())
+      continue;
+    if (type == MIDI_RECV_MANUAL) {
+      if (
+        pattern.type != MIDI_M_NOTE && pattern.type != MIDI_M_NOTE_NO_VELOCITY
+        && pattern.type != MIDI_M_NOTE_SHORT_OCTAVE
+        && pattern.type != MIDI_M_NOTE_NORMAL)
+        continue;
+      if (
+        eMidiType == GOMidiEvent::MIDI_NOTE
+        || eMidiType == GOMidiEvent::MIDI_AFTERTOUCH) {
+        if (e.GetKey() < pattern.low_key || e.GetKey() > pattern.high_key)
+          continue;
+        key = e.GetKey();
+        if (pattern.type == MIDI_M_NOTE_SHORT_OCTAVE) {
+          int no = e.GetKey() - pattern.low_key;
+          if (no <= 3)
+            continue;
+          if (no == 4 || no == 6 || no == 8)
+            key -= 4;
+        }
+        key = key + transpose + pattern.key;
+        if (key < 0)
+          continue;
+        if (key > 127)
+          continue;
+        if (
+          pMidiMap && pattern.type != MIDI_M_NOTE_SHORT_OCTAVE
+          && pattern.type != MIDI_M_NOTE_NORMAL)
+          key = (*pMidiMap)[key];
+        if (pattern.type == MIDI_M_NOTE_NO_VELOCITY) {
+          value = e.GetValue() ? 127 : 0;
+          if (eMidiType == GOMidiEvent::MIDI_AFTERTOUCH)
+            continue;
+        } else
+          value = pattern.ConvertSrcValueToInt(e.GetValue());
+        if (pattern.low_value <= pattern.high_value) {
+          if (e.GetValue() < pattern.low_value)
+            return MIDI_MATCH_OFF;
+          if (e.GetValue() <= pattern.high_value)
+            return MIDI_MATCH_ON;
+        } else {
+          if (e.GetValue() >= pattern.low_value)
+            return MIDI_MATCH_OFF;
+          if (e.GetValue() >= pattern.high_value)
+            return MIDI_MATCH_ON;
+        }
+        continue;
+      }
+      if (
+        eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
+        && e.GetKey() == MIDI_CTRL_NOTES_OFF)
+        return MIDI_MATCH_RESET;
+
+      if (
+        eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
+        && e.GetKey() == MIDI_CTRL_SOUNDS_OFF)
+        return MIDI_MATCH_RESET;
+
+      continue;
+    }
+    if (type == MIDI_RECV_ENCLOSURE) {
+      if (
+        pattern.type == MIDI_M_CTRL_CHANGE
+        && eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
+        && pattern.key == e.GetKey()) {
+        value = pattern.ConvertSrcValueToInt(e.GetValue());
+        return MIDI_MATCH_CHANGE;
+      }
+      if (
+        pattern.type == MIDI_M_RPN && eMidiType == GOMidiEvent::MIDI_RPN
+        && pattern.key == e.GetKey()) {
+        value = pattern.ConvertSrcValueToInt(e.GetValue());
+        return MIDI_MATCH_CHANGE;
+      }
+      if (
+        pattern.type == MIDI_M_NRPN && eMidiType == GOMidiEvent::MIDI_NRPN
+        && pattern.key == e.GetKey()) {
+        value = pattern.ConvertSrcValueToInt(e.GetValue());
+        return MIDI_MATCH_CHANGE;
+      }
+      if (
+        pattern.type == MIDI_M_PGM_RANGE
+        && eMidiType == GOMidiEvent::MIDI_PGM_CHANGE)
+        if (
+          (pattern.low_value <= e.GetKey() && e.GetKey() <= pattern.high_value)
+          || (pattern.high_value <= e.GetKey()
+              && e.GetKey() <= pattern.low_value)) {
+          value = pattern.ConvertSrcValueToInt(e.GetValue());
+          return MIDI_MATCH_CHANGE;
+        }
+      continue;
+    }
+    if (
+      eMidiType == GOMidiEvent::MIDI_NOTE && pattern.type == MIDI_M_NOTE
+      && pattern.key == e.GetKey()) {
+      if (pattern.low_value <= pattern.high_value) {
+        if (e.GetValue() <= pattern.low_value)
+          return MIDI_MATCH_OFF;
+        if (e.GetValue() >= pattern.high_value)
+          return MIDI_MATCH_ON;
+      } else {
+        if (e.GetValue() >= pattern.low_value)
+          return MIDI_MATCH_OFF;
+        if (e.GetValue() <= pattern.high_value)
+          return MIDI_MATCH_ON;
+      }
+      continue;
+    }
+    if (
+      eMidiType == GOMidiEvent::MIDI_NOTE && pattern.type == MIDI_M_NOTE_ON
+      && pattern.key == e.GetKey() && e.GetValue() >= pattern.high_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_NOTE && pattern.type == MIDI_M_NOTE_OFF
+      && pattern.key == e.GetKey() && e.GetValue() <= pattern.low_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_NOTE && pattern.type == MIDI_M_NOTE_ON_OFF
+      && pattern.key == e.GetKey() && e.GetValue() >= pattern.high_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_NOTE && pattern.type == MIDI_M_NOTE_ON_OFF
+      && pattern.key == e.GetKey() && e.GetValue() <= pattern.low_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+
+    if (
+      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
+      && pattern.type == MIDI_M_CTRL_CHANGE && pattern.key == e.GetKey()) {
+      if (pattern.low_value <= pattern.high_value) {
+        if (e.GetValue() <= pattern.low_value)
+          return debounce(e, MIDI_MATCH_OFF, i);
+        if (e.GetValue() >= pattern.high_value)
+          return debounce(e, MIDI_MATCH_ON, i);
+      } else {
+        if (e.GetValue() >= pattern.low_value)
+          return debounce(e, MIDI_MATCH_OFF, i);
+        if (e.GetValue() <= pattern.high_value)
+          return debounce(e, MIDI_MATCH_ON, i);
+      }
+      continue;
+    }
+    if (
+      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
+      && pattern.type == MIDI_M_CTRL_CHANGE_ON && pattern.key == e.GetKey()
+      && e.GetValue() >= pattern.high_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
+      && pattern.type == MIDI_M_CTRL_CHANGE_OFF && pattern.key == e.GetKey()
+      && e.GetValue() <= pattern.low_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
+      && pattern.type == MIDI_M_CTRL_CHANGE_ON_OFF && pattern.key == e.GetKey()
+      && e.GetValue() >= pattern.high_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
+      && pattern.type == MIDI_M_CTRL_CHANGE_ON_OFF && pattern.key == e.GetKey()
+      && e.GetValue() <= pattern.low_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
+      && pattern.type == MIDI_M_CTRL_CHANGE_FIXED
+      && pattern.key == e.GetKey()) {
+      if (e.GetValue() == pattern.low_value)
+        return debounce(e, MIDI_MATCH_OFF, i);
+      if (e.GetValue() == pattern.high_value)
+        return debounce(e, MIDI_MATCH_ON, i);
+      continue;
+    }
+    if (
+      ((eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
+        && pattern.type == MIDI_M_CTRL_CHANGE_FIXED_ON)
+       || (eMidiType == GOMidiEvent::MIDI_NOTE
+           && pattern.type == MIDI_M_NOTE_FIXED_ON))
+      && pattern.key == e.GetKey() && e.GetValue() == pattern.high_value)
+      return debounce(e, MIDI_MATCH_ON, i);
+    if (
+      ((eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
+        && pattern.type == MIDI_M_CTRL_CHANGE_FIXED_OFF)
+       || (eMidiType == GOMidiEvent::MIDI_NOTE
+           && pattern.type == MIDI_M_NOTE_FIXED_OFF))
+      && pattern.key == e.GetKey() && e.GetValue() == pattern.low_value)
+      return debounce(e, MIDI_MATCH_OFF, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
+      && pattern.type == MIDI_M_CTRL_CHANGE_FIXED_ON_OFF
+      && pattern.key == e.GetKey() && e.GetValue() == pattern.high_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
+      && pattern.type == MIDI_M_CTRL_CHANGE_FIXED_ON_OFF
+      && pattern.key == e.GetKey() && e.GetValue() == pattern.low_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_CTRL_CHANGE
+      && pattern.type == MIDI_M_CTRL_BIT && pattern.key == e.GetKey()) {
+      unsigned mask = 1 << pattern.low_value;
+      if (e.GetValue() & mask)
+        return debounce(e, MIDI_MATCH_ON, i);
+      else
+        return debounce(e, MIDI_MATCH_OFF, i);
+    }
+
+    if (
+      eMidiType == GOMidiEvent::MIDI_RPN && pattern.type == MIDI_M_RPN
+      && pattern.key == e.GetKey()) {
+      if (pattern.low_value <= pattern.high_value) {
+        if (e.GetValue() <= pattern.low_value)
+          return MIDI_MATCH_OFF;
+        if (e.GetValue() >= pattern.high_value)
+          return MIDI_MATCH_ON;
+      } else {
+        if (e.GetValue() >= pattern.low_value)
+          return MIDI_MATCH_OFF;
+        if (e.GetValue() <= pattern.high_value)
+          return MIDI_MATCH_ON;
+      }
+      continue;
+    }
+    if (
+      eMidiType == GOMidiEvent::MIDI_RPN && pattern.type == MIDI_M_RPN_ON
+      && pattern.key == e.GetKey() && e.GetValue() >= pattern.high_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_RPN && pattern.type == MIDI_M_RPN_OFF
+      && pattern.key == e.GetKey() && e.GetValue() <= pattern.low_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_RPN && pattern.type == MIDI_M_RPN_ON_OFF
+      && pattern.key == e.GetKey() && e.GetValue() >= pattern.high_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_RPN && pattern.type == MIDI_M_RPN_ON_OFF
+      && pattern.key == e.GetKey() && e.GetValue() <= pattern.low_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+
+    if (
+      eMidiType == GOMidiEvent::MIDI_NRPN && pattern.type == MIDI_M_NRPN
+      && pattern.key == e.GetKey()) {
+      if (pattern.low_value <= pattern.high_value) {
+        if (e.GetValue() <= pattern.low_value)
+          return MIDI_MATCH_OFF;
+        if (e.GetValue() >= pattern.high_value)
+          return MIDI_MATCH_ON;
+      } else {
+        if (e.GetValue() >= pattern.low_value)
+          return MIDI_MATCH_OFF;
+        if (e.GetValue() <= pattern.high_value)
+          return MIDI_MATCH_ON;
+      }
+      continue;
+    }
+    if (
+      eMidiType == GOMidiEvent::MIDI_NRPN && pattern.type == MIDI_M_NRPN_ON
+      && pattern.key == e.GetKey() && e.GetValue() >= pattern.high_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_NRPN && pattern.type == MIDI_M_NRPN_OFF
+      && pattern.key == e.GetKey() && e.GetValue() <= pattern.low_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_NRPN && pattern.type == MIDI_M_NRPN_ON_OFF
+      && pattern.key == e.GetKey() && e.GetValue() >= pattern.high_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_NRPN && pattern.type == MIDI_M_NRPN_ON_OFF
+      && pattern.key == e.GetKey() && e.GetValue() <= pattern.low_value)
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+
+    if (
+      eMidiType == GOMidiEvent::MIDI_PGM_CHANGE
+      && pattern.type == MIDI_M_PGM_CHANGE && pattern.key == e.GetKey()) {
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    }
+    if (
+      eMidiType == GOMidiEvent::MIDI_PGM_CHANGE
+      && pattern.type == MIDI_M_PGM_RANGE && pattern.low_value == e.GetKey())
+      return MIDI_MATCH_OFF;
+    if (
+      eMidiType == GOMidiEvent::MIDI_PGM_CHANGE
+      && pattern.type == MIDI_M_PGM_RANGE && pattern.high_value == e.GetKey())
+      return MIDI_MATCH_ON;
+    if (
+      eMidiType == GOMidiEvent::MIDI_SYSEX_JOHANNUS_9
+      && pattern.type == MIDI_M_SYSEX_JOHANNUS_9 && pattern.key == e.GetKey()) {
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    }
+    if (
+      eMidiType == GOMidiEvent::MIDI_SYSEX_JOHANNUS_11
+      && pattern.type == MIDI_M_SYSEX_JOHANNUS_11 && pattern.key == e.GetKey()
+      && pattern.low_value <= e.GetValue()
+      && pattern.high_value >= e.GetValue()) {
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    }
+    if (
+      eMidiType == GOMidiEvent::MIDI_RPN && pattern.type == MIDI_M_RPN_RANGE
+      && pattern.low_value == e.GetKey() && pattern.key == e.GetValue())
+      return MIDI_MATCH_OFF;
+    if (
+      eMidiType == GOMidiEvent::MIDI_RPN && pattern.type == MIDI_M_RPN_RANGE
+      && pattern.high_value == e.GetKey() && pattern.key == e.GetValue())
+      return MIDI_MATCH_ON;
+    if (
+      eMidiType == GOMidiEvent::MIDI_NRPN && pattern.type == MIDI_M_NRPN_RANGE
+      && pattern.low_value == e.GetKey() && pattern.key == e.GetValue())
+      return MIDI_MATCH_OFF;
+    if (
+      eMidiType == GOMidiEvent::MIDI_NRPN && pattern.type == MIDI_M_NRPN_RANGE
+      && pattern.high_value == e.GetKey() && pattern.key == e.GetValue())
+      return MIDI_MATCH_ON;
+
+    if (
+      eMidiType == GOMidiEvent::MIDI_SYSEX_VISCOUNT
+      && pattern.type == MIDI_M_SYSEX_VISCOUNT
+      && pattern.low_value == e.GetValue())
+      return MIDI_MATCH_OFF;
+    if (
+      eMidiType == GOMidiEvent::MIDI_SYSEX_VISCOUNT
+      && pattern.type == MIDI_M_SYSEX_VISCOUNT
+      && pattern.high_value == e.GetValue())
+      return MIDI_MATCH_ON;
+    if (
+      eMidiType == GOMidiEvent::MIDI_SYSEX_VISCOUNT
+      && pattern.type == MIDI_M_SYSEX_VISCOUNT_TOGGLE
+      && pattern.low_value == e.GetValue()) {
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    }
+    if (
+      eMidiType == GOMidiEvent::MIDI_SYSEX_RODGERS_STOP_CHANGE
+      && pattern.type == MIDI_M_SYSEX_RODGERS_STOP_CHANGE
+      && pattern.key == e.GetChannel()) {
+      switch (GORodgersGetBit(
+        pattern.low_value, e.GetKey(), e.GetData(), e.GetDataSize())) {
+      case MIDI_BIT_STATE::MIDI_BIT_CLEAR:
+        return MIDI_MATCH_OFF;
+
+      case MIDI_BIT_STATE::MIDI_BIT_SET:
+        return MIDI_MATCH_ON;
+
+      case MIDI_BIT_STATE::MIDI_BIT_NOT_PRESENT:;
+      }
+    }
+    if (
+      eMidiType == GOMidiEvent::MIDI_SYSEX_AHLBORN_GALANTI
+      && pattern.type == MIDI_M_SYSEX_AHLBORN_GALANTI
+      && pattern.low_value == e.GetValue())
+      return MIDI_MATCH_OFF;
+    if (
+      eMidiType == GOMidiEvent::MIDI_SYSEX_AHLBORN_GALANTI
+      && pattern.type == MIDI_M_SYSEX_AHLBORN_GALANTI
+      && pattern.high_value == e.GetValue())
+      return MIDI_MATCH_ON;
+    if (
+      eMidiType == GOMidiEvent::MIDI_SYSEX_AHLBORN_GALANTI
+      && pattern.type == MIDI_M_SYSEX_AHLBORN_GALANTI_TOGGLE
+      && pattern.low_value == e.GetValue())
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+    if (
+      eMidiType == GOMidiEvent::MIDI_SYSEX_AHLBORN_GALANTI
+      && pattern.type == MIDI_M_SYSEX_AHLBORN_GALANTI_TOGGLE
+      && pattern.high_value == e.GetValue())
+      return debounce(e, MIDI_MATCH_CHANGE, i);
+  }
+  return MIDI_MATCH_NONE;
+}
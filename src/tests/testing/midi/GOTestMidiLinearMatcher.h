@@ -0,0 +1,46 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTMIDILINEARMATCHER_H
+#define GOTESTMIDILINEARMATCHER_H
+
+#include <vector>
+
+#include "midi/elements/GOMidiReceiver.h"
+#include "midi/events/GOMidiReceiverEventPatternList.h"
+
+#include "GOTime.h"
+
+class GOMidiEvent;
+
+/**
+ * The reference implementation of the pattern matching of GOMidiReceiver.
+ * It checks every pattern with the full if-chain the same way as
+ * GOMidiReceiver::Match did before the patterns were compiled. The internal
+ * (sysex configured) matches are not supported.
+ */
+class GOTestMidiLinearMatcher {
+private:
+  const GOMidiReceiverEventPatternList &r_patterns;
+  std::vector<GOTime> m_last;
+
+  GOMidiMatchType debounce(
+    const GOMidiEvent &e, GOMidiMatchType event, unsigned index);
+
+public:
+  GOTestMidiLinearMatcher(const GOMidiReceiverEventPatternList &patterns)
+    : r_patterns(patterns), m_last(patterns.GetEventCount()) {}
+
+  GOMidiMatchType Match(
+    const GOMidiEvent &e,
+    const GOMidiReceiver::KeyMap *pMidiMap,
+    int transpose,
+    int &key,
+    int &value);
+};
+
+#endif /* GOTESTMIDILINEARMATCHER_H */
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestMidiMatch.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <random>
+#include <vector>
+
+#include "midi/elements/GOMidiReceiver.h"
+#include "midi/events/GOMidiEvent.h"
+
+#include "GOTestMidiLinearMatcher.h"
+
+const std::string GOTestMidiMatch::TEST_NAME = "GOTestMidiMatch";
+
+// Number of random events matched with every receiver
+static constexpr unsigned NUM_EVENTS = 20000;
+
+// Number of patterns of each message type in a receiver
+static constexpr unsigned NUM_VARIANTS = 4;
+
+// The keys and the values of the patterns and of the events are taken from
+// small ranges so that the events often hit the patterns
+static constexpr int NUM_KEYS = 24;
+static const int VALUES[] = {0, 1, 2, 3, 5, 60, 64, 126, 127};
+static constexpr unsigned NUM_VALUES = sizeof(VALUES) / sizeof(VALUES[0]);
+
+static const int TRANSPOSES[] = {0, -3, 110};
+static constexpr unsigned NUM_TRANSPOSES
+  = sizeof(TRANSPOSES) / sizeof(TRANSPOSES[0]);
+
+// the event types that may be matched by the patterns. The GO sysex events
+// configure the internal matches that the reference matcher does not support
+static const GOMidiEvent::MidiType EVENT_TYPES[] = {
+  GOMidiEvent::MIDI_NONE,
+  GOMidiEvent::MIDI_RESET,
+  GOMidiEvent::MIDI_NOTE,
+  GOMidiEvent::MIDI_AFTERTOUCH,
+  GOMidiEvent::MIDI_CTRL_CHANGE,
+  GOMidiEvent::MIDI_PGM_CHANGE,
+  GOMidiEvent::MIDI_RPN,
+  GOMidiEvent::MIDI_NRPN,
+  GOMidiEvent::MIDI_SYSEX_JOHANNUS_9,
+  GOMidiEvent::MIDI_SYSEX_JOHANNUS_11,
+  GOMidiEvent::MIDI_SYSEX_VISCOUNT,
+  GOMidiEvent::MIDI_SYSEX_AHLBORN_GALANTI,
+  GOMidiEvent::MIDI_SYSEX_HW_STRING,
+  GOMidiEvent::MIDI_SYSEX_HW_LCD,
+  GOMidiEvent::MIDI_SYSEX_RODGERS_STOP_CHANGE,
+};
+static constexpr unsigned NUM_EVENT_TYPES
+  = sizeof(EVENT_TYPES) / sizeof(EVENT_TYPES[0]);
+
+void GOTestMidiMatch::CheckReceiverType(GOMidiReceiverType type) {
+  std::mt19937 random(type + 1);
+  GOMidiReceiverEventPatternList patterns(type);
+
+  // the variants of each type are interleaved, so the order of the patterns
+  // matters when several of them match the same event
+  for (unsigned v = 0; v < NUM_VARIANTS; v++)
+    for (unsigned t = MIDI_M_NOTE; t <= MIDI_M_NOTE_NORMAL; t++) {
+      auto &pattern = patterns.GetEvent(patterns.AddNewEvent());
+      const int lowValue = VALUES[random() % NUM_VALUES];
+      const int highValue = VALUES[random() % NUM_VALUES];
+
+      pattern.type = GOMidiReceiverMessageType(t);
+      pattern.channel = v % 2 ? -1 : 1 + (t + v) % 4;
+      pattern.deviceId = v == 3 ? 2 : 0;
+      // the key offset of manuals or the channel of Rodgers stop changes
+      if (type == MIDI_RECV_MANUAL)
+        pattern.key = int(v) - 2;
+      else if (t == MIDI_M_SYSEX_RODGERS_STOP_CHANGE)
+        pattern.key = 1 + v;
+      else
+        pattern.key = random() % NUM_KEYS;
+      pattern.low_key = v * 4;
+      pattern.high_key = NUM_KEYS / 2 + v * 4;
+      // some patterns have the inverted value range
+      pattern.low_value = v % 2 ? std::max(lowValue, highValue)
+                                : std::min(lowValue, highValue);
+      pattern.high_value = v % 2 ? std::min(lowValue, highValue)
+                                 : std::max(lowValue, highValue);
+      if (t == MIDI_M_CTRL_BIT)
+        pattern.low_value = v;
+      pattern.debounce_time = v % 2 ? 0 : 20;
+    }
+
+  GOMidiReceiver receiver(type);
+  GOTestMidiLinearMatcher reference(patterns);
+  GOMidiReceiver::KeyMap reversedMap;
+  GOMidiEvent e;
+  int64_t timeMs = 1000;
+
+  // the patterns are set the same way as the midi event dialog does
+  receiver.RenewFrom(patterns);
+  for (unsigned i = 0; i < GOMidiReceiver::KEY_MAP_SIZE; i++)
+    reversedMap[i] = GOMidiReceiver::KEY_MAP_SIZE - 1 - i;
+  for (unsigned i = 0; i < NUM_EVENTS; i++) {
+    // every event type is sent many times within the debounce time
+    timeMs += random() % 15;
+    e.SetTime(GOTime(timeMs));
+    e.SetMidiType(EVENT_TYPES[random() % NUM_EVENT_TYPES]);
+    e.SetDevice(1 + random() % 2);
+    e.SetChannel(1 + random() % 4);
+    e.SetKey(random() % NUM_KEYS);
+    e.SetValue(VALUES[random() % NUM_VALUES]);
+    if (e.GetMidiType() == GOMidiEvent::MIDI_SYSEX_RODGERS_STOP_CHANGE) {
+      std::vector<uint8_t> data(random() % 4);
+
+      for (uint8_t &byte : data)
+        byte = random() & 0x7F;
+      e.SetKey(random() % 2);
+      e.SetData(data.data(), data.size());
+    }
+
+    const GOMidiReceiver::KeyMap *pMidiMap = i % 2 ? &reversedMap : nullptr;
+    const int transpose = TRANSPOSES[i % NUM_TRANSPOSES];
+    int expectedKey = -1;
+    int expectedValue = -1;
+    int key = -1;
+    int value = -1;
+    const GOMidiMatchType expected
+      = reference.Match(e, pMidiMap, transpose, expectedKey, expectedValue);
+    const GOMidiMatchType result
+      = receiver.Match(e, pMidiMap, transpose, key, value);
+
+    GOAssert(
+      result == expected && key == expectedKey && value == expectedValue,
+      std::format(
+        "Receiver type {}, event {} (type {}, channel {}, key {}, value {}): "
+        "matched {} with key {} and value {} instead of {} with key {} and "
+        "value {}",
+        int(type),
+        i,
+        int(e.GetMidiType()),
+        e.GetChannel(),
+        e.GetKey(),
+        e.GetValue(),
+        int(result),
+        key,
+        value,
+        int(expected),
+        expectedKey,
+        expectedValue));
+  }
+}
+
+void GOTestMidiMatch::run() {
+  CheckReceiverType(MIDI_RECV_MANUAL);
+  CheckReceiverType(MIDI_RECV_ENCLOSURE);
+  CheckReceiverType(MIDI_RECV_DRAWSTOP);
+  CheckReceiverType(MIDI_RECV_BUTTON);
+  CheckReceiverType(MIDI_RECV_SETTER);
+}
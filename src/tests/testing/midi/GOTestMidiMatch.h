@@ -0,0 +1,37 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTMIDIMATCH_H
+#define GOTESTMIDIMATCH_H
+
+#include "GOTest.h"
+
+#include <string>
+
+#include "midi/events/GOMidiReceiverType.h"
+
+/**
+ * Checks that the compiled patterns of GOMidiReceiver match the same events
+ * with the same results as the linear check of every pattern
+ */
+class GOTestMidiMatch : public GOTest {
+private:
+  static const std::string TEST_NAME;
+
+  /**
+   * Fills a receiver with patterns of all message types and compares its
+   * results with the reference matcher on random events
+   * @param type the receiver type
+   */
+  void CheckReceiverType(GOMidiReceiverType type);
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTMIDIMATCH_H */
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestMidiRouting.h"
+
+#include <format>
+
+#include "midi/elements/GOMidiReceiver.h"
+#include "midi/events/GOMidiEvent.h"
+#include "model/GOEventHandlerList.h"
+
+#include "GOEventHandler.h"
+#include "ptrvector.h"
+
+const std::string GOTestMidiRouting::TEST_NAME = "GOTestMidiRouting";
+
+/**
+ * A midi event handler with a receiver. It remembers whether the receiver has
+ * matched the last event passed to it
+ */
+class GOTestMidiRoutingProbe : public GOEventHandler {
+private:
+  GOEventHandlerList &r_handlers;
+  GOMidiReceiver m_receiver;
+  std::string m_name;
+  bool m_IsRegistered;
+  bool m_IsReached;
+
+public:
+  GOTestMidiRoutingProbe(
+    GOEventHandlerList &handlers,
+    GOMidiReceiverType type,
+    const std::string &name)
+    : r_handlers(handlers),
+      m_receiver(type),
+      m_name(name),
+      m_IsRegistered(false),
+      m_IsReached(false) {}
+
+  ~GOTestMidiRoutingProbe() { SetRegistered(false); }
+
+  void SetRegistered(bool isRegistered) {
+    if (isRegistered && !m_IsRegistered)
+      r_handlers.RegisterEventHandler(this);
+    else if (!isRegistered && m_IsRegistered)
+      r_handlers.UnRegisterEventHandler(this);
+    m_IsRegistered = isRegistered;
+  }
+
+  bool IsRegistered() const { return m_IsRegistered; }
+
+  /**
+   * Replaces the patterns of the receiver the same way as the midi event
+   * dialog does
+   */
+  void SetPattern(
+    GOMidiReceiverMessageType type, unsigned deviceId, int channel, int key) {
+    GOMidiReceiverEventPatternList patterns(m_receiver.GetType());
+    auto &pattern = patterns.GetEvent(patterns.AddNewEvent());
+
+    pattern.type = type;
+    pattern.deviceId = deviceId;
+    pattern.channel = channel;
+    pattern.key = key;
+    pattern.low_key = 0;
+    pattern.high_key = 127;
+    pattern.low_value = key;
+    pattern.high_value = 64 + key;
+    m_receiver.RenewFrom(patterns);
+  }
+
+  const std::string &GetName() const { return m_name; }
+
+  bool IsReached() const { return m_IsReached; }
+  void ResetReached() { m_IsReached = false; }
+
+  void ProcessMidi(const GOMidiEvent &event) override {
+    if (m_receiver.Match(event) != MIDI_MATCH_NONE)
+      m_IsReached = true;
+  }
+
+  void HandleKey(int key) override {}
+
+  bool GetMidiRoutes(std::vector<uint32_t> &routes) const override {
+    return m_receiver.GetMidiRoutes(routes);
+  }
+};
+
+static const GOMidiReceiverType RECEIVER_TYPES[] = {
+  MIDI_RECV_DRAWSTOP, MIDI_RECV_BUTTON, MIDI_RECV_ENCLOSURE, MIDI_RECV_MANUAL};
+
+static const GOMidiEvent::MidiType EVENT_TYPES[] = {
+  GOMidiEvent::MIDI_NOTE,
+  GOMidiEvent::MIDI_AFTERTOUCH,
+  GOMidiEvent::MIDI_CTRL_CHANGE,
+  GOMidiEvent::MIDI_PGM_CHANGE,
+  GOMidiEvent::MIDI_RPN,
+  GOMidiEvent::MIDI_NRPN,
+  GOMidiEvent::MIDI_SYSEX_JOHANNUS_9,
+  GOMidiEvent::MIDI_SYSEX_JOHANNUS_11,
+  GOMidiEvent::MIDI_SYSEX_VISCOUNT,
+  GOMidiEvent::MIDI_SYSEX_AHLBORN_GALANTI,
+  GOMidiEvent::MIDI_SYSEX_RODGERS_STOP_CHANGE};
+
+// the keys include the controllers that turn all notes of a manual off
+static const int EVENT_KEYS[]
+  = {0, 1, 2, 7, MIDI_CTRL_SOUNDS_OFF, MIDI_CTRL_NOTES_OFF};
+
+static const int EVENT_VALUES[] = {0, 1, 2, 64, 66, 127};
+
+// the number of pattern variants of each type. They differ by the device, the
+// channel and the key
+static constexpr unsigned N_VARIANTS = 3;
+
+void GOTestMidiRouting::CheckDispatch(
+  const std::string &stage,
+  const ptr_vector<GOTestMidiRoutingProbe> &probes,
+  const std::vector<GOMidiEvent> &events) {
+  unsigned nReached = 0;
+
+  for (const GOMidiEvent &e : events) {
+    for (GOTestMidiRoutingProbe *pProbe : probes)
+      pProbe->ResetReached();
+    controller->ProcessMidi(e);
+
+    std::vector<bool> routed;
+
+    for (GOTestMidiRoutingProbe *pProbe : probes) {
+      routed.push_back(pProbe->IsReached());
+      pProbe->ResetReached();
+      if (pProbe->IsRegistered())
+        pProbe->ProcessMidi(e);
+    }
+    for (unsigned i = 0; i < probes.size(); i++) {
+      const bool isReached = probes[i]->IsReached();
+
+      GOAssert(
+        routed[i] == isReached,
+        std::format(
+          "{}: the probe {} is {}reached by the event type {} device {} "
+          "channel {} key {} value {}",
+          stage,
+          probes[i]->GetName(),
+          routed[i] ? "" : "not ",
+          (int)e.GetMidiType(),
+          e.GetDevice(),
+          e.GetChannel(),
+          e.GetKey(),
+          e.GetValue()));
+      if (isReached)
+        nReached++;
+    }
+  }
+  GOAssert(
+    nReached > 0, std::format("{}: no probe has been reached at all", stage));
+}
+
+void GOTestMidiRouting::run() {
+  ptr_vector<GOTestMidiRoutingProbe> probes;
+
+  // a probe for each receiver type, pattern type and variant
+  for (GOMidiReceiverType receiverType : RECEIVER_TYPES)
+    for (unsigned type = MIDI_M_NONE + 1; type <= MIDI_M_NOTE_NORMAL; type++)
+      for (unsigned v = 0; v < N_VARIANTS; v++) {
+        GOTestMidiRoutingProbe *pProbe = new GOTestMidiRoutingProbe(
+          *controller,
+          receiverType,
+          std::format("{}/{}/{}", (int)receiverType, type, v));
+
+        // variant 0 matches any device and any channel
+        pProbe->SetPattern(
+          (GOMidiReceiverMessageType)type, v, v ? v : -1, v);
+        pProbe->SetRegistered(true);
+        probes.push_back(pProbe);
+      }
+
+  // the events from two devices. Some probes accept only one of them
+  std::vector<GOMidiEvent> events;
+
+  for (GOMidiEvent::MidiType type : EVENT_TYPES)
+    for (unsigned device = 1; device <= 2; device++)
+      for (int channel = 1; channel <= 3; channel++)
+        for (int key : EVENT_KEYS)
+          for (int value : EVENT_VALUES) {
+            GOMidiEvent e;
+
+            e.SetMidiType(type);
+            e.SetDevice(device);
+            e.SetChannel(channel);
+            e.SetKey(key);
+            e.SetValue(value);
+            events.push_back(e);
+          }
+
+  CheckDispatch("initial patterns", probes, events);
+
+  // change the patterns at runtime: the routes must follow them
+  for (unsigned i = 0; i < probes.size(); i++) {
+    const unsigned v = (i + 1) % N_VARIANTS;
+
+    probes[i]->SetPattern(
+      (GOMidiReceiverMessageType)(i / N_VARIANTS % MIDI_M_NOTE_NORMAL + 1),
+      v,
+      v ? v : -1,
+      v);
+  }
+  CheckDispatch("changed patterns", probes, events);
+
+  // unregister and register some handlers at runtime
+  for (unsigned i = 0; i < probes.size(); i += 3)
+    probes[i]->SetRegistered(false);
+  for (unsigned i = 0; i < probes.size(); i += 6)
+    probes[i]->SetRegistered(true);
+  CheckDispatch("changed handlers", probes, events);
+}
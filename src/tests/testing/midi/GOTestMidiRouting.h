@@ -0,0 +1,46 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTMIDIROUTING_H
+#define GOTESTMIDIROUTING_H
+
+#include "GOTest.h"
+
+#include <string>
+#include <vector>
+
+#include "ptrvector.h"
+
+class GOMidiEvent;
+class GOTestMidiRoutingProbe;
+
+/**
+ * Checks that the routed dispatch of midi events reaches exactly the receivers
+ * that the broadcast to all receivers would reach
+ */
+class GOTestMidiRouting : public GOCommonControllerTest {
+private:
+  static const std::string TEST_NAME;
+
+  /**
+   * Dispatches the events through the organ controller and compares the
+   * reached probes with the probes that match when each of them is called
+   * @param stage the test stage for the messages
+   * @param probes all the probes registered in the controller
+   * @param events the events to dispatch
+   */
+  void CheckDispatch(
+    const std::string &stage,
+    const ptr_vector<GOTestMidiRoutingProbe> &probes,
+    const std::vector<GOMidiEvent> &events);
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTMIDIROUTING_H */
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestPerfMidiDispatch.h"
+
+#include <chrono>
+#include <format>
+#include <iostream>
+
+#include "midi/elements/GOMidiReceiver.h"
+#include "midi/events/GOMidiEvent.h"
+#include "model/GOSwitch.h"
+
+#include "ptrvector.h"
+
+const std::string GOTestPerfMidiDispatch::TEST_NAME = "GOTestPerfMidiDispatch";
+
+// Number of midi controlled switches in the organ model
+static constexpr unsigned NUM_SWITCHES = 2000;
+
+// Number of events to dispatch
+static constexpr unsigned NUM_EVENTS = 1000000;
+
+// Baseline performance in thousands of events per second. Without the routing
+// index every event is matched against every switch, that is about two orders
+// of magnitude slower
+#ifdef NDEBUG
+static constexpr double BASELINE_KEVENTS_PER_SECOND = 2000;
+#else
+static constexpr double BASELINE_KEVENTS_PER_SECOND = 500;
+#endif
+
+void GOTestPerfMidiDispatch::run() {
+  ptr_vector<GOSwitch> switches;
+
+  // each switch reacts on its own controller
+  for (unsigned i = 0; i < NUM_SWITCHES; i++) {
+    GOSwitch *pSwitch = new GOSwitch(*controller);
+    GOMidiReceiver &receiver = *pSwitch->GetMidiReceiver();
+    GOMidiReceiverEventPatternList patterns(receiver.GetType());
+    auto &pattern = patterns.GetEvent(patterns.AddNewEvent());
+
+    pattern.type = MIDI_M_CTRL_CHANGE_ON_OFF;
+    pattern.channel = i % 16 + 1;
+    pattern.key = i / 16;
+    pattern.low_value = 0;
+    pattern.high_value = 127;
+    // the same way as the midi event dialog does
+    receiver.RenewFrom(patterns);
+    switches.push_back(pSwitch);
+  }
+
+  // the keyboard traffic that no switch reacts on
+  GOMidiEvent e;
+
+  e.SetMidiType(GOMidiEvent::MIDI_NOTE);
+  e.SetDevice(1);
+  e.SetValue(0);
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (unsigned i = 0; i < NUM_EVENTS; i++) {
+    e.SetChannel(i % 16 + 1);
+    e.SetKey(36 + i % 61);
+    controller->ProcessMidi(e);
+  }
+
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> elapsed = end - start;
+  double kEventsPerSecond = NUM_EVENTS / elapsed.count() / 1e3;
+  bool passed = kEventsPerSecond >= BASELINE_KEVENTS_PER_SECOND;
+  std::string message = std::format(
+    "MIDI dispatch ({} switches): {:8.1f} Kevents/sec (baseline: {:8.1f})",
+    NUM_SWITCHES,
+    kEventsPerSecond,
+    BASELINE_KEVENTS_PER_SECOND);
+
+  std::cout << std::format("\n  [{}] {}\n", passed ? "PASS" : "FAIL", message);
+  GOAssert(passed, message);
+}
@@ -0,0 +1,25 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTPERFMIDIDISPATCH_H
+#define GOTESTPERFMIDIDISPATCH_H
+
+#include "GOTest.h"
+
+#include <string>
+
+class GOTestPerfMidiDispatch : public GOCommonControllerTest {
+private:
+  static const std::string TEST_NAME;
+
+public:
+  GOTestPerfMidiDispatch() : GOCommonControllerTest(GOTest::PERF) {}
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTPERFMIDIDISPATCH_H */
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestPerfMidiMatch.h"
+
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <vector>
+
+#include "midi/elements/GOMidiReceiver.h"
+#include "midi/events/GOMidiEvent.h"
+
+#include "GOTestMidiLinearMatcher.h"
+#include "ptrvector.h"
+
+const std::string GOTestPerfMidiMatch::TEST_NAME = "GOTestPerfMidiMatch";
+
+// The console: manuals with a keyboard each, drawstops, pistons and swell
+// pedals. Every receiver has several patterns of different types
+static constexpr unsigned NUM_MANUALS = 5;
+static constexpr unsigned NUM_DRAWSTOPS = 120;
+static constexpr unsigned NUM_BUTTONS = 60;
+static constexpr unsigned NUM_ENCLOSURES = 4;
+
+// Number of events to match with every receiver
+static constexpr unsigned NUM_EVENTS = 20000;
+
+static GOMidiReceiverEventPattern &add_pattern(
+  GOMidiReceiverEventPatternList &patterns,
+  GOMidiReceiverMessageType type,
+  int channel,
+  int key,
+  int lowValue,
+  int highValue) {
+  auto &pattern = patterns.GetEvent(patterns.AddNewEvent());
+
+  pattern.type = type;
+  pattern.channel = channel;
+  pattern.key = key;
+  pattern.low_value = lowValue;
+  pattern.high_value = highValue;
+  return pattern;
+}
+
+template <typename F> static double measure(unsigned nReceivers, F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+
+  f();
+
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> elapsed = end - start;
+
+  return double(NUM_EVENTS) * nReceivers / elapsed.count() / 1e6;
+}
+
+void GOTestPerfMidiMatch::run() {
+  ptr_vector<GOMidiReceiver> receivers;
+
+  // the patterns are set the same way as the midi event dialog does
+  for (unsigned i = 0; i < NUM_MANUALS; i++) {
+    GOMidiReceiver *pReceiver = new GOMidiReceiver(MIDI_RECV_MANUAL);
+    GOMidiReceiverEventPatternList patterns(pReceiver->GetType());
+    auto &pattern = add_pattern(patterns, MIDI_M_NOTE, i + 1, 0, 1, 127);
+
+    pattern.low_key = 36;
+    pattern.high_key = 96;
+    // a second keyboard coupled by the midi mapping
+    add_pattern(patterns, MIDI_M_NOTE_NORMAL, i + 6, 0, 1, 127).high_key = 127;
+    pReceiver->RenewFrom(patterns);
+    receivers.push_back(pReceiver);
+  }
+  for (unsigned i = 0; i < NUM_DRAWSTOPS; i++) {
+    GOMidiReceiver *pReceiver = new GOMidiReceiver(MIDI_RECV_DRAWSTOP);
+    GOMidiReceiverEventPatternList patterns(pReceiver->GetType());
+
+    add_pattern(patterns, MIDI_M_CTRL_CHANGE_ON_OFF, 12, i, 0, 127);
+    add_pattern(patterns, MIDI_M_NOTE_ON, 13, i, 0, 1);
+    add_pattern(patterns, MIDI_M_NRPN_ON_OFF, 14, i, 0, 127);
+    add_pattern(patterns, MIDI_M_SYSEX_VISCOUNT, -1, 0, i * 2, i * 2 + 1);
+    pReceiver->RenewFrom(patterns);
+    receivers.push_back(pReceiver);
+  }
+  for (unsigned i = 0; i < NUM_BUTTONS; i++) {
+    GOMidiReceiver *pReceiver = new GOMidiReceiver(MIDI_RECV_BUTTON);
+    GOMidiReceiverEventPatternList patterns(pReceiver->GetType());
+
+    add_pattern(patterns, MIDI_M_PGM_CHANGE, 15, i, 0, 127);
+    add_pattern(patterns, MIDI_M_NOTE_FIXED_ON, 13, 64 + i, 0, 127);
+    pReceiver->RenewFrom(patterns);
+    receivers.push_back(pReceiver);
+  }
+  for (unsigned i = 0; i < NUM_ENCLOSURES; i++) {
+    GOMidiReceiver *pReceiver = new GOMidiReceiver(MIDI_RECV_ENCLOSURE);
+    GOMidiReceiverEventPatternList patterns(pReceiver->GetType());
+
+    add_pattern(patterns, MIDI_M_CTRL_CHANGE, 16, 7 + i, 0, 127);
+    pReceiver->RenewFrom(patterns);
+    receivers.push_back(pReceiver);
+  }
+
+  // the reference matchers check the same patterns linearly
+  ptr_vector<GOTestMidiLinearMatcher> linearMatchers;
+
+  for (GOMidiReceiver *pReceiver : receivers)
+    linearMatchers.push_back(new GOTestMidiLinearMatcher(*pReceiver));
+
+  // the keyboard traffic with some controllers in between
+  std::vector<GOMidiEvent> events(NUM_EVENTS);
+
+  for (unsigned i = 0; i < NUM_EVENTS; i++) {
+    GOMidiEvent &e = events[i];
+
+    e.SetDevice(1);
+    if (i % 8) {
+      e.SetMidiType(GOMidiEvent::MIDI_NOTE);
+      e.SetChannel(i % 10 + 1);
+      e.SetKey(36 + i % 61);
+      e.SetValue(i % 2 ? 100 : 0);
+    } else {
+      e.SetMidiType(GOMidiEvent::MIDI_CTRL_CHANGE);
+      e.SetChannel(i % 16 + 1);
+      e.SetKey(i % 128);
+      e.SetValue(i % 128);
+    }
+  }
+
+  unsigned nLinearMatched = 0;
+  unsigned nMatched = 0;
+  const double linearMMatches = measure(receivers.size(), [&]() {
+    for (const GOMidiEvent &e : events)
+      for (GOTestMidiLinearMatcher *pMatcher : linearMatchers) {
+        int key;
+        int value;
+
+        if (pMatcher->Match(e, nullptr, 0, key, value) != MIDI_MATCH_NONE)
+          nLinearMatched++;
+      }
+  });
+  const double mMatches = measure(receivers.size(), [&]() {
+    for (const GOMidiEvent &e : events)
+      for (GOMidiReceiver *pReceiver : receivers) {
+        int key;
+        int value;
+
+        if (pReceiver->Match(e, nullptr, 0, key, value) != MIDI_MATCH_NONE)
+          nMatched++;
+      }
+  });
+
+  GOAssert(
+    nMatched == nLinearMatched && nMatched > 0,
+    std::format(
+      "The compiled patterns matched {} events instead of {}",
+      nMatched,
+      nLinearMatched));
+
+  // the linear check of every pattern is the baseline
+  bool passed = mMatches >= linearMMatches;
+  std::string message = std::format(
+    "MIDI matching ({} receivers, {} matched): {:8.1f} Mmatches/sec "
+    "(baseline linear matching: {:8.1f})",
+    receivers.size(),
+    nMatched,
+    mMatches,
+    linearMMatches);
+
+  std::cout << std::format("\n  [{}] {}\n", passed ? "PASS" : "FAIL", message);
+  GOAssert(passed, message);
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestPerfKeyMask.h"
+
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <vector>
+
+#include "model/GOKeyMask.h"
+
+const std::string GOTestPerfKeyMask::TEST_NAME = "GOTestPerfKeyMask";
+
+// The worst case coupled organ: every manual has the maximal number of logical
+// keys and is coupled to every other manual with several couplers
+static constexpr unsigned NUM_KEYS = 192;
+static constexpr unsigned NUM_COUPLERS = 32;
+
+// Number of key changes played on every coupler
+static constexpr unsigned NUM_CHANGES = 20000;
+
+// Baseline performance in millions of coupler key changes per second
+#ifdef NDEBUG
+static constexpr double BASELINE_MCHANGES_PER_SECOND = 20;
+#else
+static constexpr double BASELINE_MCHANGES_PER_SECOND = 2;
+#endif
+
+// the same lookups as GOCoupler made before the masks were introduced
+static int find_first_linear(const std::vector<unsigned> &velocities) {
+  for (unsigned i = 0; i < velocities.size(); i++)
+    if (velocities[i])
+      return i;
+  return -1;
+}
+
+static int find_last_linear(const std::vector<unsigned> &velocities) {
+  for (int i = velocities.size() - 1; i >= 0; i--)
+    if (velocities[i])
+      return i;
+  return -1;
+}
+
+template <typename F> static double measure(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+
+  f();
+
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> elapsed = end - start;
+
+  return double(NUM_CHANGES) * NUM_COUPLERS / elapsed.count() / 1e6;
+}
+
+void GOTestPerfKeyMask::run() {
+  // a chord is held, and a melody is played around it. After every key change
+  // each coupler looks for the lowest and the highest key (BAS/MEL) and
+  // enumerates the sounding keys (engaging the coupler)
+  std::vector<std::vector<unsigned>> velocities(
+    NUM_COUPLERS, std::vector<unsigned>(NUM_KEYS));
+  std::vector<GOKeyMask> masks(NUM_COUPLERS);
+  unsigned long linearSum = 0;
+  unsigned long maskSum = 0;
+
+  const double linearMChanges = measure([&]() {
+    for (unsigned i = 0; i < NUM_CHANGES; i++)
+      for (auto &coupler : velocities) {
+        const unsigned key = 60 + i * 7 % 64;
+
+        coupler[key] = coupler[key] ? 0 : 100;
+        linearSum += find_first_linear(coupler) + find_last_linear(coupler);
+        for (unsigned k = 0; k < NUM_KEYS; k++)
+          if (coupler[k])
+            linearSum += k;
+      }
+  });
+  const double maskMChanges = measure([&]() {
+    for (unsigned i = 0; i < NUM_CHANGES; i++)
+      for (GOKeyMask &mask : masks) {
+        const unsigned key = 60 + i * 7 % 64;
+
+        mask.Set(key, !mask.Test(key));
+        maskSum += mask.FindFirst() + mask.FindLast();
+        mask.ForEach([&maskSum](unsigned k) { maskSum += k; });
+      }
+  });
+
+  GOAssert(
+    maskSum == linearSum, "The mask lookups differ from the linear ones");
+
+  bool passed = maskMChanges >= BASELINE_MCHANGES_PER_SECOND;
+  std::string message = std::format(
+    "Coupler key state ({} keys, {} couplers): {:8.1f} Mchanges/sec "
+    "(linear scan: {:8.1f}, baseline: {:8.1f})",
+    NUM_KEYS,
+    NUM_COUPLERS,
+    maskMChanges,
+    linearMChanges,
+    BASELINE_MCHANGES_PER_SECOND);
+
+  std::cout << std::format("\n  [{}] {}\n", passed ? "PASS" : "FAIL", message);
+  GOAssert(passed, message);
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestPipeConfigNode.h"
+
+#include <cmath>
+#include <format>
+
+#include "model/pipe-config/GOPipeConfigNode.h"
+
+const std::string GOTestPipeConfigNode::TEST_NAME = "GOTestPipeConfigNode";
+
+static constexpr float TOLERANCE = 1e-5f;
+
+void GOTestPipeConfigNode::run() {
+  // organ -> windchest -> pipe, and another windchest for reparenting
+  GOPipeConfigNode organ(nullptr, *controller, nullptr, nullptr);
+  GOPipeConfigNode windchest(&organ, *controller, nullptr, nullptr);
+  GOPipeConfigNode otherWindchest(&organ, *controller, nullptr, nullptr);
+  GOPipeConfigNode pipe(&windchest, *controller, nullptr, nullptr);
+
+  auto checkPipe = [&](
+                     const std::string &stage,
+                     float amplitude,
+                     float manualTuning,
+                     unsigned delay) {
+    GOAssert(
+      std::abs(pipe.GetEffectiveAmplitude() - amplitude) < TOLERANCE,
+      std::format(
+        "{}: the amplitude is {} instead of {}",
+        stage,
+        pipe.GetEffectiveAmplitude(),
+        amplitude));
+    GOAssert(
+      std::abs(pipe.GetEffectiveManualTuning() - manualTuning) < TOLERANCE,
+      std::format(
+        "{}: the manual tuning is {} instead of {}",
+        stage,
+        pipe.GetEffectiveManualTuning(),
+        manualTuning));
+    GOAssert(
+      pipe.GetEffectiveDelay() == delay,
+      std::format(
+        "{}: the delay is {} instead of {}",
+        stage,
+        pipe.GetEffectiveDelay(),
+        delay));
+  };
+
+  organ.GetPipeConfig().SetAmplitude(100);
+  windchest.GetPipeConfig().SetAmplitude(50);
+  otherWindchest.GetPipeConfig().SetAmplitude(25);
+  pipe.GetPipeConfig().SetAmplitude(80);
+  windchest.GetPipeConfig().SetDelay(10);
+  pipe.GetPipeConfig().SetDelay(5);
+  checkPipe("Initial", 0.4f, 0, 15);
+  // the values are cached now
+  checkPipe("Cached", 0.4f, 0, 15);
+
+  pipe.GetPipeConfig().SetAmplitude(60);
+  pipe.GetPipeConfig().SetManualTuning(3);
+  checkPipe("The pipe is changed", 0.3f, 3, 15);
+
+  windchest.GetPipeConfig().SetAmplitude(100);
+  windchest.GetPipeConfig().SetDelay(20);
+  checkPipe("The parent is changed", 0.6f, 3, 25);
+
+  organ.GetPipeConfig().SetAmplitude(50);
+  organ.GetPipeConfig().SetManualTuning(-10);
+  checkPipe("The grandparent is changed", 0.3f, -7, 25);
+
+  // the parent cache is valid already when the grandparent is changed
+  windchest.GetEffectiveAmplitude();
+  organ.GetPipeConfig().SetAmplitude(200);
+  checkPipe("The grandparent is changed after the parent", 1.2f, -7, 25);
+
+  pipe.SetParent(&otherWindchest);
+  checkPipe("The parent is replaced", 0.3f, -7, 5);
+}
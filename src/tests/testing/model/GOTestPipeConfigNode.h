@@ -0,0 +1,28 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTPIPECONFIGNODE_H
+#define GOTESTPIPECONFIGNODE_H
+
+#include "GOTest.h"
+
+#include <string>
+
+/**
+ * Checks that the cached effective values of the pipe config nodes follow the
+ * changes of the node configs and of the configs of their ancestors
+ */
+class GOTestPipeConfigNode : public GOCommonControllerTest {
+private:
+  static const std::string TEST_NAME;
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTPIPECONFIGNODE_H */
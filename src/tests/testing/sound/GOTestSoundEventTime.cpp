@@ -0,0 +1,100 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestSoundEventTime.h"
+
+#include <algorithm>
+#include <format>
+
+#include "sound/GOSoundOrganEngine.h"
+
+const std::string GOTestSoundEventTime::TEST_NAME = "GOTestSoundEventTime";
+
+static constexpr unsigned SAMPLE_RATE = 48000;
+static constexpr unsigned SAMPLES_PER_BUFFER = 128;
+
+void GOTestSoundEventTime::TestLatency(unsigned latencyPeriods) {
+  GOSoundOrganEngine engine;
+
+  engine.SetSampleRate(SAMPLE_RATE);
+  engine.SetSamplesPerBuffer(SAMPLES_PER_BUFFER);
+  engine.SetEventLatencyPeriods(latencyPeriods);
+  engine.Reset();
+
+  const uint64_t latency = engine.GetEventLatency();
+
+  GOAssert(
+    latency == latencyPeriods * SAMPLES_PER_BUFFER,
+    std::format("Latency {}: wrong latency {}", latencyPeriods, latency));
+  GOAssert(
+    !engine.GetEventTimeNs(latency),
+    std::format(
+      "Latency {}: the clock is synchronized before the first period",
+      latencyPeriods));
+
+  // synchronizes the steady clock with the engine clock
+  engine.NextPeriod();
+
+  const uint64_t now = engine.GetTime();
+  // the steady clock time of the engine sample 0
+  const int64_t originNs = engine.GetEventTimeNs(latency);
+
+  GOAssert(
+    originNs != 0,
+    std::format(
+      "Latency {}: the clock is not synchronized after a period",
+      latencyPeriods));
+  GOAssert(
+    engine.GetEventTime() == now,
+    std::format(
+      "Latency {}: an event without timestamp is not at the current time",
+      latencyPeriods));
+
+  // the sample offsets of the events relative to the current time. The
+  // negative ones are late and the large ones are in the future
+  for (const int offset : {-300, -100, -1, 0, 1, 37, 127, 128, 129, 1000}) {
+    const uint64_t sample = now + offset;
+    // the middle of the sample for avoiding rounding to the previous one
+    const int64_t timeNs
+      = originNs + int64_t((sample + 0.5) * 1e9 / SAMPLE_RATE);
+    // without the latency the events are at the start of the period
+    const uint64_t expected = latencyPeriods
+      ? std::clamp(sample + latency, now, now + latency + SAMPLES_PER_BUFFER)
+      : now;
+    GOSoundOrganEngine::EventTimeScope timeScope(timeNs);
+    const uint64_t actual = engine.GetEventTime();
+
+    GOAssert(
+      actual == expected,
+      std::format(
+        "Latency {}: the event at offset {} is positioned at {} instead of {}",
+        latencyPeriods,
+        offset,
+        (int64_t)(actual - now),
+        (int64_t)(expected - now)));
+  }
+
+  // a sample time takes precedence over the steady clock time
+  {
+    GOSoundOrganEngine::EventTimeScope timeScope(originNs);
+    GOSoundOrganEngine::EventSampleTimeScope sampleTimeScope(now + 50);
+
+    GOAssert(
+      engine.GetEventTime() == now + 50,
+      std::format(
+        "Latency {}: the event sample time is not respected", latencyPeriods));
+  }
+  GOAssert(
+    engine.GetEventTime() == now,
+    std::format(
+      "Latency {}: the event time scope is not restored", latencyPeriods));
+}
+
+void GOTestSoundEventTime::run() {
+  for (unsigned latencyPeriods = 0; latencyPeriods <= 2; latencyPeriods++)
+    TestLatency(latencyPeriods);
+}
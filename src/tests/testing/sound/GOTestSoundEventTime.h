@@ -0,0 +1,30 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTSOUNDEVENTTIME_H
+#define GOTESTSOUNDEVENTTIME_H
+
+#include "GOTest.h"
+
+#include <string>
+
+/**
+ * Checks that a timestamped event lands at the expected sample of the engine
+ * clock for different event latencies
+ */
+class GOTestSoundEventTime : public GOTest {
+private:
+  static const std::string TEST_NAME;
+
+  void TestLatency(unsigned latencyPeriods);
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTSOUNDEVENTTIME_H */
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestSoundWindSag.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+
+#include "model/GOWindchest.h"
+#include "sound/GOSoundOrganEngine.h"
+#include "sound/tasks/GOSoundTremulantTask.h"
+#include "sound/tasks/GOSoundWindchestTask.h"
+
+#include "ptrvector.h"
+
+const std::string GOTestSoundWindSag::TEST_NAME = "GOTestSoundWindSag";
+
+static constexpr unsigned SAMPLE_RATE = 48000;
+static constexpr unsigned SAMPLES_PER_BUFFER = 128;
+
+// the pitch drop in cents when WIND_SAG_PIPES or more pipes are held
+static constexpr float WIND_SAG = 20;
+static constexpr unsigned WIND_SAG_PIPES = 8;
+
+static constexpr float TOLERANCE = 1e-4f;
+
+void GOTestSoundWindSag::run() {
+  const unsigned nWindchests
+    = controller->AddWindchest(new GOWindchest(*controller));
+  GOWindchest &windchest = *controller->GetWindchest(nWindchests - 1);
+  GOSoundOrganEngine engine;
+  ptr_vector<GOSoundTremulantTask> tremulantTasks;
+  GOSoundWindchestTask task(engine, &windchest, SAMPLES_PER_BUFFER);
+
+  engine.SetSampleRate(SAMPLE_RATE);
+  engine.SetSamplesPerBuffer(SAMPLES_PER_BUFFER);
+  windchest.SetWindSag(WIND_SAG, WIND_SAG_PIPES);
+  task.Init(tremulantTasks);
+
+  // press the keys one by one. The pitch drops until the full load
+  for (unsigned nPipes = 0; nPipes <= WIND_SAG_PIPES + 2; nPipes++) {
+    const float expectedCents
+      = -WIND_SAG * std::min(nPipes, WIND_SAG_PIPES) / WIND_SAG_PIPES;
+    const float expectedFactor = exp2f(expectedCents / 1200.0f);
+    const float cents = windchest.GetWindSagPitchOffset();
+
+    GOAssert(
+      std::abs(cents - expectedCents) < TOLERANCE,
+      std::format(
+        "{} held pipes: the pitch offset is {} cents instead of {}",
+        nPipes,
+        cents,
+        expectedCents));
+
+    // the factor is computed once per period
+    task.Reset();
+
+    const float factor = task.GetPitchFactor();
+
+    GOAssert(
+      std::abs(factor - expectedFactor) < TOLERANCE,
+      std::format(
+        "{} held pipes: the pitch factor is {} instead of {}",
+        nPipes,
+        factor,
+        expectedFactor));
+    windchest.OnPipeStarted();
+  }
+
+  // release all the keys. The pitch returns exactly to the original one
+  for (unsigned i = 0; i <= WIND_SAG_PIPES + 2; i++)
+    windchest.OnPipeStopped();
+  task.Reset();
+  GOAssert(
+    windchest.GetWindSagPitchOffset() == 0,
+    "The pitch offset is not 0 after releasing all the pipes");
+  GOAssert(
+    task.GetPitchFactor() == 1.0f,
+    "The pitch factor is not 1 after releasing all the pipes");
+
+  // no wind sag is configured
+  windchest.SetWindSag(0, WIND_SAG_PIPES);
+  windchest.OnPipeStarted();
+  task.Reset();
+  GOAssert(
+    task.GetPitchFactor() == 1.0f,
+    "The pitch factor is not 1 for a windchest without the wind sag");
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTSOUNDWINDSAG_H
+#define GOTESTSOUNDWINDSAG_H
+
+#include "GOTest.h"
+
+#include <string>
+
+/**
+ * Checks that the windchest counts the held pipes and that the windchest task
+ * lowers the pitch of its samplers according to the wind sag
+ */
+class GOTestSoundWindSag : public GOCommonControllerTest {
+private:
+  static const std::string TEST_NAME;
+
+public:
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTSOUNDWINDSAG_H */
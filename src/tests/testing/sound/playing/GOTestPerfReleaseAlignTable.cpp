@@ -0,0 +1,198 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include "GOTestPerfReleaseAlignTable.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <iostream>
+
+#include <wx/mstream.h>
+
+#include "loader/cache/GOCacheWriter.h"
+#include "sound/playing/GOSoundAudioSection.h"
+#include "sound/playing/GOSoundReleaseAlignTable.h"
+
+#include "GOMemoryPool.h"
+
+const std::string GOTestPerfReleaseAlignTable::TEST_NAME
+  = "GOTestPerfReleaseAlignTable";
+
+static constexpr unsigned SAMPLE_RATE = 48000;
+static constexpr unsigned NUM_CHANNELS = 2;
+// one second of release is more than the analysed portion
+static constexpr unsigned NUM_FRAMES = SAMPLE_RATE;
+static constexpr int MAX_AMPLITUDE = 2 * 32767;
+static constexpr int MAX_DERIVATIVE = 2 * 4096;
+
+// Number of tables computed for each measurement
+static constexpr unsigned NUM_TABLES = 2000;
+
+typedef int Table[PHASE_ALIGN_DERIVATIVES][PHASE_ALIGN_AMPLITUDES];
+typedef bool FoundTable[PHASE_ALIGN_DERIVATIVES][PHASE_ALIGN_AMPLITUDES];
+
+/**
+ * The first phase of GOSoundReleaseAlignTable::ComputeTable as it was before
+ * the analysis by chunks: every point of the analysed portion is processed
+ * one by one with the integer divisions. It is the reference both for the
+ * speed and for the found table entries
+ */
+static void compute_reference(
+  const GOSoundAudioSection &release, Table &entries, FoundTable &found) {
+  GOSoundCompressionCache cache;
+  const unsigned channels = release.GetChannels();
+  const unsigned searchLen = SAMPLE_RATE / PHASE_ALIGN_MIN_FREQUENCY;
+
+  cache.Init();
+  memset(entries, 0, sizeof(entries));
+  memset(found, 0, sizeof(found));
+
+  int f_p = 0;
+
+  for (unsigned j = 0; j < channels; j++)
+    f_p += release.GetSample(BLOCK_HISTORY - 1, j, &cache);
+  for (unsigned i = BLOCK_HISTORY; i < searchLen; i++) {
+    int f = 0;
+
+    for (unsigned j = 0; j < channels; j++)
+      f += release.GetSample(i, j, &cache);
+
+    const int v_mod = (f - f_p) + MAX_DERIVATIVE - 1;
+    const int f_mod = f + MAX_AMPLITUDE - 1;
+    const int derivIndex = std::clamp(
+      (PHASE_ALIGN_DERIVATIVES * v_mod) / (2 * MAX_DERIVATIVE),
+      0,
+      PHASE_ALIGN_DERIVATIVES - 1);
+    const int ampIndex = std::clamp(
+      (PHASE_ALIGN_AMPLITUDES * f_mod) / (2 * MAX_AMPLITUDE),
+      0,
+      PHASE_ALIGN_AMPLITUDES - 1);
+
+    if (!found[derivIndex][ampIndex]) {
+      entries[derivIndex][ampIndex] = i + 1;
+      found[derivIndex][ampIndex] = true;
+    }
+    f_p = f;
+  }
+}
+
+// extracts the table entries from the saved table
+static void get_entries(GOSoundReleaseAlignTable &table, Table &entries) {
+  wxMemoryOutputStream stream;
+  {
+    GOCacheWriter writer(stream, false);
+
+    table.Save(writer);
+    writer.Finish();
+  }
+
+  // the saved table starts with the max amplitude and the max derivative
+  std::vector<uint8_t> data(stream.GetLength());
+
+  stream.CopyTo(data.data(), data.size());
+  memcpy(entries, data.data() + 2 * sizeof(int), sizeof(entries));
+}
+
+template <typename F> static double measure(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (unsigned i = 0; i < NUM_TABLES; i++)
+    f();
+
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> elapsed = end - start;
+
+  return NUM_TABLES / elapsed.count() / 1e3;
+}
+
+void GOTestPerfReleaseAlignTable::TestRelease(
+  const std::string &releaseName,
+  const std::vector<int16_t> &pcm,
+  double minSpeedup) {
+  GOMemoryPool pool;
+  GOSoundAudioSection release(pool);
+
+  release.Setup(
+    nullptr,
+    nullptr,
+    pcm.data(),
+    GOWave::SF_SIGNEDSHORT_16,
+    NUM_CHANNELS,
+    SAMPLE_RATE,
+    NUM_FRAMES,
+    nullptr,
+    BOOL3_DEFAULT,
+    false,
+    0,
+    0);
+
+  // the computed table must keep the release points found by the reference
+  GOSoundReleaseAlignTable table;
+  Table refEntries;
+  FoundTable refFound;
+  Table entries;
+
+  compute_reference(release, refEntries, refFound);
+  table.ComputeTable(release, MAX_AMPLITUDE, MAX_DERIVATIVE, SAMPLE_RATE, 0);
+  get_entries(table, entries);
+  for (unsigned i = 0; i < PHASE_ALIGN_DERIVATIVES; i++)
+    for (unsigned j = 0; j < PHASE_ALIGN_AMPLITUDES; j++)
+      GOAssert(
+        !refFound[i][j] || entries[i][j] == refEntries[i][j],
+        std::format(
+          "{}: the table entry [{}][{}] is {} instead of {}",
+          releaseName,
+          i,
+          j,
+          entries[i][j],
+          refEntries[i][j]));
+
+  const double refKTablesPerSecond
+    = measure([&]() { compute_reference(release, refEntries, refFound); });
+  const double kTablesPerSecond = measure([&]() {
+    table.ComputeTable(release, MAX_AMPLITUDE, MAX_DERIVATIVE, SAMPLE_RATE, 0);
+  });
+  const double speedup = kTablesPerSecond / refKTablesPerSecond;
+  const bool passed = speedup >= minSpeedup;
+  const std::string message = std::format(
+    "Release align table ({}): {:8.1f} Ktables/sec, per point reference: "
+    "{:8.1f} Ktables/sec, speedup {:.2f} (minimum: {:.2f})",
+    releaseName,
+    kTablesPerSecond,
+    refKTablesPerSecond,
+    speedup,
+    minSpeedup);
+
+  std::cout << std::format("\n  [{}] {}\n", passed ? "PASS" : "FAIL", message);
+  GOAssert(passed, message);
+}
+
+void GOTestPerfReleaseAlignTable::run() {
+  std::vector<int16_t> pcm(NUM_FRAMES * NUM_CHANNELS);
+
+  // A loud release that passes through all the table cells early, so the
+  // analysis stops long before the end of the analysed portion
+  for (unsigned i = 0; i < NUM_FRAMES; i++) {
+    const double phase = 2 * M_PI * 440 * i / SAMPLE_RATE;
+
+    pcm[i * 2] = pcm[i * 2 + 1] = int16_t(32000 * sin(phase));
+  }
+  TestRelease("loud", pcm, 1.0);
+
+  // A quiet low release that never reaches most of the cells, so the whole
+  // analysed portion is processed. The table must not be computed slower
+  // than with the reference. A 10% margin is left for the measurement noise
+  for (unsigned i = 0; i < NUM_FRAMES; i++) {
+    const double phase = 2 * M_PI * 30 * i / SAMPLE_RATE;
+
+    pcm[i * 2] = pcm[i * 2 + 1] = int16_t(3000 * sin(phase));
+  }
+  TestRelease("quiet", pcm, 0.9);
+}
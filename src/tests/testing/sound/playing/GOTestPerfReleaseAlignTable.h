@@ -0,0 +1,31 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2024-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#ifndef GOTESTPERFRELEASEALIGNTABLE_H
+#define GOTESTPERFRELEASEALIGNTABLE_H
+
+#include "GOTest.h"
+
+#include <string>
+#include <vector>
+
+class GOTestPerfReleaseAlignTable : public GOTest {
+private:
+  static const std::string TEST_NAME;
+
+  void TestRelease(
+    const std::string &releaseName,
+    const std::vector<int16_t> &pcm,
+    double minSpeedup);
+
+public:
+  GOTestPerfReleaseAlignTable() : GOTest(GOTest::PERF) {}
+  std::string GetName() override { return TEST_NAME; }
+  void run() override;
+};
+
+#endif /* GOTESTPERFRELEASEALIGNTABLE_H */
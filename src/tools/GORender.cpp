@@ -0,0 +1,284 @@
+/*
+ * Copyright 2006 Milan Digital Audio LLC
+ * Copyright 2009-2026 GrandOrgue contributors (see AUTHORS)
+ * License GPL-2.0 or later
+ * (https://www.gnu.org/licenses/old-licenses/gpl-2.0.html).
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <wx/app.h>
+#include <wx/cmdline.h>
+#include <wx/image.h>
+#include <wx/intl.h>
+#include <wx/log.h>
+#include <wx/stopwatch.h>
+
+#include "config/GOAudioDeviceConfig.h"
+#include "config/GOConfig.h"
+#include "gui/dialogs/GOProgressDialog.h"
+#include "midi/GOMidiMap.h"
+#include "midi/GOMidiPlayerContent.h"
+#include "midi/events/GOMidiEvent.h"
+#include "midi/files/GOMidiFileReader.h"
+#include "sound/GOSoundOrganEngine.h"
+#include "sound/GOSoundRecorder.h"
+#include "sound/buffer/GOSoundBufferMutable.h"
+#include "sound/scheduler/GOSoundScheduler.h"
+#include "sound/scheduler/GOSoundThread.h"
+
+#include "GOOrgan.h"
+#include "GOOrganController.h"
+#include "ptrvector.h"
+
+/**
+ * Renders a midi file played on an organ to a wav file without any audio
+ * device. The engine is driven as fast as the cpus allow, and the events are
+ * positioned at their exact sample times
+ */
+class GORenderApp : public wxApp {
+private:
+  static const wxCmdLineEntryDesc m_cmdLineDesc[];
+
+  wxString m_OdfPath;
+  wxString m_MidiPath;
+  wxString m_OutputPath;
+  // how many seconds to render after the last midi event
+  long m_TailSeconds;
+
+  bool Render();
+
+public:
+  GORenderApp();
+  bool OnInit() override;
+  int OnRun() override;
+  void OnInitCmdLine(wxCmdLineParser &parser) override;
+  bool OnCmdLineParsed(wxCmdLineParser &parser) override;
+};
+
+DECLARE_APP(GORenderApp)
+IMPLEMENT_APP_CONSOLE(GORenderApp)
+
+const wxCmdLineEntryDesc GORenderApp::m_cmdLineDesc[] = {
+  {wxCMD_LINE_SWITCH,
+   wxTRANSLATE("h"),
+   wxTRANSLATE("help"),
+   wxTRANSLATE("displays help on the command line parameters"),
+   wxCMD_LINE_VAL_NONE,
+   wxCMD_LINE_OPTION_HELP},
+  {wxCMD_LINE_OPTION,
+   wxTRANSLATE("t"),
+   wxTRANSLATE("tail"),
+   wxTRANSLATE("seconds to render after the last midi event (default 5)"),
+   wxCMD_LINE_VAL_NUMBER,
+   wxCMD_LINE_PARAM_OPTIONAL},
+  {wxCMD_LINE_PARAM,
+   NULL,
+   NULL,
+   wxTRANSLATE("organ definition file"),
+   wxCMD_LINE_VAL_STRING,
+   0},
+  {wxCMD_LINE_PARAM,
+   NULL,
+   NULL,
+   wxTRANSLATE("midi file"),
+   wxCMD_LINE_VAL_STRING,
+   0},
+  {wxCMD_LINE_PARAM,
+   NULL,
+   NULL,
+   wxTRANSLATE("output wav file"),
+   wxCMD_LINE_VAL_STRING,
+   0},
+  {wxCMD_LINE_NONE}};
+
+GORenderApp::GORenderApp() : m_TailSeconds(5) {}
+
+bool GORenderApp::OnInit() {
+  wxLog *logger = new wxLogStream(&std::cout);
+  wxLog::SetActiveTarget(logger);
+  wxLog::SetLogLevel(wxLOG_Status);
+  wxImage::AddHandler(new wxJPEGHandler);
+  wxImage::AddHandler(new wxGIFHandler);
+  wxImage::AddHandler(new wxPNGHandler);
+  wxImage::AddHandler(new wxBMPHandler);
+  wxImage::AddHandler(new wxICOHandler);
+
+  return wxApp::OnInit();
+}
+
+void GORenderApp::OnInitCmdLine(wxCmdLineParser &parser) {
+  parser.SetDesc(m_cmdLineDesc);
+}
+
+bool GORenderApp::OnCmdLineParsed(wxCmdLineParser &parser) {
+  parser.Found(wxT("t"), &m_TailSeconds);
+  if (m_TailSeconds < 0) {
+    wxLogError(_("The tail must not be negative"));
+    return false;
+  }
+  m_OdfPath = parser.GetParam(0);
+  m_MidiPath = parser.GetParam(1);
+  m_OutputPath = parser.GetParam(2);
+  return true;
+}
+
+int GORenderApp::OnRun() { return Render() ? 0 : 1; }
+
+bool GORenderApp::Render() {
+  GOConfig config("", "");
+
+  config.Load();
+
+  GOOrganController *organController = new GOOrganController(config);
+  GOSoundOrganEngine *engine = new GOSoundOrganEngine();
+  GOSoundRecorder recorder;
+  ptr_vector<GOSoundThread> threads;
+  bool isPlaybackPrepared = false;
+  bool isOk = false;
+
+  try {
+    GOProgressDialog dlg(true);
+    const wxString errMsg = organController->Load(
+      &dlg, GOOrgan(m_OdfPath), wxEmptyString, false);
+
+    if (!errMsg.IsEmpty())
+      throw errMsg;
+
+    GOMidiMap &map = config.GetMidiMap();
+    GOMidiFileReader reader(map);
+    GOMidiPlayerContent content;
+
+    if (
+      !reader.Open(m_MidiPath)
+      || !content.Load(
+        reader,
+        map,
+        organController->GetODFManualCount() - 1,
+        organController->GetFirstManualIndex() == 0)
+      || !reader.Close())
+      throw wxString::Format(_("Failed to load %s"), m_MidiPath);
+
+    const unsigned sampleRate = config.SampleRate();
+    const unsigned samplesPerBuffer = config.SamplesPerBuffer();
+    const unsigned nAudioGroups = config.GetAudioGroups().size();
+    std::vector<GOAudioOutputConfiguration> engineConfig(1);
+
+    // a single stereo output with all audio groups at 0 dB
+    engineConfig[0].channels = 2;
+    engineConfig[0].scale_factors.resize(2);
+    for (unsigned j = 0; j < 2; j++) {
+      std::vector<float> &scaleFactors = engineConfig[0].scale_factors[j];
+
+      scaleFactors.resize(nAudioGroups * 2);
+      for (unsigned k = 0; k < nAudioGroups; k++) {
+        scaleFactors[k * 2] = j == 0 ? 0 : GOAudioDeviceConfig::MUTE_VOLUME;
+        scaleFactors[k * 2 + 1]
+          = j == 1 ? 0 : GOAudioDeviceConfig::MUTE_VOLUME;
+      }
+    }
+    engine->SetSamplesPerBuffer(samplesPerBuffer);
+    // there is no deadline, so never drop samplers
+    engine->SetPolyphonyLimiting(false);
+    engine->SetHardPolyphony(config.PolyphonyLimit());
+    engine->SetScaledReleases(config.ScaleRelease());
+    engine->SetRandomizeSpeaking(config.RandomizeSpeaking());
+    // the events are sent one period ahead (see below)
+    engine->SetEventLatencyPeriods(1);
+    engine->SetInterpolationType(config.m_InterpolationType());
+    engine->SetAudioGroupCount(nAudioGroups);
+    engine->SetSampleRate(sampleRate);
+    recorder.SetBytesPerSample(config.WaveFormatBytesPerSample());
+    recorder.SetSampleRate(sampleRate);
+    engine->SetAudioOutput(engineConfig);
+    engine->SetupReverb(config);
+    engine->SetAudioRecorder(&recorder, false);
+    engine->Setup(
+      *organController,
+      organController->GetMemoryPool(),
+      config.ReleaseConcurrency());
+    organController->PreparePlayback(engine, nullptr, &recorder);
+    isPlaybackPrepared = true;
+
+    recorder.Open(m_OutputPath);
+    if (!recorder.IsOpen())
+      throw wxString::Format(_("Unable to open %s"), m_OutputPath);
+
+    GOSoundScheduler &scheduler = engine->GetScheduler();
+
+    // the threads must not start a period before its events are processed
+    scheduler.PauseGivingWork();
+    for (unsigned i = 0; i < config.Concurrency(); i++)
+      threads.push_back(new GOSoundThread(&scheduler));
+    for (GOSoundThread *thread : threads)
+      thread->Run();
+
+    const unsigned deviceId
+      = map.EnsureLogicalName(_("GrandOrgue MIDI Player"));
+    const uint64_t startTime = engine->GetTime();
+    const uint64_t tail = uint64_t(m_TailSeconds) * sampleRate;
+    uint64_t endTime = startTime + tail;
+    std::vector<float> outputData(samplesPerBuffer * 2);
+    GOSoundBufferMutable outputBuffer(
+      outputData.data(), 2, samplesPerBuffer);
+    const wxMilliClock_t renderStart = wxGetLocalTimeMillis();
+
+    while (!content.IsAtEnd() || engine->GetTime() < endTime) {
+      // A stop is detected one period before it, so the release may start at
+      // the stop time. Therefore send the events one period ahead
+      const uint64_t horizon = engine->GetTime() + 2 * samplesPerBuffer;
+
+      // send the events at their exact sample times
+      for (; !content.IsAtEnd(); content.Next()) {
+        GOMidiEvent e = content.GetCurrentEvent();
+        const uint64_t eventTime
+          = startTime + uint64_t(e.GetTime().ToDouble() * sampleRate / 1000);
+
+        if (eventTime >= horizon)
+          break;
+
+        GOSoundOrganEngine::EventSampleTimeScope eventScope(eventTime);
+
+        e.SetDevice(deviceId);
+        e.SetAllowedToReload(false);
+        organController->ProcessMidi(e);
+        endTime = std::max(endTime, eventTime + tail);
+      }
+      // the period is computed only after all its events have been processed
+      scheduler.ResumeGivingWork();
+      for (GOSoundThread *thread : threads)
+        thread->Wakeup();
+      engine->GetAudioOutput(0, true, outputBuffer);
+      scheduler.PauseGivingWork();
+      for (GOSoundThread *thread : threads)
+        thread->WaitForIdle();
+      engine->NextPeriod();
+    }
+    recorder.Close();
+
+    const wxMilliClock_t renderTime = wxGetLocalTimeMillis() - renderStart;
+
+    wxLogMessage(
+      _("%s: %.1f seconds rendered in %.1f seconds"),
+      m_OutputPath,
+      double(engine->GetTime() - startTime) / sampleRate,
+      renderTime.ToDouble() / 1000);
+    isOk = true;
+  } catch (const wxString &msg) {
+    wxLogError(wxT("%s"), msg);
+  }
+
+  // the threads must not hold any work items while they are deleted
+  for (GOSoundThread *thread : threads)
+    thread->Delete();
+  threads.clear();
+  recorder.Close();
+  if (isPlaybackPrepared)
+    organController->Abort();
+  engine->ClearSetup();
+  delete engine;
+  delete organController;
+  return isOk;
+}